@@ -0,0 +1,229 @@
+// Analytics: answers aggregate questions over the games of self-play shards
+//
+// The games are loaded into a column per field, one row per piece placed, and every query scans only
+// the columns it uses, block by block on all threads. For example, how often the winners play 5l in
+// their first 4 moves:
+//   Analytics --input shards --where piece=5l --where turn<4 --where rank=0
+//
+// Columns: game, ply, turn, player, piece, orientation, square, score, rank (see MoveTable.h)
+//
+// Usage: Analytics --input <shard file or directory> [--input ...] [--where <column><comparison><value>]...
+//                  [--group-by <column>] [--aggregate count|sum|min|max|mean] [--column <column>] [--threads <count>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Blokus/MoveQuery.h"
+#include "Blokus/MoveTable.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/RecordValidation.h"
+#include "Blokus/Shard.h"
+#include "Blokus/ThreadPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<std::filesystem::path> inputs;
+    blokus::MoveQuery query;
+    std::size_t threads{ std::thread::hardware_concurrency() };
+};
+
+// ----------------------------------------------------------------------------
+
+// Games that don't replay as valid records are left out of the table and only counted
+struct LoadedTable {
+    blokus::MoveTable table;
+    std::uint64_t skipped_games{ 0 };
+};
+
+LoadedTable load_shard(std::filesystem::path const& path) {
+    LoadedTable loaded;
+    blokus::ShardReader reader(path);
+    std::vector<std::uint8_t> block;
+    std::uint32_t record_count = 0;
+    while (reader.read_block(block, record_count)) {
+        std::size_t offset = 0;
+        for (std::uint32_t i = 0; i < record_count; ++i) {
+            auto const record = blokus::read_record(block, offset);
+            if (!record) {
+                throw std::runtime_error("corrupted record in " + path.string());
+            }
+            if (blokus::validate_record(*record).status != blokus::RecordStatus::Valid) {
+                ++loaded.skipped_games;
+                continue;
+            }
+            loaded.table.add_game(*record);
+        }
+    }
+    return loaded;
+}
+
+// Shards load in parallel and join in the order given, so game numbers don't depend on timing
+LoadedTable load_table(std::vector<std::filesystem::path> const& shards, blokus::ThreadPool& pool) {
+    std::vector<std::future<LoadedTable>> loads;
+    for (auto const& shard : shards) {
+        loads.push_back(pool.submit([&shard] { return load_shard(shard); }));
+    }
+    LoadedTable loaded;
+    for (auto& load : loads) {
+        auto const shard = load.get();
+        loaded.table.append(shard.table);
+        loaded.skipped_games += shard.skipped_games;
+    }
+    return loaded;
+}
+
+std::string format_key(std::optional<blokus::MoveColumn> column, std::int64_t key) {
+    using namespace blokus;
+
+    if (column == MoveColumn::Piece && key >= 0 && key < static_cast<std::int64_t>(piece_count)) {
+        return std::string(get_piece_name(static_cast<PieceId>(key)));
+    }
+    if (column == MoveColumn::Player) {
+        constexpr std::string_view names[player_id_count]{ "red", "green", "blue", "yellow" };
+        if (key >= 0 && key < static_cast<std::int64_t>(player_id_count)) {
+            return std::string(names[key]);
+        }
+    }
+    return std::to_string(key);
+}
+
+void print_result(Options const& options, std::vector<blokus::QueryGroup> const& groups) {
+    auto const& query = options.query;
+    std::cout << std::setw(12) << (query.group_by ? get_column_name(*query.group_by) : "all")
+        << std::setw(14) << "rows";
+    if (query.aggregation != blokus::Aggregation::Count) {
+        std::cout << std::setw(14) << get_column_name(query.aggregated);
+    }
+    std::cout << '\n';
+
+    for (auto const& group : groups) {
+        std::cout << std::setw(12) << format_key(query.group_by, group.key) << std::setw(14) << group.count;
+        if (query.aggregation != blokus::Aggregation::Count) {
+            std::cout << std::setw(14) << std::setprecision(4) << group.value;
+        }
+        std::cout << '\n';
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void print_usage() {
+    std::cerr <<
+        "Usage: Analytics --input <shard file or directory> [--input ...] [--where <column><comparison><value>]...\n"
+        "                 [--group-by <column>] [--aggregate count|sum|min|max|mean] [--column <column>] [--threads <count>]\n"
+        "Columns: game, ply, turn, player, piece, orientation, square, score, rank\n";
+}
+
+std::optional<blokus::Aggregation> parse_aggregation(std::string_view text) {
+    using blokus::Aggregation;
+    if (text == "count") return Aggregation::Count;
+    if (text == "sum") return Aggregation::Sum;
+    if (text == "min") return Aggregation::Min;
+    if (text == "max") return Aggregation::Max;
+    if (text == "mean") return Aggregation::Mean;
+    return std::nullopt;
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--input") {
+            options.inputs.push_back(value);
+        }
+        else if (option == "--where") {
+            auto const condition = blokus::parse_condition(value);
+            if (!condition) {
+                return std::nullopt;
+            }
+            options.query.conditions.push_back(*condition);
+        }
+        else if (option == "--group-by") {
+            options.query.group_by = blokus::parse_column_name(value);
+            if (!options.query.group_by) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--aggregate") {
+            auto const aggregation = parse_aggregation(value);
+            if (!aggregation) {
+                return std::nullopt;
+            }
+            options.query.aggregation = *aggregation;
+        }
+        else if (option == "--column") {
+            auto const column = blokus::parse_column_name(value);
+            if (!column) {
+                return std::nullopt;
+            }
+            options.query.aggregated = *column;
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.threads)) {
+                return std::nullopt;
+            }
+            options.threads = std::max<std::size_t>(options.threads, 1);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    if (options.inputs.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto const& options = *parsed;
+
+    try {
+        blokus::ThreadPool pool(options.threads);
+
+        auto const load_start = Clock::now();
+        auto const [table, skipped_games] = load_table(blokus::list_shards(options.inputs), pool);
+        std::chrono::duration<double> const load_time = Clock::now() - load_start;
+
+        auto const query_start = Clock::now();
+        auto const groups = blokus::run_query(table, options.query, pool);
+        std::chrono::duration<double> const query_time = Clock::now() - query_start;
+
+        print_result(options, groups);
+        std::cout << std::fixed << std::setprecision(3)
+            << "loaded " << table.get_game_count() << " games, " << table.get_row_count() << " moves in " << load_time.count() << " s, "
+            << skipped_games << " invalid games skipped\n"
+            << "query in " << query_time.count() << " s, "
+            << std::setprecision(1) << static_cast<double>(table.get_row_count()) / query_time.count() / 1e6 << " M rows/s\n";
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
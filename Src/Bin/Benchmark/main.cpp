@@ -0,0 +1,799 @@
+// Benchmark: measures the throughput of library components on generated games
+//
+// Each benchmark plays its own random games from the seed, so runs with the same options compare.
+//
+// Usage: Benchmark <benchmark> [--games <count>] [--repeat <count>] [--seed <seed>] [--depth <plies>] [--threads <count>]
+//                  [--iterations <count>]
+//   snapshot  bytes per state and encoding/decoding speed of the snapshot codec
+//   movegen   time to get the first k moves of a position, eager list against lazy source
+//   ordering  alpha-beta nodes searched with each move ordering heuristic
+//   reachability  territory of every player at each ply, kept by apply/undo against flooding the board
+//   endgame   late positions solved region by region on the pool against as a whole
+//   tiling    rectangles tiled with the twelve pentominoes, solutions per second
+//   dag       mcts over the position graph against the tree, iterations per second and a match
+//   scaling   graph mcts nodes per second from 1 to --threads threads, free, pinned, and with a table part per NUMA node
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Blokus/AlphaBeta.h"
+#include "Blokus/AnchorPattern.h"
+#include "Blokus/CpuTopology.h"
+#include "Blokus/DagMcts.h"
+#include "Blokus/Elo.h"
+#include "Blokus/Endgame.h"
+#include "Blokus/Mcts.h"
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/Random.h"
+#include "Blokus/Snapshot.h"
+#include "Blokus/Tiling.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string benchmark;
+    // Zero takes the default of the benchmark
+    std::size_t games{ 0 };
+    std::size_t repeat{ 10 };
+    std::uint64_t seed{ 0 };
+    int depth{ 3 };
+    std::size_t threads{ std::thread::hardware_concurrency() };
+    std::uint32_t iterations{ 1000 };
+};
+
+struct Benchmark {
+    std::string_view name;
+    std::string_view description;
+    std::function<void(Options const&)> run;
+    std::size_t default_games;
+};
+
+// ----------------------------------------------------------------------------
+
+template<class F>
+double measure_seconds(F&& f) {
+    auto const start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Every state of random games, the first one being the empty board
+std::vector<std::vector<blokus::Game>> play_random_games(Options const& options) {
+    using namespace blokus;
+
+    Random random(options.seed);
+    MoveList moves;
+    std::vector<std::vector<Game>> games(options.games);
+    for (auto& states : games) {
+        auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+        states.push_back(game);
+        while (!game.is_over()) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+            states.push_back(game);
+        }
+    }
+    return games;
+}
+
+// ----------------------------------------------------------------------------
+
+void run_snapshot(Options const& options) {
+    using namespace blokus;
+
+    std::vector<std::vector<Snapshot>> batches;
+    std::size_t state_count = 0;
+    for (auto const& states : play_random_games(options)) {
+        auto& batch = batches.emplace_back();
+        for (auto const& game : states) {
+            batch.push_back(Snapshot::from_game(game));
+        }
+        state_count += batch.size();
+    }
+
+    // One batch per game, each state against the previous one
+    std::vector<std::vector<std::uint8_t>> encoded(batches.size());
+    auto const encode_seconds = measure_seconds([&] {
+        for (std::size_t i = 0; i < options.repeat; ++i) {
+            for (std::size_t game = 0; game < batches.size(); ++game) {
+                encoded[game].clear();
+                encode_snapshots(batches[game], encoded[game]);
+            }
+        }
+    });
+
+    std::size_t decoded_count = 0;
+    auto const decode_seconds = measure_seconds([&] {
+        for (std::size_t i = 0; i < options.repeat; ++i) {
+            for (auto const& bytes : encoded) {
+                decoded_count += decode_snapshots(bytes).value().size();
+            }
+        }
+    });
+
+    // One batch per state, each state against the empty board
+    std::size_t independent_size = 0;
+    std::vector<std::uint8_t> buffer;
+    for (auto const& batch : batches) {
+        for (auto const& snapshot : batch) {
+            buffer.clear();
+            encode_snapshots({ &snapshot, 1 }, buffer);
+            independent_size += buffer.size();
+        }
+    }
+
+    std::size_t encoded_size = 0;
+    for (auto const& bytes : encoded) {
+        encoded_size += bytes.size();
+    }
+    auto const processed = static_cast<double>(state_count * options.repeat);
+    auto const gigabytes = processed * sizeof(Snapshot) / 1e9;
+    std::cout << std::fixed << std::setprecision(2)
+        << "states " << state_count << ", " << sizeof(Snapshot) << " bytes in memory each\n"
+        << "chained: " << static_cast<double>(encoded_size) / static_cast<double>(state_count) << " bytes/state\n"
+        << "independent: " << static_cast<double>(independent_size) / static_cast<double>(state_count) << " bytes/state\n"
+        << "encode: " << processed / encode_seconds / 1e6 << " M states/s, " << gigabytes / encode_seconds << " GB/s\n"
+        << "decode: " << static_cast<double>(decoded_count) / decode_seconds / 1e6 << " M states/s, " << gigabytes / decode_seconds << " GB/s\n";
+}
+
+// ----------------------------------------------------------------------------
+
+void run_movegen(Options const& options) {
+    using namespace blokus;
+
+    std::vector<Game> positions;
+    std::vector<Game> finished_games;
+    for (auto& states : play_random_games(options)) {
+        finished_games.push_back(states.back());
+        for (auto& game : states) {
+            if (!game.is_over()) {
+                positions.push_back(std::move(game));
+            }
+        }
+    }
+
+    std::cout << "positions " << positions.size() << '\n'
+        << std::setw(8) << "k" << std::setw(14) << "eager ns" << std::setw(14) << "lazy ns" << std::setw(10) << "speedup\n";
+
+    // Zero stands for every move
+    for (std::size_t const k : { 1, 4, 16, 64, 256, 0 }) {
+        auto const limit = k == 0 ? MoveList::capacity : k;
+        std::size_t eager_moves = 0;
+        std::size_t lazy_moves = 0;
+        MoveList moves;
+
+        auto const eager_seconds = measure_seconds([&] {
+            for (std::size_t i = 0; i < options.repeat; ++i) {
+                for (auto const& game : positions) {
+                    generate_moves(game, moves);
+                    eager_moves += std::min(moves.size(), limit);
+                }
+            }
+        });
+        auto const lazy_seconds = measure_seconds([&] {
+            for (std::size_t i = 0; i < options.repeat; ++i) {
+                for (auto const& game : positions) {
+                    MoveSource source(game);
+                    for (std::size_t taken = 0; taken < limit && source.next(); ++taken) {
+                        ++lazy_moves;
+                    }
+                }
+            }
+        });
+        if (eager_moves != lazy_moves) {
+            throw std::runtime_error("eager and lazy generation disagree");
+        }
+
+        auto const calls = static_cast<double>(positions.size() * options.repeat);
+        std::cout << std::fixed << std::setprecision(1)
+            << std::setw(8) << (k == 0 ? std::string("all") : std::to_string(k))
+            << std::setw(14) << eager_seconds / calls * 1e9
+            << std::setw(14) << lazy_seconds / calls * 1e9
+            << std::setw(9) << eager_seconds / lazy_seconds << "x\n";
+    }
+
+    // Every position of the games generated in turn, with the pattern keys of the anchors computed
+    // each time or followed by a tracker as the moves are played
+    std::size_t computed_moves = 0;
+    std::size_t tracked_moves = 0;
+    MoveList moves;
+    auto const computed_seconds = measure_seconds([&] {
+        for (std::size_t i = 0; i < options.repeat; ++i) {
+            for (auto const& finished : finished_games) {
+                auto game = Game::CreateNew({ finished.get_players().begin(), finished.get_players().end() });
+                for (std::size_t ply = 0; ply < finished.get_ply(); ++ply) {
+                    generate_moves(game, moves);
+                    computed_moves += moves.size();
+                    game.apply(finished.get_move(ply));
+                }
+            }
+        }
+    });
+    PatternTracker patterns;
+    auto const tracked_seconds = measure_seconds([&] {
+        for (std::size_t i = 0; i < options.repeat; ++i) {
+            for (auto const& finished : finished_games) {
+                auto game = Game::CreateNew({ finished.get_players().begin(), finished.get_players().end() });
+                patterns.reset(game);
+                for (std::size_t ply = 0; ply < finished.get_ply(); ++ply) {
+                    generate_moves(game, patterns, moves);
+                    tracked_moves += moves.size();
+                    patterns.apply(game, finished.get_move(ply));
+                }
+            }
+        }
+    });
+    if (computed_moves != tracked_moves) {
+        throw std::runtime_error("computed and tracked pattern keys disagree");
+    }
+
+    auto const plies = static_cast<double>(positions.size() * options.repeat);
+    std::cout << std::fixed << std::setprecision(1)
+        << "replayed games, keys computed: " << computed_seconds / plies * 1e9 << " ns/position, tracked: "
+        << tracked_seconds / plies * 1e9 << " ns/position\n";
+}
+
+// ----------------------------------------------------------------------------
+
+void run_ordering(Options const& options) {
+    using namespace blokus;
+
+    // Far enough in the game for a few plies of search to finish, one position per game
+    constexpr std::size_t position_ply = 36;
+    Random random(options.seed);
+    MoveList moves;
+    std::vector<Game> positions;
+    while (positions.size() < options.games) {
+        auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+        while (!game.is_over() && game.get_ply() < position_ply) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+        }
+        if (!game.is_over()) {
+            positions.push_back(game);
+        }
+    }
+
+    struct Variant {
+        std::string_view name;
+        MoveOrderingConfig ordering;
+    };
+    std::vector<Variant> const variants{
+        { "none", { .static_score = false, .killers = false, .history = false } },
+        { "static", { .static_score = true, .killers = false, .history = false } },
+        { "static+killers", { .static_score = true, .killers = true, .history = false } },
+        { "all", { .static_score = true, .killers = true, .history = true } },
+    };
+
+    std::cout << "positions " << positions.size() << ", depth " << options.depth << '\n'
+        << std::setw(16) << "ordering" << std::setw(14) << "nodes" << std::setw(10) << "ratio" << std::setw(10) << "seconds\n";
+
+    std::uint64_t unordered_nodes = 0;
+    std::vector<int> reference_values;
+    for (auto const& variant : variants) {
+        std::uint64_t nodes = 0;
+        std::vector<int> values;
+        auto const seconds = measure_seconds([&] {
+            for (auto const& game : positions) {
+                AlphaBeta search({ .depth = options.depth, .ordering = variant.ordering });
+                auto const result = search.search(game);
+                nodes += result.nodes;
+                values.push_back(result.value);
+            }
+        });
+        // The ordering changes the work, never the result
+        if (reference_values.empty()) {
+            reference_values = values;
+            unordered_nodes = nodes;
+        }
+        else if (values != reference_values) {
+            throw std::runtime_error("move ordering changed the search values");
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+            << std::setw(16) << variant.name << std::setw(14) << nodes
+            << std::setw(10) << static_cast<double>(nodes) / static_cast<double>(unordered_nodes)
+            << std::setw(10) << seconds << '\n';
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void run_reachability(Options const& options) {
+    using namespace blokus;
+
+    // Each game replayed forward then backward, reading the territory of every player at each ply
+    std::vector<Game> finished_games;
+    std::size_t ply_count = 0;
+    for (auto& states : play_random_games(options)) {
+        ply_count += 2 * states.back().get_ply();
+        finished_games.push_back(std::move(states.back()));
+    }
+    auto const replay = [&](bool track, auto&& read_territories) {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < options.repeat; ++i) {
+            for (auto const& finished : finished_games) {
+                auto game = Game::CreateNew({ finished.get_players().begin(), finished.get_players().end() });
+                if (track) {
+                    game.track_reachable();
+                }
+                for (std::size_t ply = 0; ply < finished.get_ply(); ++ply) {
+                    game.apply(finished.get_move(ply));
+                    total += read_territories(game);
+                }
+                while (game.get_ply() > 0) {
+                    game.undo();
+                    total += read_territories(game);
+                }
+            }
+        }
+        return total;
+    };
+
+    std::uint64_t plain_total = 0;
+    auto const plain_seconds = measure_seconds([&] {
+        plain_total = replay(false, [](Game const& game) { return game.get_ply(); });
+    });
+    std::uint64_t incremental_total = 0;
+    auto const incremental_seconds = measure_seconds([&] {
+        incremental_total = replay(true, [](Game const& game) {
+            std::uint64_t result = 0;
+            for (auto const player : game.get_players()) {
+                result += game.get_reachable(player).count();
+            }
+            return result;
+        });
+    });
+    std::uint64_t recomputed_total = 0;
+    auto const recomputed_seconds = measure_seconds([&] {
+        recomputed_total = replay(false, [](Game const& game) {
+            std::uint64_t result = 0;
+            for (auto const player : game.get_players()) {
+                result += get_reachable(player, game.get_occupancy(player), game.get_occupancy()).count();
+            }
+            return result;
+        });
+    });
+    if (incremental_total != recomputed_total || plain_total == 0) {
+        throw std::runtime_error("incremental and recomputed territories disagree");
+    }
+
+    // Apply/undo alone taken out of both
+    auto const plies = static_cast<double>(ply_count * options.repeat);
+    auto const incremental_ns = (incremental_seconds - plain_seconds) / plies * 1e9;
+    auto const recomputed_ns = (recomputed_seconds - plain_seconds) / plies * 1e9;
+    std::cout << std::fixed << std::setprecision(1)
+        << "plies " << ply_count << ", average territory " << static_cast<double>(incremental_total) / plies << " squares\n"
+        << "apply/undo: " << plain_seconds / plies * 1e9 << " ns/ply\n"
+        << "incremental territories: " << incremental_ns << " ns/ply\n"
+        << "recomputed territories: " << recomputed_ns << " ns/ply\n"
+        << "speedup: " << recomputed_ns / incremental_ns << "x\n";
+}
+
+// ----------------------------------------------------------------------------
+
+void run_endgame(Options const& options) {
+    using namespace blokus;
+
+    // Late enough for the board to split, one position per game
+    constexpr std::size_t position_ply = 52;
+    Random random(options.seed);
+    MoveList moves;
+    std::vector<Game> positions;
+    while (positions.size() < options.games) {
+        auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+        while (!game.is_over() && game.get_ply() < position_ply) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+        }
+        if (!game.is_over()) {
+            positions.push_back(game);
+        }
+    }
+
+    struct Variant {
+        std::string_view name;
+        bool decompose;
+        std::size_t threads;
+    };
+    std::vector<Variant> const variants{
+        { "whole", false, 1 },
+        { "regions", true, 1 },
+        { "regions parallel", true, options.threads },
+    };
+
+    std::cout << "positions " << positions.size() << " at ply " << position_ply << ", " << options.threads << " threads\n"
+        << std::setw(18) << "solver" << std::setw(10) << "regions" << std::setw(10) << "exact" << std::setw(12) << "nodes" << std::setw(10) << "seconds\n";
+
+    std::vector<EndgameResult> reference;
+    for (auto const& variant : variants) {
+        ThreadPool pool(variant.threads);
+        EndgameConfig config;
+        config.decompose = variant.decompose;
+        std::vector<EndgameResult> results;
+        auto const seconds = measure_seconds([&] {
+            for (auto const& game : positions) {
+                results.push_back(solve_endgame(game, pool, config));
+            }
+        });
+
+        std::size_t region_count = 0;
+        std::size_t exact_count = 0;
+        std::uint64_t nodes = 0;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            region_count += results[i].regions.size();
+            nodes += results[i].nodes;
+            for (std::size_t player = 0; player < Game::max_player_count; ++player) {
+                exact_count += results[i].exact[player];
+                // Both exact means the same answer, however it was searched
+                if (!reference.empty() && reference[i].exact[player] && results[i].exact[player] &&
+                    reference[i].max_squares[player] != results[i].max_squares[player]) {
+                    throw std::runtime_error("endgame solvers disagree");
+                }
+            }
+        }
+        if (reference.empty()) {
+            reference = results;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(18) << variant.name << std::setw(10) << region_count << std::setw(10) << exact_count
+            << std::setw(12) << nodes << std::setw(10) << seconds << '\n';
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void run_tiling(Options const& options) {
+    using namespace blokus;
+
+    PieceSet pentominoes;
+    for (std::size_t piece = 0; piece < piece_count; ++piece) {
+        if (get_piece_size(static_cast<PieceId>(piece)) == 5) {
+            pentominoes.insert(static_cast<PieceId>(piece));
+        }
+    }
+
+    // Known counts, rotations and reflections of the whole rectangle included
+    struct Rectangle {
+        int width;
+        int height;
+        std::uint64_t solutions;
+    };
+    std::vector<Rectangle> const rectangles{ { 20, 3, 8 }, { 15, 4, 1472 }, { 12, 5, 4040 }, { 10, 6, 9356 } };
+
+    ThreadPool pool(options.threads);
+    std::cout << options.threads << " threads\n"
+        << std::setw(10) << "rectangle" << std::setw(12) << "solutions" << std::setw(14) << "nodes"
+        << std::setw(10) << "seconds" << std::setw(14) << "solutions/s\n";
+    for (auto const& rectangle : rectangles) {
+        TilingProblem problem;
+        for (int y = 0; y < rectangle.height; ++y) {
+            for (int x = 0; x < rectangle.width; ++x) {
+                problem.region.set(to_square({ x, y }));
+            }
+        }
+        problem.pieces = pentominoes;
+        problem.all_pieces = true;
+
+        auto const result = solve_tiling(problem, pool);
+        if (result.solutions != rectangle.solutions) {
+            throw std::runtime_error("wrong number of tilings");
+        }
+        auto const seconds = std::chrono::duration<double>(result.elapsed).count();
+        std::cout << std::fixed << std::setprecision(3)
+            << std::setw(10) << std::to_string(rectangle.width) + "x" + std::to_string(rectangle.height)
+            << std::setw(12) << result.solutions << std::setw(14) << result.nodes << std::setw(10) << seconds
+            << std::setw(13) << std::setprecision(0) << static_cast<double>(result.solutions) / seconds << '\n';
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void run_dag(Options const& options) {
+    using namespace blokus;
+
+    // Middle game positions: the moves of a player only start to commute once its pieces spread out,
+    // and the branching must have narrowed for the search to reach the plies where they transpose
+    Random random(options.seed);
+    MoveList moves;
+    std::vector<Game> positions;
+    while (positions.size() < options.games) {
+        auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+        auto const ply = 36 + random.uniform(20);
+        while (!game.is_over() && game.get_ply() < ply) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+        }
+        if (!game.is_over()) {
+            positions.push_back(game);
+        }
+    }
+
+    std::cout << "positions " << positions.size() << ", " << options.iterations << " iterations, " << options.threads << " threads\n"
+        << std::setw(12) << "search" << std::setw(14) << "iterations/s" << std::setw(12) << "nodes" << std::setw(16) << "transpositions"
+        << std::setw(12) << "arena KB\n";
+    // The tree allocates the children of a node all at once, so it has no comparable node count
+    auto const print_row = [](std::string_view name, double iterations, double seconds, std::optional<double> nodes, double transpositions, double arena_size) {
+        std::cout << std::fixed << std::setprecision(0)
+            << std::setw(12) << name << std::setw(14) << iterations / seconds
+            << std::setw(12) << (nodes ? std::to_string(static_cast<std::uint64_t>(*nodes)) : std::string("-"))
+            << std::setw(16) << transpositions << std::setw(11) << arena_size / 1024 << '\n';
+    };
+
+    {
+        Mcts tree({ .iterations = options.iterations, .exploration = 0.7f, .seed = options.seed, .reuse_tree = false, .arena = {} });
+        double iterations = 0;
+        double arena_size = 0;
+        auto const seconds = measure_seconds([&] {
+            for (auto const& game : positions) {
+                auto const result = tree.search(game);
+                iterations += result.iterations;
+                arena_size += static_cast<double>(result.arena.used_size);
+            }
+        });
+        auto const count = static_cast<double>(positions.size());
+        print_row("tree", iterations, seconds, std::nullopt, 0, arena_size / count);
+    }
+
+    for (auto const threads : { std::size_t{ 1 }, options.threads }) {
+        ThreadPool pool(threads);
+        DagMcts graph({ .iterations = options.iterations, .exploration = 0.7f, .seed = options.seed, .graph = {} });
+        double iterations = 0;
+        double nodes = 0;
+        double transpositions = 0;
+        double arena_size = 0;
+        auto const seconds = measure_seconds([&] {
+            for (auto const& game : positions) {
+                auto const result = graph.search(game, pool);
+                iterations += result.iterations;
+                nodes += static_cast<double>(result.graph.node_count);
+                transpositions += static_cast<double>(result.graph.transposition_count);
+                arena_size += static_cast<double>(result.arena.used_size);
+            }
+        });
+        auto const count = static_cast<double>(positions.size());
+        print_row("dag x" + std::to_string(threads), iterations, seconds, nodes / count, transpositions / count, arena_size / count);
+    }
+
+    // Playing strength: the graph plays red and blue against the tree, then the seats are swapped,
+    // both with the same iterations per move and the same random opening
+    ThreadPool pool(options.threads);
+    MatchScore score;
+    for (std::size_t pair = 0; pair < (options.games + 1) / 2; ++pair) {
+        for (auto const swapped : { false, true }) {
+            Random opening(options.seed + pair);
+            Mcts tree({ .iterations = options.iterations, .exploration = 0.7f, .seed = opening.next(), .reuse_tree = true, .arena = {} });
+            DagMcts graph({ .iterations = options.iterations, .exploration = 0.7f, .seed = opening.next(), .graph = {} });
+            auto const is_graph = [swapped](std::size_t player_index) { return (player_index % 2 == 0) != swapped; };
+
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            while (!game.is_over()) {
+                if (game.get_ply() < 4) {
+                    generate_moves(game, moves);
+                    game.apply(moves[opening.uniform(static_cast<std::uint32_t>(moves.size()))]);
+                }
+                else if (is_graph(game.get_current_player_index())) {
+                    game.apply(graph.search(game, pool).best_move);
+                }
+                else {
+                    game.apply(tree.search(game).best_move);
+                }
+            }
+
+            std::array<int, 2> scores{};
+            auto const players = game.get_players();
+            for (std::size_t i = 0; i < players.size(); ++i) {
+                scores[is_graph(i) ? 0 : 1] += game.get_score(players[i]);
+            }
+            if (scores[0] > scores[1]) {
+                ++score.wins;
+            }
+            else if (scores[0] < scores[1]) {
+                ++score.losses;
+            }
+            else {
+                ++score.draws;
+            }
+        }
+    }
+    auto const elo = estimate_elo(score);
+    std::cout << std::setprecision(0) << "dag against tree: +" << score.wins << " =" << score.draws << " -" << score.losses
+        << ", elo " << elo.elo << " [" << elo.lower << ", " << elo.upper << "]\n";
+}
+
+// ----------------------------------------------------------------------------
+
+void run_scaling(Options const& options) {
+    using namespace blokus;
+
+    // Middle game positions, as for the dag benchmark
+    Random random(options.seed);
+    MoveList moves;
+    std::vector<Game> positions;
+    while (positions.size() < options.games) {
+        auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+        auto const ply = 36 + random.uniform(20);
+        while (!game.is_over() && game.get_ply() < ply) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+        }
+        if (!game.is_over()) {
+            positions.push_back(game);
+        }
+    }
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < options.threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(options.threads);
+
+    struct Variant {
+        std::string_view name;
+        bool pin_threads;
+        bool partition_per_node;
+    };
+    std::array<Variant, 3> const variants{ {
+        { "free", false, false },
+        { "pinned", true, false },
+        { "pinned parts", true, true },
+    } };
+
+    auto const& topology = get_cpu_topology();
+    std::cout << "positions " << positions.size() << ", " << options.iterations << " iterations, "
+        << topology.nodes.size() << " numa nodes, " << topology.get_processor_count() << " processors\n"
+        << std::setw(14) << "pool" << std::setw(8) << "threads" << std::setw(14) << "nodes/s" << std::setw(14) << "iterations/s"
+        << std::setw(10) << "speedup\n";
+
+    for (auto const& variant : variants) {
+        std::optional<double> single_thread_rate;
+        for (auto const threads : thread_counts) {
+            ThreadPool pool({ .thread_count = threads, .pin_threads = variant.pin_threads });
+            SearchGraphConfig graph_config;
+            graph_config.partition_count = variant.partition_per_node ? pool.get_node_count() : 1;
+            DagMcts graph({ .iterations = options.iterations, .exploration = 0.7f, .seed = options.seed, .graph = graph_config });
+
+            double iterations = 0;
+            double nodes = 0;
+            auto const seconds = measure_seconds([&] {
+                for (std::size_t i = 0; i < options.repeat; ++i) {
+                    for (auto const& game : positions) {
+                        auto const result = graph.search(game, pool);
+                        iterations += result.iterations;
+                        nodes += static_cast<double>(result.graph.node_count);
+                    }
+                }
+            });
+            auto const rate = nodes / seconds;
+            single_thread_rate = single_thread_rate.value_or(rate);
+            std::cout << std::fixed << std::setprecision(0)
+                << std::setw(14) << variant.name << std::setw(8) << threads << std::setw(14) << rate << std::setw(14) << iterations / seconds
+                << std::setprecision(2) << std::setw(9) << rate / *single_thread_rate << '\n';
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<Benchmark> const benchmarks{
+    { "snapshot", "bytes per state and encoding/decoding speed of the snapshot codec", run_snapshot, 1000 },
+    { "movegen", "time to get the first k moves of a position, eager list against lazy source", run_movegen, 1000 },
+    { "ordering", "alpha-beta nodes searched with each move ordering heuristic", run_ordering, 16 },
+    { "reachability", "territory of every player at each ply, kept by apply/undo against flooding the board", run_reachability, 1000 },
+    { "endgame", "late positions solved region by region on the pool against as a whole", run_endgame, 30 },
+    { "tiling", "rectangles tiled with the twelve pentominoes, solutions per second", run_tiling, 0 },
+    { "dag", "mcts over the position graph against the tree, iterations per second and a match", run_dag, 10 },
+    { "scaling", "graph mcts nodes per second from 1 to --threads threads, free, pinned, and with a table part per NUMA node", run_scaling, 4 },
+};
+
+void print_usage() {
+    std::cerr << "Usage: Benchmark <benchmark> [--games <count>] [--repeat <count>] [--seed <seed>] [--depth <plies>] [--threads <count>]\n"
+        "                 [--iterations <count>]\n";
+    // Descriptions line up after the longest name
+    std::size_t name_width = 0;
+    for (auto const& benchmark : benchmarks) {
+        name_width = std::max(name_width, benchmark.name.size() + 2);
+    }
+    for (auto const& benchmark : benchmarks) {
+        std::cerr << "  " << std::left << std::setw(static_cast<int>(name_width)) << benchmark.name << benchmark.description << '\n';
+    }
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    if (argc < 2) {
+        return std::nullopt;
+    }
+    Options options;
+    options.benchmark = argv[1];
+    for (int i = 2; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--games") {
+            if (!blokus::parse_number(value, options.games)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--repeat") {
+            if (!blokus::parse_number(value, options.repeat)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--seed") {
+            if (!blokus::parse_number(value, options.seed)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--depth") {
+            if (!blokus::parse_number(value, options.depth)) {
+                return std::nullopt;
+            }
+            options.depth = std::max(options.depth, 1);
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.threads)) {
+                return std::nullopt;
+            }
+            options.threads = std::max<std::size_t>(options.threads, 1);
+        }
+        else if (option == "--iterations") {
+            if (!blokus::parse_number(value, options.iterations)) {
+                return std::nullopt;
+            }
+            options.iterations = std::max<std::uint32_t>(options.iterations, 1);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const options = parse_options(argc, argv);
+    if (!options) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        for (auto const& benchmark : benchmarks) {
+            if (benchmark.name == options->benchmark) {
+                auto run_options = *options;
+                if (run_options.games == 0) {
+                    run_options.games = benchmark.default_games;
+                }
+                benchmark.run(run_options);
+                return EXIT_SUCCESS;
+            }
+        }
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    print_usage();
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+// GameServer: serves Blokus games over the line protocol described in Blokus/Protocol.h
+//
+// Bot requests given a clock are budgeted by the time manager, the overruns are reported on exit.
+// With --pin on, each search thread is bound to its own processor, NUMA node by node, and the search
+// memory of each thread stays on that node.
+//
+// Usage: GameServer [--host <address>] [--port <port>] [--threads <count>] [--pin <on|off>] [--max-sessions <count>]
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "Blokus/GameServer.h"
+#include "Blokus/Protocol.h"
+
+namespace {
+
+blokus::GameServer* running_server = nullptr;
+
+extern "C" void on_interrupt(int) {
+    if (running_server != nullptr) {
+        running_server->stop();
+    }
+}
+
+void print_usage() {
+    std::cerr << "Usage: GameServer [--host <address>] [--port <port>] [--threads <count>] [--pin <on|off>] [--max-sessions <count>]\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    blokus::GameServerConfig config;
+    config.port = 7420;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+        std::string const value = argv[++i];
+        if (option == "--host") {
+            config.host = value;
+        }
+        else if (option == "--port") {
+            if (!blokus::parse_number(value, config.port)) {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, config.engine.pool.thread_count)) {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (option == "--pin") {
+            if (value != "on" && value != "off") {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+            config.engine.pool.pin_threads = value == "on";
+        }
+        else if (option == "--max-sessions") {
+            if (!blokus::parse_number(value, config.max_sessions)) {
+                print_usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        blokus::GameServer server(config);
+        running_server = &server;
+        std::signal(SIGINT, on_interrupt);
+        std::signal(SIGTERM, on_interrupt);
+
+        std::cout << "Listening on " << config.host << ':' << server.get_port() << std::endl;
+        server.run();
+        running_server = nullptr;
+
+        // Only the bot requests given a clock have a budget to overrun
+        auto const time = server.get_time_statistics();
+        if (time.move_count != 0) {
+            std::cout << "Clocked moves " << time.move_count << ", " << time.overrun_count << " over budget, p99 overrun "
+                << time.p99_overrun.count() << " us, max overrun " << time.max_overrun.count() << " us\n";
+        }
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,400 @@
+// LoadGenerator: measures the throughput and the latency of a GameServer over the loopback
+//
+// Every connection plays games one request at a time, random games by default or the games of a
+// replay file. With a target rate, requests are sent on a fixed schedule and their latency is
+// measured from their scheduled time, so a stalled server is not hidden by the waiting clients.
+//
+// Usage: LoadGenerator [--host <address>] [--port <port>] [--connections <count>] [--rate <requests/s>]
+//                      [--duration <seconds>] [--bot-iterations <count>] [--replay <file>] [--record <file>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Blokus/GameClient.h"
+#include "Blokus/LatencyHistogram.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/Random.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string host{ "127.0.0.1" };
+    std::uint16_t port{ 7420 };
+    std::size_t connections{ 16 };
+    // Requests per second over all the connections, zero sends as fast as the server answers
+    double rate{ 0.0 };
+    std::chrono::seconds duration{ 10 };
+    // Non zero asks the server bot for every move instead of picking a random one
+    std::uint32_t bot_iterations{ 0 };
+    std::string replay_file;
+    std::string record_file;
+};
+
+// One game per line: the players and then the moves, in the protocol format
+struct RecordedGame {
+    std::string players;
+    std::vector<blokus::Move> moves;
+};
+
+struct Statistics {
+    blokus::LatencyHistogram latency;
+    std::uint64_t requests{ 0 };
+    std::uint64_t errors{ 0 };
+    std::uint64_t moves{ 0 };
+    std::uint64_t games{ 0 };
+    bool disconnected{ false };
+};
+
+// ----------------------------------------------------------------------------
+
+class Pacer {
+public:
+    Pacer(Clock::duration interval, Clock::time_point start)
+        : interval(interval)
+        , next(start)
+    {}
+
+    // Waits for the next scheduled request and returns the time it should have been sent at
+    Clock::time_point wait() {
+        if (interval == Clock::duration::zero()) {
+            return Clock::now();
+        }
+        std::this_thread::sleep_until(next);
+        return std::exchange(next, next + interval);
+    }
+
+private:
+    Clock::duration interval;
+    Clock::time_point next;
+};
+
+class Connection {
+public:
+    Connection(Options const& options, Clock::duration interval, Clock::time_point end, Statistics& statistics)
+        : client(options.host, options.port)
+        , pacer(interval, Clock::now())
+        , end(end)
+        , statistics(statistics)
+    {}
+
+    bool is_done() const { return Clock::now() >= end; }
+
+    // Nothing once the run is over
+    std::optional<std::string> request(std::string const& line) {
+        if (is_done()) {
+            return std::nullopt;
+        }
+        auto const scheduled = pacer.wait();
+        auto reply = client.request(line);
+        statistics.latency.record(Clock::now() - scheduled);
+        ++statistics.requests;
+        if (reply.starts_with("error")) {
+            ++statistics.errors;
+        }
+        return reply;
+    }
+
+private:
+    blokus::GameClient client;
+    Pacer pacer;
+    Clock::time_point end;
+    Statistics& statistics;
+};
+
+// ----------------------------------------------------------------------------
+
+std::optional<std::uint32_t> create_game(Connection& connection, std::string const& players) {
+    auto const reply = connection.request("new " + players);
+    if (!reply) {
+        return std::nullopt;
+    }
+    std::string_view arguments = *reply;
+    if (blokus::next_token(arguments) != "game") {
+        return std::nullopt;
+    }
+    return blokus::parse_number<std::uint32_t>(blokus::next_token(arguments));
+}
+
+bool play(Connection& connection, Statistics& statistics, std::uint32_t game_id, blokus::Move move) {
+    auto line = "play " + std::to_string(game_id) + ' ';
+    blokus::append_move(line, move);
+    if (!connection.request(line)) {
+        return false;
+    }
+    ++statistics.moves;
+    return true;
+}
+
+// Plays until the game is over, returns the moves or nothing when the run ended first
+std::optional<std::vector<blokus::Move>> play_generated_game(
+    Connection& connection, Options const& options, Statistics& statistics, blokus::Random& random)
+{
+    auto const game_id = create_game(connection, "rgby");
+    if (!game_id) {
+        return std::nullopt;
+    }
+
+    std::vector<blokus::Move> history;
+    auto const id = std::to_string(*game_id);
+    while (true) {
+        auto move = blokus::Move::pass();
+        if (options.bot_iterations != 0) {
+            auto const reply = connection.request("bot " + id + ' ' + std::to_string(options.bot_iterations));
+            if (!reply) {
+                return std::nullopt;
+            }
+            std::string_view arguments = *reply;
+            if (blokus::next_token(arguments) != "move") {
+                break;
+            }
+            move = blokus::parse_move(blokus::next_token(arguments)).value_or(blokus::Move::pass());
+        }
+        else {
+            auto const reply = connection.request("moves " + id);
+            if (!reply) {
+                return std::nullopt;
+            }
+            std::string_view arguments = *reply;
+            blokus::next_token(arguments);
+            auto const count = blokus::parse_number<std::uint32_t>(blokus::next_token(arguments)).value_or(0);
+            if (count == 0) {
+                break;
+            }
+            auto const choice = random.uniform(count);
+            for (std::uint32_t i = 0; i < choice; ++i) {
+                blokus::next_token(arguments);
+            }
+            move = blokus::parse_move(blokus::next_token(arguments)).value_or(blokus::Move::pass());
+        }
+
+        if (!play(connection, statistics, *game_id, move)) {
+            return std::nullopt;
+        }
+        history.push_back(move);
+    }
+
+    connection.request("close " + id);
+    ++statistics.games;
+    return history;
+}
+
+bool replay_game(Connection& connection, Statistics& statistics, RecordedGame const& game) {
+    auto const game_id = create_game(connection, game.players);
+    if (!game_id) {
+        return false;
+    }
+    for (auto const move : game.moves) {
+        if (!play(connection, statistics, *game_id, move)) {
+            return false;
+        }
+    }
+    connection.request("close " + std::to_string(*game_id));
+    ++statistics.games;
+    return true;
+}
+
+std::vector<RecordedGame> load_games(std::string const& path) {
+    std::vector<RecordedGame> games;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string_view text = line;
+        RecordedGame game{ std::string(blokus::next_token(text)), {} };
+        if (game.players.empty()) {
+            continue;
+        }
+        for (auto token = blokus::next_token(text); !token.empty(); token = blokus::next_token(text)) {
+            game.moves.push_back(blokus::parse_move(token).value_or(blokus::Move::pass()));
+        }
+        games.push_back(std::move(game));
+    }
+    return games;
+}
+
+// ----------------------------------------------------------------------------
+
+void print_usage() {
+    std::cerr <<
+        "Usage: LoadGenerator [--host <address>] [--port <port>] [--connections <count>] [--rate <requests/s>]\n"
+        "                     [--duration <seconds>] [--bot-iterations <count>] [--replay <file>] [--record <file>]\n";
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--host") {
+            options.host = value;
+        }
+        else if (option == "--port") {
+            if (!blokus::parse_number(value, options.port)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--connections") {
+            if (!blokus::parse_number(value, options.connections)) {
+                return std::nullopt;
+            }
+            options.connections = std::max<std::size_t>(options.connections, 1);
+        }
+        else if (option == "--rate") {
+            if (!blokus::parse_number(value, options.rate)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--duration") {
+            std::uint32_t seconds = 0;
+            if (!blokus::parse_number(value, seconds)) {
+                return std::nullopt;
+            }
+            options.duration = std::chrono::seconds(seconds);
+        }
+        else if (option == "--bot-iterations") {
+            if (!blokus::parse_number(value, options.bot_iterations)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--replay") {
+            options.replay_file = value;
+        }
+        else if (option == "--record") {
+            options.record_file = value;
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    return options;
+}
+
+void print_report(Statistics const& total, std::chrono::duration<double> elapsed) {
+    auto const seconds = elapsed.count();
+    auto const to_microseconds = [](std::chrono::nanoseconds value) {
+        return std::chrono::duration<double, std::micro>(value).count();
+    };
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "Requests  " << total.requests << " in " << seconds << " s, "
+        << total.requests / seconds << " requests/s, "
+        << total.moves / seconds << " moves/s, "
+        << total.games << " games, "
+        << total.errors << " errors\n"
+        << "Latency (us)\n"
+        << "  min     " << to_microseconds(total.latency.get_min()) << '\n'
+        << "  mean    " << to_microseconds(total.latency.get_mean()) << '\n';
+    for (auto const percentile : { 50.0, 90.0, 99.0, 99.9, 99.99 }) {
+        std::ostringstream label;
+        label << 'p' << percentile;
+        std::cout << "  " << std::left << std::setw(8) << label.str() << std::right
+            << to_microseconds(total.latency.get_percentile(percentile)) << '\n';
+    }
+    std::cout << "  max     " << to_microseconds(total.latency.get_max()) << '\n';
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto const& options = *parsed;
+
+    std::vector<RecordedGame> replayed;
+    if (!options.replay_file.empty()) {
+        replayed = load_games(options.replay_file);
+        if (replayed.empty()) {
+            std::cerr << "No game to replay in " << options.replay_file << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ofstream record;
+    if (!options.record_file.empty()) {
+        record.open(options.record_file);
+    }
+    std::mutex record_mutex;
+
+    // Each connection gets its share of the rate
+    auto const interval = options.rate > 0.0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.connections / options.rate))
+        : Clock::duration::zero();
+
+    std::vector<Statistics> statistics(options.connections);
+    std::vector<std::thread> threads;
+    auto const start = Clock::now();
+    auto const end = start + options.duration;
+
+    for (std::size_t i = 0; i < options.connections; ++i) {
+        threads.emplace_back([&, i] {
+            auto& own = statistics[i];
+            try {
+                Connection connection(options, interval, end, own);
+                blokus::Random random(i + 1);
+                for (std::size_t game = i; !connection.is_done(); game += options.connections) {
+                    if (!replayed.empty()) {
+                        replay_game(connection, own, replayed[game % replayed.size()]);
+                        continue;
+                    }
+                    auto const history = play_generated_game(connection, options, own, random);
+                    if (history && record.is_open()) {
+                        std::string line = "rgby";
+                        for (auto const move : *history) {
+                            line += ' ';
+                            blokus::append_move(line, move);
+                        }
+                        std::scoped_lock lock(record_mutex);
+                        record << line << '\n';
+                    }
+                }
+            }
+            catch (std::exception const&) {
+                own.disconnected = true;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> const elapsed = Clock::now() - start;
+
+    Statistics total;
+    std::size_t disconnected = 0;
+    for (auto const& own : statistics) {
+        total.latency.merge(own.latency);
+        total.requests += own.requests;
+        total.errors += own.errors;
+        total.moves += own.moves;
+        total.games += own.games;
+        disconnected += own.disconnected ? 1 : 0;
+    }
+
+    print_report(total, elapsed);
+    if (disconnected != 0) {
+        std::cerr << disconnected << " connections failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
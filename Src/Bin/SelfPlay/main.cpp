@@ -0,0 +1,602 @@
+// SelfPlay: generates training games, bot against bot, into rotating shard files
+//
+// Game threads push the finished games into a lock free queue; a single writer thread batches them
+// into blocks, compresses them and appends them to the shards. After every block the writer saves a
+// checkpoint, and a restarted run resumes from it, dropping any partial block.
+// With --positions, the game threads also count the positions of their games in a position database,
+// merging them in batches; games lost to a crash before their block was written stay counted there.
+//
+// With --serve, the games come from worker processes instead of local threads: the coordinator hands
+// out batches of seeds over TCP, writes the games the workers send back, and hands out again the
+// batches of the workers that left or went silent. With --model, the workers search with the model
+// file, which is read again whenever it changes. A worker is SelfPlay --connect, it plays on --threads
+// threads and outlives restarts of the coordinator. On one machine:
+//   SelfPlay --output games --games 1000 --serve 7000
+//   SelfPlay --connect 127.0.0.1:7000 --threads 4      (once per worker process)
+// With --pin on, each game thread is bound to its own processor, NUMA node by node, and the search
+// memory of its games stays on that node.
+//
+// Usage: SelfPlay --output <directory> [--games <count>] [--threads <count>] [--iterations <count>]
+//                 [--random-plies <count>] [--block-games <count>] [--shard-size <MiB>] [--seed <seed>] [--pin <on|off>]
+//                 [--positions <directory>] [--position-plies <count>]
+//                 [--serve <port> [--bind <address>] [--batch-games <count>] [--lease <seconds>] [--model <model file>]]
+//        SelfPlay --connect <host>:<port> [--threads <count>] [--pin <on|off>] [--name <name>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Blokus/BoundedQueue.h"
+#include "Blokus/GameRecord.h"
+#include "Blokus/LinearModel.h"
+#include "Blokus/Mcts.h"
+#include "Blokus/PositionDatabase.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/Random.h"
+#include "Blokus/SelfPlayCoordinator.h"
+#include "Blokus/SelfPlayWorker.h"
+#include "Blokus/Shard.h"
+#include "Blokus/ThreadPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::filesystem::path output;
+    // Zero plays until interrupted
+    std::uint64_t games{ 0 };
+    std::size_t threads{ std::thread::hardware_concurrency() };
+    bool pin_threads{ false };
+    std::uint32_t iterations{ 1000 };
+    // Opening moves played at random so that the games differ
+    std::size_t random_plies{ 4 };
+    std::size_t block_games{ 64 };
+    std::uint64_t shard_size{ 256 };
+    std::uint64_t seed{ 0 };
+    std::filesystem::path positions;
+    // Positions deeper than this are not counted
+    std::size_t position_plies{ 40 };
+
+    // Coordinator
+    std::optional<std::uint16_t> serve_port;
+    std::string bind{ "0.0.0.0" };
+    std::uint32_t batch_games{ 16 };
+    std::chrono::seconds lease{ 600 };
+    std::filesystem::path model;
+
+    // Worker
+    std::string connect_host;
+    std::uint16_t connect_port{ 0 };
+    std::string name{ "worker" };
+};
+
+// Positions a game thread gathers before merging them
+constexpr std::size_t position_batch_size = 1 << 14;
+
+struct Checkpoint {
+    blokus::ShardPosition position;
+    std::uint64_t game_count{ 0 };
+    std::uint64_t ply_count{ 0 };
+};
+
+std::atomic<bool> interrupted{ false };
+blokus::SelfPlayCoordinator* running_coordinator = nullptr;
+
+extern "C" void on_interrupt(int) {
+    interrupted.store(true);
+    if (running_coordinator != nullptr) {
+        running_coordinator->stop();
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+std::filesystem::path get_checkpoint_path(Options const& options) {
+    return options.output / "selfplay.checkpoint";
+}
+
+std::optional<Checkpoint> load_checkpoint(Options const& options) {
+    std::ifstream file(get_checkpoint_path(options));
+    if (!file) {
+        return std::nullopt;
+    }
+
+    Checkpoint checkpoint;
+    std::string key;
+    std::uint64_t value = 0;
+    while (file >> key >> value) {
+        if (key == "shard_index") {
+            checkpoint.position.shard_index = static_cast<std::uint32_t>(value);
+        }
+        else if (key == "shard_size") {
+            checkpoint.position.shard_size = value;
+        }
+        else if (key == "game_count") {
+            checkpoint.game_count = value;
+        }
+        else if (key == "ply_count") {
+            checkpoint.ply_count = value;
+        }
+    }
+    return checkpoint;
+}
+
+// Written aside and renamed so that a crash leaves either the old or the new checkpoint
+void save_checkpoint(Options const& options, Checkpoint const& checkpoint) {
+    auto const path = get_checkpoint_path(options);
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file
+            << "shard_index " << checkpoint.position.shard_index << '\n'
+            << "shard_size " << checkpoint.position.shard_size << '\n'
+            << "game_count " << checkpoint.game_count << '\n'
+            << "ply_count " << checkpoint.ply_count << '\n';
+        if (!file.flush()) {
+            throw std::runtime_error("cannot write checkpoint " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+// ----------------------------------------------------------------------------
+
+class Writer {
+public:
+    Writer(Options const& options, Checkpoint const& checkpoint)
+        : options(options)
+        , checkpoint(checkpoint)
+        , shards({ .directory = options.output, .prefix = "selfplay", .max_shard_size = options.shard_size << 20 }, checkpoint.position)
+    {}
+
+    void add(blokus::GameRecord const& record) {
+        blokus::append_record(block, record);
+        ++block_games;
+        block_plies += record.moves.size();
+        if (block_games >= options.block_games) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (block_games == 0) {
+            return;
+        }
+        shards.write_block(block, static_cast<std::uint32_t>(block_games));
+        checkpoint.position = shards.get_position();
+        checkpoint.game_count += block_games;
+        checkpoint.ply_count += block_plies;
+        save_checkpoint(options, checkpoint);
+
+        block.clear();
+        block_games = 0;
+        block_plies = 0;
+    }
+
+    Checkpoint const& get_checkpoint() const { return checkpoint; }
+
+private:
+    Options const& options;
+    Checkpoint checkpoint;
+    blokus::ShardWriter shards;
+    std::vector<std::uint8_t> block;
+    std::size_t block_games{ 0 };
+    std::size_t block_plies{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+void print_usage() {
+    std::cerr <<
+        "Usage: SelfPlay --output <directory> [--games <count>] [--threads <count>] [--iterations <count>]\n"
+        "                [--random-plies <count>] [--block-games <count>] [--shard-size <MiB>] [--seed <seed>] [--pin <on|off>]\n"
+        "                [--positions <directory>] [--position-plies <count>]\n"
+        "                [--serve <port> [--bind <address>] [--batch-games <count>] [--lease <seconds>] [--model <model file>]]\n"
+        "       SelfPlay --connect <host>:<port> [--threads <count>] [--pin <on|off>] [--name <name>]\n";
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--output") {
+            options.output = value;
+        }
+        else if (option == "--games") {
+            if (!blokus::parse_number(value, options.games)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.threads)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--pin") {
+            if (value != "on" && value != "off") {
+                return std::nullopt;
+            }
+            options.pin_threads = value == "on";
+        }
+        else if (option == "--iterations") {
+            if (!blokus::parse_number(value, options.iterations)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--random-plies") {
+            if (!blokus::parse_number(value, options.random_plies)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--block-games") {
+            if (!blokus::parse_number(value, options.block_games)) {
+                return std::nullopt;
+            }
+            options.block_games = std::max<std::size_t>(options.block_games, 1);
+        }
+        else if (option == "--shard-size") {
+            if (!blokus::parse_number(value, options.shard_size)) {
+                return std::nullopt;
+            }
+            options.shard_size = std::max<std::uint64_t>(options.shard_size, 1);
+        }
+        else if (option == "--seed") {
+            if (!blokus::parse_number(value, options.seed)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--positions") {
+            options.positions = value;
+        }
+        else if (option == "--position-plies") {
+            if (!blokus::parse_number(value, options.position_plies)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--serve") {
+            options.serve_port = blokus::parse_number<std::uint16_t>(value);
+            if (!options.serve_port) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--bind") {
+            options.bind = value;
+        }
+        else if (option == "--batch-games") {
+            if (!blokus::parse_number(value, options.batch_games)) {
+                return std::nullopt;
+            }
+            options.batch_games = std::max<std::uint32_t>(options.batch_games, 1);
+        }
+        else if (option == "--lease") {
+            std::uint32_t seconds = 0;
+            if (!blokus::parse_number(value, seconds)) {
+                return std::nullopt;
+            }
+            options.lease = std::chrono::seconds(seconds);
+        }
+        else if (option == "--model") {
+            options.model = value;
+        }
+        else if (option == "--connect") {
+            auto const colon = value.rfind(':');
+            if (colon == std::string::npos) {
+                return std::nullopt;
+            }
+            options.connect_host = value.substr(0, colon);
+            if (!blokus::parse_number(std::string_view(value).substr(colon + 1), options.connect_port)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--name") {
+            options.name = value;
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    // Workers write nothing, the coordinator does
+    if (options.output.empty() == options.connect_host.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+void print_progress(Checkpoint const& checkpoint, std::uint64_t session_games, std::chrono::duration<double> elapsed) {
+    auto const hours = elapsed.count() / 3600.0;
+    std::cout << std::fixed << std::setprecision(1)
+        << "games " << checkpoint.game_count
+        << ", plies " << checkpoint.ply_count
+        << ", shard " << checkpoint.position.shard_index
+        << ", " << (hours > 0.0 ? session_games / hours : 0.0) << " games/hour" << std::endl;
+}
+
+// ----------------------------------------------------------------------------
+
+// The bytes of a model file, once they load as a model
+std::string read_model(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open model " + path.string());
+    }
+    std::string bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    try {
+        std::istringstream stream(bytes);
+        blokus::LinearModel::load(stream);
+    }
+    catch (std::runtime_error const& error) {
+        throw std::runtime_error(std::string(error.what()) + ": " + path.string());
+    }
+    return bytes;
+}
+
+// Hands the model to the coordinator again whenever the file changes. A file caught while it is being
+// written doesn't load, a later check takes it once complete.
+void watch_model(std::stop_token stop, std::filesystem::path const& path, std::filesystem::file_time_type loaded,
+    blokus::SelfPlayCoordinator& coordinator)
+{
+    auto next_check = Clock::now();
+    while (!stop.stop_requested()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (Clock::now() < next_check) {
+            continue;
+        }
+        next_check = Clock::now() + std::chrono::seconds(5);
+
+        std::error_code error;
+        auto const modified = std::filesystem::last_write_time(path, error);
+        if (error || modified == loaded) {
+            continue;
+        }
+        try {
+            coordinator.set_model(read_model(path));
+            loaded = modified;
+            std::cout << "model " << path.string() << " updated" << std::endl;
+        }
+        catch (std::runtime_error const&) {
+        }
+    }
+}
+
+// The coordinator runs its event loop on the main thread, which also writes the games gathered
+void serve(Options const& options, Checkpoint const& start_checkpoint, std::uint64_t games_to_play,
+    std::optional<blokus::PositionDatabase>& positions)
+{
+    Writer writer(options, start_checkpoint);
+    blokus::PositionBatch batch;
+    std::uint64_t session_games = 0;
+    auto const start = Clock::now();
+    auto next_report = start + std::chrono::seconds(10);
+
+    blokus::SelfPlayCoordinator coordinator({
+        .host = options.bind,
+        .port = *options.serve_port,
+        .games = games_to_play,
+        .batch_games = options.batch_games,
+        // Different seeds after a resume, like the local games
+        .seed = options.seed + start_checkpoint.game_count * 1000003,
+        .iterations = options.iterations,
+        .random_plies = static_cast<std::uint32_t>(options.random_plies),
+        .lease = options.lease,
+    }, [&](blokus::CompletedBatch&& completed) {
+        for (auto const& record : completed.records) {
+            writer.add(record);
+            if (positions) {
+                batch.add_game(record, options.position_plies);
+            }
+        }
+        session_games += completed.records.size();
+        if (positions && batch.get_position_count() >= position_batch_size) {
+            positions->merge(batch);
+            batch.clear();
+        }
+        if (Clock::now() >= next_report) {
+            print_progress(writer.get_checkpoint(), session_games, Clock::now() - start);
+            next_report += std::chrono::seconds(10);
+        }
+    });
+
+    // Stopped and joined before the coordinator goes away
+    std::jthread model_watcher;
+    if (!options.model.empty()) {
+        auto const loaded = std::filesystem::last_write_time(options.model);
+        coordinator.set_model(read_model(options.model));
+        model_watcher = std::jthread([&options, loaded, &coordinator](std::stop_token stop) {
+            watch_model(stop, options.model, loaded, coordinator);
+        });
+    }
+
+    std::cout << "Listening on " << options.bind << ':' << coordinator.get_port() << std::endl;
+    running_coordinator = &coordinator;
+    coordinator.run();
+    running_coordinator = nullptr;
+
+    writer.flush();
+    print_progress(writer.get_checkpoint(), session_games, Clock::now() - start);
+    auto const statistics = coordinator.get_statistics();
+    std::cout << "batches " << statistics.completed << ", handed out again " << statistics.reassigned
+        << ", rejected games " << statistics.rejected << std::endl;
+    if (positions) {
+        if (!batch.empty()) {
+            positions->merge(batch);
+        }
+        positions->flush();
+        std::cout << "positions " << positions->get_position_count() << std::endl;
+    }
+}
+
+int run_worker(Options const& options) {
+    blokus::ThreadPool pool({ .thread_count = options.threads, .pin_threads = options.pin_threads });
+    blokus::SelfPlayWorker worker({ .host = options.connect_host, .port = options.connect_port, .name = options.name }, pool);
+
+    // The signal handler only sets a flag, this thread turns it into a stop request
+    std::stop_source stop;
+    std::jthread interrupt_watcher([&stop](std::stop_token done) {
+        while (!done.stop_requested() && !interrupted.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        stop.request_stop();
+    });
+
+    auto const statistics = worker.run(stop.get_token());
+    std::cout << "batches " << statistics.batches << ", games " << statistics.games
+        << ", reconnections " << statistics.reconnects << std::endl;
+    return EXIT_SUCCESS;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto const& options = *parsed;
+
+    try {
+        if (!options.connect_host.empty()) {
+            std::signal(SIGINT, on_interrupt);
+            std::signal(SIGTERM, on_interrupt);
+            return run_worker(options);
+        }
+
+        std::filesystem::create_directories(options.output);
+        auto const resumed = load_checkpoint(options);
+        auto const start_checkpoint = resumed.value_or(Checkpoint{});
+        if (resumed) {
+            std::cout << "Resuming after " << resumed->game_count << " games" << std::endl;
+        }
+        if (options.games != 0 && start_checkpoint.game_count >= options.games) {
+            return EXIT_SUCCESS;
+        }
+
+        std::signal(SIGINT, on_interrupt);
+        std::signal(SIGTERM, on_interrupt);
+
+        auto const games_to_play = options.games == 0 ? 0 : options.games - start_checkpoint.game_count;
+
+        std::optional<blokus::PositionDatabase> positions;
+        if (!options.positions.empty()) {
+            positions.emplace(options.positions);
+        }
+
+        if (options.serve_port) {
+            serve(options, start_checkpoint, games_to_play, positions);
+            return EXIT_SUCCESS;
+        }
+
+        blokus::BoundedQueue<blokus::GameRecord> finished(std::max<std::size_t>(options.threads * 4, 64));
+        blokus::ThreadPool pool({ .thread_count = options.threads, .pin_threads = options.pin_threads });
+        // Game threads claim a game before playing it, so that exactly the requested count gets played
+        std::atomic<std::uint64_t> next_game{ 0 };
+        std::atomic<std::size_t> running_threads{ pool.get_thread_count() };
+        std::atomic<bool> writer_stopped{ false };
+
+        // Declared after the pool: on an exception the game threads give up before the pool joins them
+        struct WriterGuard {
+            std::atomic<bool>& stopped;
+            ~WriterGuard() { stopped.store(true); }
+        } const writer_guard{ writer_stopped };
+
+        std::vector<std::future<void>> players;
+        for (std::size_t i = 0; i < pool.get_thread_count(); ++i) {
+            // Different seeds after a resume, the resumed games would be replayed otherwise
+            auto const seed = options.seed + start_checkpoint.game_count * 1000003 + i;
+            players.push_back(pool.submit([&, seed] {
+                // Also on an exception, the writer waits for every game thread
+                struct RunningGuard {
+                    std::atomic<std::size_t>& running;
+                    ~RunningGuard() { --running; }
+                } const running_guard{ running_threads };
+
+                blokus::Mcts mcts({ .iterations = options.iterations, .seed = seed });
+                blokus::Random random(seed);
+                blokus::PositionBatch batch;
+                while (!interrupted.load() && !writer_stopped.load() && (games_to_play == 0 || next_game.fetch_add(1) < games_to_play)) {
+                    auto record = blokus::play_self_play_game(mcts, random, options.random_plies);
+                    if (positions) {
+                        batch.add_game(record, options.position_plies);
+                        if (batch.get_position_count() >= position_batch_size) {
+                            positions->merge(batch);
+                            batch.clear();
+                        }
+                    }
+                    // Back pressure: the queue only fills up when the writer can't keep up
+                    while (!finished.try_push(record) && !writer_stopped.load()) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                }
+                if (positions && !batch.empty()) {
+                    positions->merge(batch);
+                }
+            }));
+        }
+
+        // The main thread is the writer: compression and I/O stay off the game threads
+        Writer writer(options, start_checkpoint);
+        std::uint64_t session_games = 0;
+        auto const start = Clock::now();
+        auto next_report = start + std::chrono::seconds(10);
+        while (true) {
+            if (auto record = finished.try_pop()) {
+                writer.add(*record);
+                ++session_games;
+                continue;
+            }
+            if (running_threads.load() == 0) {
+                // Every producer is done and the queue was seen empty after that
+                if (auto record = finished.try_pop()) {
+                    writer.add(*record);
+                    ++session_games;
+                    continue;
+                }
+                break;
+            }
+            if (Clock::now() >= next_report) {
+                print_progress(writer.get_checkpoint(), session_games, Clock::now() - start);
+                next_report += std::chrono::seconds(10);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        for (auto& player : players) {
+            player.get();
+        }
+
+        writer.flush();
+        print_progress(writer.get_checkpoint(), session_games, Clock::now() - start);
+        if (positions) {
+            positions->flush();
+            std::cout << "positions " << positions->get_position_count() << std::endl;
+        }
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
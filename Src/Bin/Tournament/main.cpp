@@ -0,0 +1,401 @@
+// Tournament: plays engine configurations against each other and estimates their Elo differences
+//
+// Two engines share a game by playing two colors each, red and blue against green and yellow.
+// Games come in pairs with the same random opening and the seats swapped, which cancels most of
+// the first player advantage. With --sprt, a pairing stops as soon as its test concludes.
+// An engine given a model file searches with its priors and values (see Train).
+// With --pin on, each game thread is bound to its own processor, NUMA node by node.
+//
+// Usage: Tournament --engine <name>:<iterations>[:<exploration>[:<model file>]] --engine ... [--mode round-robin|gauntlet]
+//                   [--games <count>] [--threads <count>] [--pin <on|off>] [--sprt <elo0>,<elo1>] [--random-plies <count>] [--seed <seed>]
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Blokus/Elo.h"
+#include "Blokus/LinearModel.h"
+#include "Blokus/Mcts.h"
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/Random.h"
+#include "Blokus/ThreadPool.h"
+
+namespace {
+
+struct EngineOptions {
+    std::string name;
+    std::uint32_t iterations{ 1000 };
+    float exploration{ 0.7f };
+    std::filesystem::path model_path;
+    // Loaded once the options are parsed, shared by every game of the engine
+    std::shared_ptr<blokus::LinearModel const> model;
+};
+
+struct Options {
+    std::vector<EngineOptions> engines;
+    bool gauntlet{ false };
+    // Per pairing, rounded up to an even count for the seat swap
+    std::uint32_t games{ 100 };
+    blokus::ThreadPoolConfig pool{};
+    std::optional<blokus::SprtConfig> sprt;
+    std::size_t random_plies{ 4 };
+    std::uint64_t seed{ 0 };
+};
+
+struct Pairing {
+    std::size_t first{ 0 };
+    std::size_t second{ 0 };
+    blokus::MatchScore score;
+    // Only the pairs whose both games are done, the SPRT runs on these
+    blokus::MatchScore paired_score;
+    // Score of the game done first, by pair, until the other one is done
+    std::unordered_map<std::uint32_t, double> half_pairs;
+    std::uint32_t started{ 0 };
+    bool stopped{ false };
+    std::optional<blokus::SprtResult> sprt;
+};
+
+struct EngineUsage {
+    std::uint64_t moves{ 0 };
+    std::chrono::nanoseconds search_time{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Hands out the games to the worker threads and collects their results
+class Schedule {
+public:
+    struct Job {
+        std::size_t pairing;
+        std::uint32_t game;
+    };
+
+    Schedule(Options const& options)
+        : options(options)
+        , usages(options.engines.size())
+    {
+        auto const count = options.engines.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                if (!options.gauntlet || i == 0) {
+                    Pairing pairing;
+                    pairing.first = i;
+                    pairing.second = j;
+                    pairings.push_back(pairing);
+                }
+            }
+        }
+    }
+
+    // Round robin over the pairings still running, so that they all progress at the same pace
+    std::optional<Job> next() {
+        std::scoped_lock lock(mutex);
+        for (std::size_t attempt = 0; attempt < pairings.size(); ++attempt) {
+            auto const index = next_pairing++ % pairings.size();
+            auto& pairing = pairings[index];
+            if (!pairing.stopped && pairing.started < get_game_count()) {
+                return Job{ index, pairing.started++ };
+            }
+        }
+        return std::nullopt;
+    }
+
+    // The score is from the point of view of the first engine of the pairing
+    void record(Job const& job, double score, std::array<EngineUsage, 2> const& usage) {
+        std::scoped_lock lock(mutex);
+        auto& pairing = pairings[job.pairing];
+        add_score(pairing.score, score);
+
+        for (std::size_t i = 0; i < 2; ++i) {
+            auto& total = usages[i == 0 ? pairing.first : pairing.second];
+            total.moves += usage[i].moves;
+            total.search_time += usage[i].search_time;
+        }
+
+        // Only tested on complete seat swapped pairs, a lone game is biased by its seats. The games
+        // finish out of order, so a pair is complete once both of its own games are.
+        auto const other = pairing.half_pairs.find(job.game / 2);
+        if (other == pairing.half_pairs.end()) {
+            pairing.half_pairs.emplace(job.game / 2, score);
+            return;
+        }
+        add_score(pairing.paired_score, other->second);
+        add_score(pairing.paired_score, score);
+        pairing.half_pairs.erase(other);
+
+        if (options.sprt) {
+            pairing.sprt = blokus::run_sprt(pairing.paired_score, *options.sprt);
+            if (pairing.sprt->status != blokus::SprtStatus::Continue) {
+                pairing.stopped = true;
+            }
+        }
+    }
+
+    std::uint32_t get_game_count() const { return (options.games + 1) / 2 * 2; }
+
+    std::vector<Pairing> get_pairings() const {
+        std::scoped_lock lock(mutex);
+        return pairings;
+    }
+
+    std::vector<EngineUsage> get_usages() const {
+        std::scoped_lock lock(mutex);
+        return usages;
+    }
+
+private:
+    static void add_score(blokus::MatchScore& total, double score) {
+        if (score > 0.5) {
+            ++total.wins;
+        }
+        else if (score < 0.5) {
+            ++total.losses;
+        }
+        else {
+            ++total.draws;
+        }
+    }
+
+    Options const& options;
+    mutable std::mutex mutex;
+    std::vector<Pairing> pairings;
+    std::vector<EngineUsage> usages;
+    std::size_t next_pairing{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Returns the score of the first engine: 1 for a win, 0.5 for a draw and 0 for a loss
+double play_game(Options const& options, Pairing const& pairing, std::uint32_t game_index, std::array<EngineUsage, 2>& usage) {
+    using namespace blokus;
+
+    // Both games of a seat swapped pair get the same opening
+    auto const pair_index = game_index / 2;
+    auto const swapped = game_index % 2 == 1;
+    Random random(options.seed + pairing.first * 7919 + pairing.second * 104729 + pair_index);
+
+    std::array<Mcts, 2> engines{
+        Mcts({ .iterations = options.engines[pairing.first].iterations, .exploration = options.engines[pairing.first].exploration, .seed = random.next(), .model = options.engines[pairing.first].model }),
+        Mcts({ .iterations = options.engines[pairing.second].iterations, .exploration = options.engines[pairing.second].exploration, .seed = random.next(), .model = options.engines[pairing.second].model }),
+    };
+
+    // Red and blue are the player indices 0 and 2, they belong to the first engine unless swapped
+    auto const get_engine = [swapped](std::size_t player_index) -> std::size_t {
+        return (player_index % 2 == 0) != swapped ? 0 : 1;
+    };
+
+    auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+    MoveList moves;
+    while (!game.is_over()) {
+        if (game.get_ply() < options.random_plies) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+            continue;
+        }
+        auto const engine = get_engine(game.get_current_player_index());
+        auto const result = engines[engine].search(game);
+        usage[engine].moves += 1;
+        usage[engine].search_time += result.elapsed;
+        game.apply(result.best_move);
+    }
+
+    std::array<int, 2> scores{};
+    auto const players = game.get_players();
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        scores[get_engine(i)] += game.get_score(players[i]);
+    }
+    return scores[0] > scores[1] ? 1.0 : scores[0] < scores[1] ? 0.0 : 0.5;
+}
+
+// ----------------------------------------------------------------------------
+
+std::optional<EngineOptions> parse_engine(std::string const& text) {
+    EngineOptions engine;
+    std::istringstream stream(text);
+    std::string field;
+    std::vector<std::string> fields;
+    // The model path is the rest of the text, it may hold colons itself
+    while (fields.size() < 3 && std::getline(stream, field, ':')) {
+        fields.push_back(field);
+    }
+    if (fields.size() < 2 || fields[0].empty()) {
+        return std::nullopt;
+    }
+    engine.name = fields[0];
+    if (!blokus::parse_number(fields[1], engine.iterations)) {
+        return std::nullopt;
+    }
+    if (fields.size() == 3 && !blokus::parse_number(fields[2], engine.exploration)) {
+        return std::nullopt;
+    }
+    if (std::getline(stream, field)) {
+        engine.model_path = field;
+    }
+    return engine;
+}
+
+void print_usage() {
+    std::cerr <<
+        "Usage: Tournament --engine <name>:<iterations>[:<exploration>[:<model file>]] --engine ... [--mode round-robin|gauntlet]\n"
+        "                  [--games <count>] [--threads <count>] [--pin <on|off>] [--sprt <elo0>,<elo1>] [--random-plies <count>] [--seed <seed>]\n";
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--engine") {
+            auto engine = parse_engine(value);
+            if (!engine) {
+                return std::nullopt;
+            }
+            options.engines.push_back(std::move(*engine));
+        }
+        else if (option == "--mode") {
+            if (value != "round-robin" && value != "gauntlet") {
+                return std::nullopt;
+            }
+            options.gauntlet = value == "gauntlet";
+        }
+        else if (option == "--games") {
+            if (!blokus::parse_number(value, options.games)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.pool.thread_count)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--pin") {
+            if (value != "on" && value != "off") {
+                return std::nullopt;
+            }
+            options.pool.pin_threads = value == "on";
+        }
+        else if (option == "--sprt") {
+            auto const comma = value.find(',');
+            if (comma == std::string::npos) {
+                return std::nullopt;
+            }
+            blokus::SprtConfig sprt;
+            if (!blokus::parse_number(std::string_view(value).substr(0, comma), sprt.elo0) ||
+                !blokus::parse_number(std::string_view(value).substr(comma + 1), sprt.elo1)) {
+                return std::nullopt;
+            }
+            options.sprt = sprt;
+        }
+        else if (option == "--random-plies") {
+            if (!blokus::parse_number(value, options.random_plies)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--seed") {
+            if (!blokus::parse_number(value, options.seed)) {
+                return std::nullopt;
+            }
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    if (options.engines.size() < 2) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+void print_report(Options const& options, Schedule const& schedule, std::chrono::duration<double> elapsed) {
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (auto const& pairing : schedule.get_pairings()) {
+        auto const& score = pairing.score;
+        auto const elo = blokus::estimate_elo(score);
+        std::cout
+            << options.engines[pairing.first].name << " vs " << options.engines[pairing.second].name << ": "
+            << '+' << score.wins << " =" << score.draws << " -" << score.losses
+            << ", score " << std::setprecision(3) << score.get_score() << std::setprecision(1)
+            << ", Elo " << elo.elo << " [" << elo.lower << ", " << elo.upper << "]";
+        if (pairing.sprt) {
+            auto const& sprt = *pairing.sprt;
+            std::cout << ", LLR " << std::setprecision(2) << sprt.llr
+                << " (" << sprt.lower_bound << ", " << sprt.upper_bound << ")" << std::setprecision(1)
+                << (sprt.status == blokus::SprtStatus::AcceptH1 ? " H1 accepted" : sprt.status == blokus::SprtStatus::AcceptH0 ? " H0 accepted" : "");
+        }
+        std::cout << '\n';
+    }
+
+    // Strength only means something next to what it costs
+    auto const usages = schedule.get_usages();
+    for (std::size_t i = 0; i < options.engines.size(); ++i) {
+        auto const& usage = usages[i];
+        auto const milliseconds = usage.moves == 0 ? 0.0 : std::chrono::duration<double, std::milli>(usage.search_time).count() / usage.moves;
+        std::cout << options.engines[i].name << ": " << usage.moves << " moves, " << milliseconds << " ms per move\n";
+    }
+    std::cout << "Elapsed " << elapsed.count() << " s\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto options = *parsed;
+
+    try {
+        for (auto& engine : options.engines) {
+            if (!engine.model_path.empty()) {
+                engine.model = std::make_shared<blokus::LinearModel const>(blokus::LinearModel::load(engine.model_path));
+            }
+        }
+        Schedule schedule(options);
+        auto const start = std::chrono::steady_clock::now();
+        {
+            // Single threaded games, one per worker: the parallelism is across games
+            blokus::ThreadPool pool(options.pool);
+            std::vector<std::future<void>> workers;
+            for (std::size_t i = 0; i < pool.get_thread_count(); ++i) {
+                workers.push_back(pool.submit([&options, &schedule] {
+                    while (auto const job = schedule.next()) {
+                        std::array<EngineUsage, 2> usage{};
+                        auto const pairing = schedule.get_pairings()[job->pairing];
+                        auto const score = play_game(options, pairing, job->game, usage);
+                        schedule.record(*job, score, usage);
+                    }
+                }));
+            }
+            for (auto& worker : workers) {
+                worker.get();
+            }
+        }
+        print_report(options, schedule, std::chrono::steady_clock::now() - start);
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
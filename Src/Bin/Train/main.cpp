@@ -0,0 +1,176 @@
+// Train: fits the linear policy and value model on the games of self-play shards
+//
+// Every game is loaded in memory, then each epoch replays them all in a new order on every thread,
+// the threads updating the shared weights without locks. The model is saved after each epoch, so an
+// interrupted run keeps its last complete epoch. With --model, training continues from a saved model.
+// The model is then given to an engine, for example Tournament --engine trained:1000:1.5:model.bin
+//
+// Usage: Train --input <shard file or directory> [--input ...] --output <model file> [--model <model file>]
+//              [--epochs <count>] [--learning-rate <rate>] [--threads <count>] [--seed <seed>]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Blokus/GameRecord.h"
+#include "Blokus/LinearModel.h"
+#include "Blokus/ModelTraining.h"
+#include "Blokus/Protocol.h"
+#include "Blokus/Shard.h"
+#include "Blokus/ThreadPool.h"
+
+namespace {
+
+struct Options {
+    std::vector<std::filesystem::path> inputs;
+    std::filesystem::path output;
+    std::optional<std::filesystem::path> model;
+    blokus::TrainingConfig training;
+    std::size_t threads{ std::thread::hardware_concurrency() };
+};
+
+// ----------------------------------------------------------------------------
+
+// Corrupted blocks end their shard, what was read before them is kept
+std::vector<blokus::GameRecord> load_records(std::vector<std::filesystem::path> const& shards) {
+    std::vector<blokus::GameRecord> records;
+    for (auto const& shard : shards) {
+        try {
+            blokus::ShardReader reader(shard);
+            std::vector<std::uint8_t> block;
+            std::uint32_t record_count = 0;
+            while (reader.read_block(block, record_count)) {
+                std::size_t offset = 0;
+                for (std::uint32_t i = 0; i < record_count; ++i) {
+                    auto record = blokus::read_record(block, offset);
+                    if (!record) {
+                        break;
+                    }
+                    records.push_back(std::move(*record));
+                }
+            }
+        }
+        catch (std::runtime_error const& error) {
+            std::cerr << shard.string() << ": " << error.what() << '\n';
+        }
+    }
+    return records;
+}
+
+// ----------------------------------------------------------------------------
+
+void print_usage() {
+    std::cerr <<
+        "Usage: Train --input <shard file or directory> [--input ...] --output <model file> [--model <model file>]\n"
+        "             [--epochs <count>] [--learning-rate <rate>] [--threads <count>] [--seed <seed>]\n";
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--input") {
+            options.inputs.push_back(value);
+        }
+        else if (option == "--output") {
+            options.output = value;
+        }
+        else if (option == "--model") {
+            options.model = value;
+        }
+        else if (option == "--epochs") {
+            if (!blokus::parse_number(value, options.training.epochs)) {
+                return std::nullopt;
+            }
+        }
+        else if (option == "--learning-rate") {
+            // The value rate keeps its ratio to the policy one
+            auto rate = 0.0f;
+            if (!blokus::parse_number(value, rate) || rate <= 0.0f) {
+                return std::nullopt;
+            }
+            options.training.value_learning_rate *= rate / options.training.policy_learning_rate;
+            options.training.policy_learning_rate = rate;
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.threads)) {
+                return std::nullopt;
+            }
+            options.threads = std::max<std::size_t>(options.threads, 1);
+        }
+        else if (option == "--seed") {
+            if (!blokus::parse_number(value, options.training.seed)) {
+                return std::nullopt;
+            }
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    if (options.inputs.empty() || options.output.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto const& options = *parsed;
+
+    try {
+        auto const records = load_records(blokus::list_shards(options.inputs));
+        if (records.empty()) {
+            std::cerr << "no games to train on\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << records.size() << " games\n";
+
+        auto model = options.model ? blokus::LinearModel::load(*options.model) : blokus::LinearModel();
+        blokus::ThreadPool pool(options.threads);
+
+        // One epoch per call, so that the model can be saved in between
+        auto config = options.training;
+        config.epochs = 1;
+        for (std::size_t epoch = 0; epoch < options.training.epochs; ++epoch) {
+            config.seed = options.training.seed + epoch;
+            blokus::train_linear_model(model, records, pool, config, [epoch](blokus::EpochStatistics const& statistics) {
+                auto const seconds = std::chrono::duration<double>(statistics.elapsed).count();
+                std::cout << std::fixed << std::setprecision(4)
+                    << "epoch " << epoch + 1 << ": policy loss " << statistics.policy_loss
+                    << ", accuracy " << statistics.policy_accuracy << ", value loss " << statistics.value_loss
+                    << std::setprecision(1) << ", " << static_cast<double>(statistics.positions) / seconds << " positions/s, "
+                    << statistics.skipped_games << " invalid games skipped\n";
+            });
+            model.save(options.output);
+            config.policy_learning_rate *= options.training.decay;
+            config.value_learning_rate *= options.training.decay;
+        }
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+// Validator: replays every game of self-play shards through the rules and reports the broken ones
+//
+// The main thread reads and decompresses the blocks, file after file, and the pool replays them,
+// a block per task. Results are reported in file order. A shard that can't be read any further is
+// reported once and the next one is checked.
+//
+// Usage: Validator --input <shard file or directory> [--input ...] [--threads <count>] [--max-reports <count>]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Blokus/Protocol.h"
+#include "Blokus/RecordValidation.h"
+#include "Blokus/Shard.h"
+#include "Blokus/ThreadPool.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<std::filesystem::path> inputs;
+    std::size_t threads{ std::thread::hardware_concurrency() };
+    // Problems printed one by one, the others are only counted
+    std::size_t max_reports{ 20 };
+};
+
+struct Problem {
+    std::size_t record;
+    blokus::RecordCheck check;
+};
+
+struct BlockResult {
+    std::uint64_t game_count{ 0 };
+    std::uint64_t move_count{ 0 };
+    std::vector<Problem> problems;
+    // Set when the block ends before its record count
+    bool truncated{ false };
+};
+
+struct Totals {
+    std::uint64_t game_count{ 0 };
+    std::uint64_t move_count{ 0 };
+    std::uint64_t unreadable_files{ 0 };
+    std::uint64_t truncated_blocks{ 0 };
+    std::array<std::uint64_t, blokus::record_status_count> problem_counts{};
+    std::size_t reports{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+BlockResult validate_block(std::vector<std::uint8_t> const& block, std::uint32_t record_count) {
+    BlockResult result;
+    std::size_t offset = 0;
+    for (std::uint32_t i = 0; i < record_count; ++i) {
+        auto const record = blokus::read_record(block, offset);
+        if (!record) {
+            result.truncated = true;
+            break;
+        }
+        ++result.game_count;
+        result.move_count += record->moves.size();
+        auto const check = blokus::validate_record(*record);
+        if (check.status != blokus::RecordStatus::Valid) {
+            result.problems.push_back({ i, check });
+        }
+    }
+    return result;
+}
+
+class Reporter {
+public:
+    Reporter(Options const& options, Totals& totals)
+        : options(options)
+        , totals(totals)
+    {}
+
+    void add(std::filesystem::path const& path, std::size_t block, BlockResult const& result) {
+        totals.game_count += result.game_count;
+        totals.move_count += result.move_count;
+        if (result.truncated) {
+            ++totals.truncated_blocks;
+            report(path, block) << "records end before the count of the block\n";
+        }
+        for (auto const& problem : result.problems) {
+            ++totals.problem_counts[static_cast<std::size_t>(problem.check.status)];
+            report(path, block) << "record " << problem.record << ": " << get_status_name(problem.check.status)
+                << " at ply " << problem.check.ply;
+            if (problem.check.status == blokus::RecordStatus::IllegalMove || problem.check.status == blokus::RecordStatus::MoveAfterEnd) {
+                std::cout << " (move " << problem.check.move.get_value() << ')';
+            }
+            std::cout << '\n';
+        }
+    }
+
+    void add_unreadable(std::filesystem::path const& path, std::string_view reason) {
+        ++totals.unreadable_files;
+        if (totals.reports++ < options.max_reports) {
+            std::cout << path.string() << ": " << reason << '\n';
+        }
+    }
+
+private:
+    // Prints the location, or swallows the line once the report limit is reached
+    std::ostream& report(std::filesystem::path const& path, std::size_t block) {
+        if (totals.reports++ >= options.max_reports) {
+            discard.str({});
+            return discard;
+        }
+        return std::cout << path.string() << " block " << block << ' ';
+    }
+
+    Options const& options;
+    Totals& totals;
+    std::ostringstream discard;
+};
+
+// ----------------------------------------------------------------------------
+
+void print_usage() {
+    std::cerr << "Usage: Validator --input <shard file or directory> [--input ...] [--threads <count>] [--max-reports <count>]\n";
+}
+
+std::optional<Options> parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view const option = argv[i];
+        if (i + 1 >= argc) {
+            return std::nullopt;
+        }
+        std::string const value = argv[++i];
+        if (option == "--input") {
+            options.inputs.push_back(value);
+        }
+        else if (option == "--threads") {
+            if (!blokus::parse_number(value, options.threads)) {
+                return std::nullopt;
+            }
+            options.threads = std::max<std::size_t>(options.threads, 1);
+        }
+        else if (option == "--max-reports") {
+            if (!blokus::parse_number(value, options.max_reports)) {
+                return std::nullopt;
+            }
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+    if (options.inputs.empty()) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+void print_summary(Totals const& totals, std::chrono::duration<double> elapsed) {
+    std::uint64_t invalid = 0;
+    for (auto const count : totals.problem_counts) {
+        invalid += count;
+    }
+    std::cout << totals.game_count << " games, " << invalid << " invalid";
+    for (std::size_t status = 1; status < totals.problem_counts.size(); ++status) {
+        if (totals.problem_counts[status] != 0) {
+            std::cout << ", " << totals.problem_counts[status] << ' ' << get_status_name(static_cast<blokus::RecordStatus>(status));
+        }
+    }
+    std::cout << '\n';
+    if (totals.truncated_blocks != 0 || totals.unreadable_files != 0) {
+        std::cout << totals.truncated_blocks << " truncated blocks, " << totals.unreadable_files << " unreadable files\n";
+    }
+    auto const seconds = elapsed.count();
+    std::cout << std::fixed << std::setprecision(1)
+        << seconds << " s, " << static_cast<double>(totals.game_count) / seconds << " games/s, "
+        << static_cast<double>(totals.move_count) / seconds / 1e6 << " M moves/s\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    auto const parsed = parse_options(argc, argv);
+    if (!parsed) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    auto const& options = *parsed;
+
+    Totals totals;
+    auto const start = Clock::now();
+    try {
+        blokus::ThreadPool pool(options.threads);
+        Reporter reporter(options, totals);
+
+        struct Pending {
+            std::filesystem::path const* path;
+            std::size_t block;
+            std::future<BlockResult> result;
+        };
+        std::deque<Pending> pending;
+        // Bounds the decompressed blocks held in memory
+        auto const max_pending = pool.get_thread_count() * 4;
+        auto const collect_oldest = [&pending, &reporter] {
+            auto& oldest = pending.front();
+            reporter.add(*oldest.path, oldest.block, oldest.result.get());
+            pending.pop_front();
+        };
+
+        auto const shards = blokus::list_shards(options.inputs);
+        for (auto const& shard : shards) {
+            try {
+                blokus::ShardReader reader(shard);
+                std::vector<std::uint8_t> block;
+                std::uint32_t record_count = 0;
+                for (std::size_t index = 0; reader.read_block(block, record_count); ++index) {
+                    pending.push_back({ &shard, index, pool.submit([block = std::move(block), record_count] {
+                        return validate_block(block, record_count);
+                    }) });
+                    block = {};
+                    if (pending.size() >= max_pending) {
+                        collect_oldest();
+                    }
+                }
+            }
+            catch (std::runtime_error const& error) {
+                // The blocks read so far are still reported, before the error in file order
+                while (!pending.empty()) {
+                    collect_oldest();
+                }
+                reporter.add_unreadable(shard, error.what());
+            }
+        }
+        while (!pending.empty()) {
+            collect_oldest();
+        }
+    }
+    catch (std::exception const& error) {
+        std::cerr << error.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    print_summary(totals, Clock::now() - start);
+    std::uint64_t invalid = totals.truncated_blocks + totals.unreadable_files;
+    for (auto const count : totals.problem_counts) {
+        invalid += count;
+    }
+    return invalid == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
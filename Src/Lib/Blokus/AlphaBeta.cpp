@@ -0,0 +1,164 @@
+#include "pch.h"
+#include "AlphaBeta.h"
+
+#include <algorithm>
+
+#include "MoveGeneration.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr int infinity = 1 << 30;
+// Finished games outrank any estimate
+constexpr int win_weight = 1 << 20;
+constexpr int score_weight = 16;
+constexpr int anchor_weight = 4;
+constexpr int territory_weight = 1;
+// Nodes between two looks at the clock
+constexpr std::uint64_t deadline_interval = 1024;
+
+}
+
+AlphaBeta::AlphaBeta(AlphaBetaConfig config)
+    : config(config)
+    , orderer(config.ordering)
+{}
+
+AlphaBetaResult AlphaBeta::search(Game const& game, Deadline const& search_deadline) {
+    auto const start = Deadline::Clock::now();
+    AlphaBetaResult result;
+
+    root_player = game.get_current_player();
+    deadline = search_deadline;
+    nodes = 0;
+    stopped = false;
+    orderer.start_search();
+
+    auto position = game;
+    position.track_reachable();
+    patterns.reset(position);
+
+    MoveList moves;
+    generate_moves(position, patterns, moves);
+    if (moves.empty()) {
+        return result;
+    }
+    orderer.order(position, patterns, moves, 0);
+    result.best_move = moves[0];
+
+    for (int depth = 1; depth <= config.depth && !stopped; ++depth) {
+        auto alpha = -infinity;
+        auto best_move = moves[0];
+        for (auto const move : moves) {
+            apply(position, move, depth - 1);
+            auto const value = search(position, depth - 1, alpha, infinity, 1);
+            undo(position, depth - 1);
+            if (stopped) {
+                break;
+            }
+            if (value > alpha) {
+                alpha = value;
+                best_move = move;
+            }
+        }
+        if (stopped) {
+            break;
+        }
+
+        result.best_move = best_move;
+        result.value = alpha;
+        result.depth = depth;
+        // The best move of this iteration is searched first by the next one
+        auto const best = std::find(moves.begin(), moves.end(), best_move);
+        std::rotate(moves.begin(), best, best + 1);
+    }
+
+    result.nodes = nodes;
+    result.deadline_reached = stopped;
+    result.elapsed = Deadline::Clock::now() - start;
+    return result;
+}
+
+int AlphaBeta::search(Game& game, int depth, int alpha, int beta, std::size_t ply) {
+    ++nodes;
+    if (nodes % deadline_interval == 0 && deadline.has_expired()) {
+        stopped = true;
+        return 0;
+    }
+    if (depth == 0 || game.is_over()) {
+        return evaluate(game);
+    }
+
+    MoveList moves;
+    generate_moves(game, patterns, moves);
+    orderer.order(game, patterns, moves, ply);
+
+    auto const maximizing = game.get_current_player() == root_player;
+    auto best = maximizing ? -infinity : infinity;
+    for (auto const move : moves) {
+        apply(game, move, depth - 1);
+        auto const value = search(game, depth - 1, alpha, beta, ply + 1);
+        undo(game, depth - 1);
+        if (stopped) {
+            return 0;
+        }
+
+        if (maximizing ? value > best : value < best) {
+            best = value;
+        }
+        if (maximizing) {
+            alpha = std::max(alpha, value);
+        }
+        else {
+            beta = std::min(beta, value);
+        }
+        if (alpha >= beta) {
+            orderer.add_cutoff(game, move, ply, depth);
+            break;
+        }
+    }
+    return best;
+}
+
+void AlphaBeta::apply(Game& game, Move const& move, int depth) {
+    if (depth > 0) {
+        patterns.apply(game, move);
+    }
+    else {
+        game.apply(move);
+    }
+}
+
+void AlphaBeta::undo(Game& game, int depth) {
+    if (depth > 0) {
+        patterns.undo(game);
+    }
+    else {
+        game.undo();
+    }
+}
+
+int AlphaBeta::evaluate(Game const& game) const {
+    auto const players = game.get_players();
+    auto const opponent_count = static_cast<int>(players.size()) - 1;
+
+    // Own score, anchors and territory against the sum of the opponents', scaled to weigh the same
+    auto score = 0;
+    auto anchors = 0;
+    auto territory = 0;
+    for (auto const player : players) {
+        auto const sign = player == root_player ? opponent_count : -1;
+        score += sign * game.get_score(player);
+        if (!game.is_finished(player)) {
+            anchors += sign * game.get_anchors(player).count();
+            territory += sign * game.get_reachable(player).count();
+        }
+    }
+    if (game.is_over()) {
+        return score * win_weight;
+    }
+    return score_weight * score + anchor_weight * anchors + territory_weight * territory;
+}
+
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "AnchorPattern.h"
+#include "Deadline.h"
+#include "Game.h"
+#include "Move.h"
+#include "MoveOrdering.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct AlphaBetaConfig {
+    // In plies, every player's move counts
+    int depth{ 3 };
+    MoveOrderingConfig ordering{};
+};
+
+struct AlphaBetaResult {
+    Move best_move{ Move::pass() };
+    // From the point of view of the player to move at the root
+    int value{ 0 };
+    // Deepest iteration completed
+    int depth{ 0 };
+    std::uint64_t nodes{ 0 };
+    bool deadline_reached{ false };
+    std::chrono::nanoseconds elapsed{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Paranoid alpha-beta: the opponents are assumed to play together against the player to move at the
+// root, which turns the multi-player game into a two-sided one. Iterative deepening fills the move
+// ordering tables for the deeper iterations and returns the last complete one when the deadline hits.
+class AlphaBeta {
+public:
+    explicit AlphaBeta(AlphaBetaConfig config = {});
+
+    AlphaBetaResult search(Game const& game, Deadline const& deadline = Deadline::never());
+
+    AlphaBetaConfig const& get_config() const { return config; }
+
+private:
+    int search(Game& game, int depth, int alpha, int beta, std::size_t ply);
+    // Plays the move of a child searched to the depth. The pattern keys only follow the positions whose
+    // moves are generated, the leaves are evaluated without them.
+    void apply(Game& game, Move const& move, int depth);
+    void undo(Game& game, int depth);
+    int evaluate(Game const& game) const;
+
+    AlphaBetaConfig config;
+    MoveOrderer orderer;
+    // Follows the game searched, for the move generation and ordering
+    PatternTracker patterns;
+
+    // State of the current search
+    PlayerId root_player{ PlayerId::Red };
+    Deadline deadline{ Deadline::never() };
+    std::uint64_t nodes{ 0 };
+    bool stopped{ false };
+};
+
+}
@@ -0,0 +1,209 @@
+#include "pch.h"
+#include "AnchorPattern.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+#include "Orientation.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr int half_bit_count = pattern_bit_count / 2;
+constexpr PatternKey half_mask = (PatternKey{ 1 } << half_bit_count) - 1;
+
+// The neighbourhood squares each placement of a piece through the center needs, without the ones
+// needing a superset of another: those fit whenever the smaller one does
+std::vector<PatternKey> get_placement_masks(PieceId piece) {
+    std::vector<PatternKey> masks;
+    auto const range = get_orientation_range(piece);
+    for (auto index = range.first; index < range.last; ++index) {
+        auto const& orientation = get_orientation(index);
+        for (int center = 0; center < orientation.size; ++center) {
+            PatternKey mask = 0;
+            for (int i = 0; i < orientation.size; ++i) {
+                auto const dx = orientation.squares[i].x - orientation.squares[center].x;
+                auto const dy = orientation.squares[i].y - orientation.squares[center].y;
+                if (i != center && std::abs(dx) <= pattern_radius && std::abs(dy) <= pattern_radius) {
+                    mask |= PatternKey{ 1 } << get_pattern_bit(dx, dy);
+                }
+            }
+            masks.push_back(mask);
+        }
+    }
+
+    std::sort(masks.begin(), masks.end());
+    masks.erase(std::unique(masks.begin(), masks.end()), masks.end());
+    std::erase_if(masks, [&masks](PatternKey mask) {
+        return std::any_of(masks.begin(), masks.end(), [mask](PatternKey other) {
+            return other != mask && (other & ~mask) == 0;
+        });
+    });
+    return masks;
+}
+
+// A placement fits when both halves of its mask are free, so each half of the key gets, per piece, the
+// placements whose half fits: the piece fits when one placement is in both
+struct FittingTables {
+    std::array<std::array<std::uint64_t, piece_count>, half_mask + 1> low{};
+    std::array<std::array<std::uint64_t, piece_count>, half_mask + 1> high{};
+
+    FittingTables() {
+        for (std::size_t piece = 0; piece < piece_count; ++piece) {
+            auto const masks = get_placement_masks(static_cast<PieceId>(piece));
+            assert(masks.size() <= 64);
+            for (PatternKey half = 0; half <= half_mask; ++half) {
+                for (std::size_t i = 0; i < masks.size(); ++i) {
+                    auto const bit = std::uint64_t{ 1 } << i;
+                    if ((masks[i] & half_mask & ~half) == 0) {
+                        low[half][piece] |= bit;
+                    }
+                    if ((masks[i] >> half_bit_count & ~half) == 0) {
+                        high[half][piece] |= bit;
+                    }
+                }
+            }
+        }
+    }
+};
+
+FittingTables const& get_fitting_tables() {
+    static FittingTables const tables;
+    return tables;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+PatternKey get_pattern_key(Bitboard const& forbidden, Square square) {
+    auto const center = to_position(square);
+    PatternKey key = 0;
+    for (int dy = -pattern_radius; dy <= pattern_radius; ++dy) {
+        for (int dx = -pattern_radius; dx <= pattern_radius; ++dx) {
+            Position const neighbour{ center.get_x() + dx, center.get_y() + dy };
+            if ((dx != 0 || dy != 0) && is_on_board(neighbour) && !forbidden.test(to_square(neighbour))) {
+                key |= PatternKey{ 1 } << get_pattern_bit(dx, dy);
+            }
+        }
+    }
+    return key;
+}
+
+PieceSet get_fitting_pieces(PatternKey key) {
+    auto const& tables = get_fitting_tables();
+    auto const& low = tables.low[key & half_mask];
+    auto const& high = tables.high[key >> half_bit_count & half_mask];
+    std::uint32_t bits = 0;
+    for (std::size_t piece = 0; piece < piece_count; ++piece) {
+        if ((low[piece] & high[piece]) != 0) {
+            bits |= std::uint32_t{ 1 } << piece;
+        }
+    }
+    return PieceSet::from_bits(bits);
+}
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// The keys a square is part of: the squares around it within the radius, with the bit of the square in
+// the key of each
+struct KeyNeighbours {
+    std::array<Square, pattern_bit_count> centers{};
+    std::array<PatternKey, pattern_bit_count> bits{};
+    int count{ 0 };
+};
+
+std::array<KeyNeighbours, square_count> const& get_key_neighbours() {
+    static auto const table = [] {
+        std::array<KeyNeighbours, square_count> result{};
+        for (Square square = 0; square < square_count; ++square) {
+            auto const position = to_position(square);
+            auto& neighbours = result[square];
+            for (int dy = -pattern_radius; dy <= pattern_radius; ++dy) {
+                for (int dx = -pattern_radius; dx <= pattern_radius; ++dx) {
+                    // The square is at (dx, dy) from the center of the key
+                    Position const center{ position.get_x() - dx, position.get_y() - dy };
+                    if ((dx != 0 || dy != 0) && is_on_board(center)) {
+                        neighbours.centers[neighbours.count] = to_square(center);
+                        neighbours.bits[neighbours.count] = PatternKey{ 1 } << get_pattern_bit(dx, dy);
+                        ++neighbours.count;
+                    }
+                }
+            }
+        }
+        return result;
+    }();
+    return table;
+}
+
+}
+
+PatternTracker::PatternTracker()
+    : keys(player_id_count * square_count, 0)
+{}
+
+// Starts from the keys of the empty board and flips the squares the player is forbidden
+void PatternTracker::reset(Game const& game) {
+    static auto const empty_keys = [] {
+        std::array<PatternKey, square_count> result{};
+        for (Square square = 0; square < square_count; ++square) {
+            result[square] = get_pattern_key(Bitboard{}, square);
+        }
+        return result;
+    }();
+
+    auto const& table = get_key_neighbours();
+    std::fill(keys.begin(), keys.end(), 0);
+    for (auto const player : game.get_players()) {
+        auto* const player_keys = &keys[to_index(player) * square_count];
+        std::copy(empty_keys.begin(), empty_keys.end(), player_keys);
+        game.get_forbidden(player).for_each([&table, player_keys](Square square) {
+            auto const& neighbours = table[square];
+            for (int i = 0; i < neighbours.count; ++i) {
+                player_keys[neighbours.centers[i]] ^= neighbours.bits[i];
+            }
+        });
+    }
+}
+
+void PatternTracker::apply(Game& game, Move const& move) {
+    if (!move.is_pass()) {
+        flip(game, game.get_current_player(), get_footprint(move));
+    }
+    game.apply(move);
+}
+
+void PatternTracker::undo(Game& game) {
+    auto const ply = game.get_ply() - 1;
+    auto const move = game.get_move(ply);
+    auto const player = game.get_move_player(ply);
+    game.undo();
+    if (!move.is_pass()) {
+        flip(game, player, get_footprint(move));
+    }
+}
+
+// The move forbids its footprint to every player and its edges to the mover, which flips the bits of
+// those squares not forbidden already in the keys around them. Flipping them again undoes the move.
+void PatternTracker::flip(Game const& game, PlayerId mover, Bitboard const& footprint) {
+    auto const& table = get_key_neighbours();
+    for (auto const player : game.get_players()) {
+        auto const forbidden = player == mover ? footprint | get_edge_neighbours(footprint) : footprint;
+        auto const changed = forbidden & ~game.get_forbidden(player);
+        auto* const player_keys = &keys[to_index(player) * square_count];
+        changed.for_each([&table, player_keys](Square square) {
+            auto const& neighbours = table[square];
+            for (int i = 0; i < neighbours.count; ++i) {
+                player_keys[neighbours.centers[i]] ^= neighbours.bits[i];
+            }
+        });
+    }
+}
+
+}
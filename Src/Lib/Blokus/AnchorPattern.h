@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Board.h"
+#include "Game.h"
+#include "Move.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// The 5x5 neighbourhood of a square as seen by one player: one bit per square around it, set when the
+// player can place a square there (on the board and not forbidden). The squares are numbered row by
+// row from the top left one, skipping the center: bit 0 is (-2, -2), bit 11 is (-1, 0), bit 23 is (2, 2).
+using PatternKey = std::uint32_t;
+
+constexpr int pattern_radius = 2;
+constexpr int pattern_bit_count = 24;
+
+// Bit of the neighbour at the offset from the center, both coordinates within the radius
+constexpr int get_pattern_bit(int dx, int dy) {
+    auto const bit = (dy + pattern_radius) * (2 * pattern_radius + 1) + dx + pattern_radius;
+    return bit < pattern_bit_count / 2 ? bit : bit - 1;
+}
+
+// Key of the square computed from the squares the player is forbidden, see Game::get_forbidden
+PatternKey get_pattern_key(Bitboard const& forbidden, Square square);
+
+// Index of the key in a table of weights, the 24 bits hashed down to pattern_index_bits. Different
+// keys may share an index.
+constexpr int pattern_index_bits = 16;
+
+constexpr std::uint32_t get_pattern_index(PatternKey key) {
+    return (key * 0x9e3779b1u) >> (32 - pattern_index_bits);
+}
+
+// Pieces with a placement covering the center of the pattern whose squares in the neighbourhood are all
+// free. The other pieces can't be placed there at all, those of the set may still leave the
+// neighbourhood and hit a forbidden square beyond it. Two table lookups per piece, no geometry.
+PieceSet get_fitting_pieces(PatternKey key);
+
+// ----------------------------------------------------------------------------
+
+// The keys of every square for every player of a game, kept up to date a square at a time as the
+// players are forbidden more squares or get them back. A search that applies and undoes its moves on
+// one game owns a tracker and plays the moves through it. Games don't carry the keys, so copying a
+// game stays cheap.
+class PatternTracker {
+public:
+    PatternTracker();
+
+    // Computes the keys of the game from scratch
+    void reset(Game const& game);
+
+    // Same as Game::apply and Game::undo, with the keys following the game
+    void apply(Game& game, Move const& move);
+    void undo(Game& game);
+
+    // Same as get_pattern_key with the squares the player is forbidden in the game followed
+    PatternKey get_key(PlayerId player, Square square) const { return keys[to_index(player) * square_count + square]; }
+
+private:
+    // The game is in the position before the move of the mover with the footprint
+    void flip(Game const& game, PlayerId mover, Bitboard const& footprint);
+
+    std::vector<PatternKey> keys;
+};
+
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+#include "Arena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace blokus {
+
+namespace {
+
+std::size_t align_up(std::size_t value, std::size_t alignment) {
+    assert((alignment & (alignment - 1)) == 0);
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+Arena::Arena(ArenaConfig config)
+    : config(config)
+{
+    assert(config.block_size > 0);
+}
+
+void* Arena::allocate(std::size_t size, std::size_t alignment) {
+    if (current_block < blocks.size()) {
+        auto& block = blocks[current_block];
+        auto const base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        auto const start = align_up(base + offset, alignment) - base;
+        if (start + size <= block.size) {
+            offset = start + size;
+            high_water_mark = std::max(high_water_mark, previous_blocks_size + offset);
+            return block.data.get() + start;
+        }
+    }
+
+    if (!next_block(size, alignment)) {
+        ++failed_allocation_count;
+        return nullptr;
+    }
+    return allocate(size, alignment);
+}
+
+bool Arena::next_block(std::size_t size, std::size_t alignment) {
+    auto const required_size = size + alignment;
+
+    auto next = current_block;
+    auto next_previous_blocks_size = previous_blocks_size;
+    if (current_block < blocks.size()) {
+        next_previous_blocks_size += offset;
+        ++next;
+    }
+
+    // Blocks kept from a previous search are reused when they are big enough
+    if (next >= blocks.size() || blocks[next].size < required_size) {
+        auto const block_size = std::max(config.block_size, required_size);
+        if (config.max_reserved_size != 0 && reserved_size + block_size > config.max_reserved_size) {
+            return false;
+        }
+        blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(next), Block{ std::make_unique_for_overwrite<std::byte[]>(block_size), block_size });
+        reserved_size += block_size;
+    }
+
+    current_block = next;
+    previous_blocks_size = next_previous_blocks_size;
+    offset = 0;
+    return true;
+}
+
+void Arena::reset() {
+    current_block = 0;
+    offset = 0;
+    previous_blocks_size = 0;
+}
+
+ArenaStatistics Arena::get_statistics() const {
+    return {
+        .used_size = previous_blocks_size + offset,
+        .reserved_size = reserved_size,
+        .high_water_mark = high_water_mark,
+        .block_count = blocks.size(),
+        .failed_allocation_count = failed_allocation_count,
+    };
+}
+
+}
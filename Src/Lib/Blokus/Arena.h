@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct ArenaConfig {
+    std::size_t block_size{ std::size_t{ 1 } << 20 };
+    // 0 means unlimited, otherwise allocations fail once the reserved memory would go over it
+    std::size_t max_reserved_size{ 0 };
+};
+
+struct ArenaStatistics {
+    std::size_t used_size{ 0 };
+    std::size_t reserved_size{ 0 };
+    // Largest used size since the arena creation, reset() doesn't clear it
+    std::size_t high_water_mark{ 0 };
+    std::size_t block_count{ 0 };
+    std::size_t failed_allocation_count{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Bump allocator for the search, objects are never destroyed one by one.
+// reset() releases everything in O(1) and keeps the blocks for the next search.
+class Arena {
+public:
+    explicit Arena(ArenaConfig config = {});
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+
+    // nullptr when the configured maximum reserved size is reached
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    template<class T, class... Args>
+    T* create(Args&&... args);
+
+    // Default initialized array, empty when the allocation fails
+    template<class T>
+    std::span<T> create_array(std::size_t count);
+
+    void reset();
+
+    ArenaStatistics get_statistics() const;
+    ArenaConfig const& get_config() const { return config; }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    bool next_block(std::size_t size, std::size_t alignment);
+
+    ArenaConfig config;
+    std::vector<Block> blocks;
+    std::size_t current_block{ 0 };
+    std::size_t offset{ 0 };
+    // Used size of the blocks before the current one
+    std::size_t previous_blocks_size{ 0 };
+    std::size_t reserved_size{ 0 };
+    std::size_t high_water_mark{ 0 };
+    std::size_t failed_allocation_count{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+template<class T, class... Args>
+T* Arena::create(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+    auto* memory = allocate(sizeof(T), alignof(T));
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    return new (memory) T(std::forward<Args>(args)...);
+}
+
+template<class T>
+std::span<T> Arena::create_array(std::size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+    if (count == 0) {
+        return {};
+    }
+    auto* memory = allocate(sizeof(T) * count, alignof(T));
+    if (memory == nullptr) {
+        return {};
+    }
+    return { new (memory) T[count], count };
+}
+
+}
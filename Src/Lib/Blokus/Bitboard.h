@@ -0,0 +1,239 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+#include "Board.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// One bit per board square, using the Square index as bit index
+class Bitboard {
+public:
+    static constexpr int word_bits = 64;
+    static constexpr int word_count = (square_count + word_bits - 1) / word_bits;
+
+    constexpr Bitboard() = default;
+
+    static constexpr Bitboard from_square(Square square) {
+        Bitboard result;
+        result.set(square);
+        return result;
+    }
+
+    static constexpr Bitboard full() {
+        Bitboard result;
+        for (auto& word : result.words) {
+            word = ~std::uint64_t{ 0 };
+        }
+        result.clear_padding();
+        return result;
+    }
+
+    constexpr bool test(Square square) const {
+        assert(square < square_count);
+        return (words[square / word_bits] >> (square % word_bits)) & 1;
+    }
+
+    constexpr void set(Square square) {
+        assert(square < square_count);
+        words[square / word_bits] |= std::uint64_t{ 1 } << (square % word_bits);
+    }
+
+    constexpr void reset(Square square) {
+        assert(square < square_count);
+        words[square / word_bits] &= ~(std::uint64_t{ 1 } << (square % word_bits));
+    }
+
+    constexpr bool any() const {
+        std::uint64_t result = 0;
+        for (auto word : words) {
+            result |= word;
+        }
+        return result != 0;
+    }
+
+    constexpr bool none() const { return !any(); }
+
+    constexpr int count() const {
+        int result = 0;
+        for (auto word : words) {
+            result += std::popcount(word);
+        }
+        return result;
+    }
+
+    // Lowest set square, the bitboard must not be empty
+    constexpr Square lowest() const {
+        for (int i = 0; i < word_count; ++i) {
+            if (words[i] != 0) {
+                return static_cast<Square>(i * word_bits + std::countr_zero(words[i]));
+            }
+        }
+        assert(false && "Empty bitboard");
+        return 0;
+    }
+
+    template<class Function>
+    constexpr void for_each(Function&& function) const {
+        for (int i = 0; i < word_count; ++i) {
+            auto word = words[i];
+            while (word != 0) {
+                function(static_cast<Square>(i * word_bits + std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    constexpr std::uint64_t get_word(int index) const { return words[index]; }
+    constexpr void set_word(int index, std::uint64_t word) { words[index] = word; }
+
+    constexpr Bitboard& operator|=(Bitboard const& other) {
+        for (int i = 0; i < word_count; ++i) { words[i] |= other.words[i]; }
+        return *this;
+    }
+
+    constexpr Bitboard& operator&=(Bitboard const& other) {
+        for (int i = 0; i < word_count; ++i) { words[i] &= other.words[i]; }
+        return *this;
+    }
+
+    constexpr Bitboard& operator^=(Bitboard const& other) {
+        for (int i = 0; i < word_count; ++i) { words[i] ^= other.words[i]; }
+        return *this;
+    }
+
+    constexpr Bitboard operator~() const {
+        Bitboard result;
+        for (int i = 0; i < word_count; ++i) { result.words[i] = ~words[i]; }
+        result.clear_padding();
+        return result;
+    }
+
+    // Moves every bit to a higher square index, bits pushed past the last square are dropped
+    constexpr Bitboard shift_up(int count) const {
+        assert(count >= 0 && count < word_bits);
+        Bitboard result;
+        for (int i = word_count - 1; i >= 0; --i) {
+            auto word = words[i] << count;
+            if (count != 0 && i > 0) {
+                word |= words[i - 1] >> (word_bits - count);
+            }
+            result.words[i] = word;
+        }
+        result.clear_padding();
+        return result;
+    }
+
+    // Moves every bit to a lower square index
+    constexpr Bitboard shift_down(int count) const {
+        assert(count >= 0 && count < word_bits);
+        Bitboard result;
+        for (int i = 0; i < word_count; ++i) {
+            auto word = words[i] >> count;
+            if (count != 0 && i + 1 < word_count) {
+                word |= words[i + 1] << (word_bits - count);
+            }
+            result.words[i] = word;
+        }
+        return result;
+    }
+
+private:
+    constexpr void clear_padding() {
+        constexpr int used_bits = square_count - (word_count - 1) * word_bits;
+        if constexpr (used_bits < word_bits) {
+            words[word_count - 1] &= (std::uint64_t{ 1 } << used_bits) - 1;
+        }
+    }
+
+    std::array<std::uint64_t, word_count> words{};
+
+    friend auto operator<=>(Bitboard const&, Bitboard const&) = default;
+};
+
+constexpr Bitboard operator|(Bitboard lhs, Bitboard const& rhs) { return lhs |= rhs; }
+constexpr Bitboard operator&(Bitboard lhs, Bitboard const& rhs) { return lhs &= rhs; }
+constexpr Bitboard operator^(Bitboard lhs, Bitboard const& rhs) { return lhs ^= rhs; }
+
+// ----------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr Bitboard create_column_mask(int column) {
+    Bitboard result;
+    for (int y = 0; y < board_size; ++y) {
+        result.set(to_square({ column, y }));
+    }
+    return result;
+}
+
+inline constexpr Bitboard not_first_column = ~create_column_mask(0);
+inline constexpr Bitboard not_last_column = ~create_column_mask(board_size - 1);
+
+}
+
+// Neighbour shifts, "east" is x + 1 and "north" is y + 1
+constexpr Bitboard shift_east(Bitboard const& board)  { return board.shift_up(1) & detail::not_first_column; }
+constexpr Bitboard shift_west(Bitboard const& board)  { return board.shift_down(1) & detail::not_last_column; }
+constexpr Bitboard shift_north(Bitboard const& board) { return board.shift_up(board_size); }
+constexpr Bitboard shift_south(Bitboard const& board) { return board.shift_down(board_size); }
+
+// Squares sharing an edge with the board, excluding the board itself
+constexpr Bitboard get_edge_neighbours(Bitboard const& board) {
+    auto const result = shift_east(board) | shift_west(board) | shift_north(board) | shift_south(board);
+    return result & ~board;
+}
+
+// Squares sharing only a corner with the board, excluding the board itself
+constexpr Bitboard get_corner_neighbours(Bitboard const& board) {
+    auto const east = shift_east(board);
+    auto const west = shift_west(board);
+    auto const result = shift_north(east) | shift_south(east) | shift_north(west) | shift_south(west);
+    return result & ~board;
+}
+
+// The board and every square sharing an edge or a corner with it.
+// Floods call it in loops, so the shifts are done word by word in two passes instead of six full shifts.
+constexpr Bitboard get_dilation(Bitboard const& board) {
+    constexpr int count = Bitboard::word_count;
+    constexpr int last = Bitboard::word_bits - 1;
+    constexpr int row_carry = Bitboard::word_bits - board_size;
+
+    Bitboard row;
+    for (int i = 0; i < count; ++i) {
+        auto const word = board.get_word(i);
+        auto const east = word << 1 | (i > 0 ? board.get_word(i - 1) >> last : 0);
+        auto const west = word >> 1 | (i + 1 < count ? board.get_word(i + 1) << last : 0);
+        row.set_word(i, word | (east & detail::not_first_column.get_word(i)) | (west & detail::not_last_column.get_word(i)));
+    }
+
+    Bitboard result;
+    for (int i = 0; i < count; ++i) {
+        auto const word = row.get_word(i);
+        auto const north = word << board_size | (i > 0 ? row.get_word(i - 1) >> row_carry : 0);
+        auto const south = word >> board_size | (i + 1 < count ? row.get_word(i + 1) << row_carry : 0);
+        result.set_word(i, word | north | south);
+    }
+    return result & Bitboard::full();
+}
+
+// Squares of the area connected to the seeds through edges or corners, without leaving the area
+constexpr Bitboard flood_fill(Bitboard const& seeds, Bitboard const& area) {
+    auto result = seeds & area;
+    while (true) {
+        auto const next = get_dilation(result) & area;
+        if (next == result) {
+            return result;
+        }
+        result = next;
+    }
+}
+
+}
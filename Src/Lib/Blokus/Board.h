@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+#include "PlayerId.h"
+#include "Position.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Blokus Game Board(400 squares), squares are indexed row by row: y * board_size + x
+constexpr int board_size = 20;
+constexpr int square_count = board_size * board_size;
+
+using Square = std::uint16_t;
+
+constexpr bool is_on_board(Position const& position) {
+    return
+        position.get_x() >= 0 && position.get_x() < board_size &&
+        position.get_y() >= 0 && position.get_y() < board_size;
+}
+
+constexpr Square to_square(Position const& position) {
+    return static_cast<Square>(position.get_y() * board_size + position.get_x());
+}
+
+constexpr Position to_position(Square square) {
+    return { square % board_size, square / board_size };
+}
+
+// Every color starts from its own board corner
+constexpr Position get_starting_position(PlayerId player) {
+    switch (player) {
+    case PlayerId::Red:    return { 0,              0 };
+    case PlayerId::Green:  return { board_size - 1, 0 };
+    case PlayerId::Blue:   return { board_size - 1, board_size - 1 };
+    case PlayerId::Yellow: return { 0,              board_size - 1 };
+    }
+    return { 0, 0 };
+}
+
+// The square as seen from the player: the board turned a quarter counter clockwise per color after
+// red, which brings the starting corner of the player to the red one
+constexpr Square to_player_frame(Square square, PlayerId player) {
+    auto x = square % board_size;
+    auto y = square / board_size;
+    for (std::size_t i = 0; i < to_index(player); ++i) {
+        auto const rotated_x = y;
+        y = board_size - 1 - x;
+        x = rotated_x;
+    }
+    return static_cast<Square>(y * board_size + x);
+}
+
+}
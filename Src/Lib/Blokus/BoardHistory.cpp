@@ -0,0 +1,235 @@
+#include "pch.h"
+#include "BoardHistory.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace blokus {
+
+namespace {
+
+// Bands start at multiples of 100 squares, not of the 64 bit words: the band bits are gathered
+// from one or two words
+std::uint64_t read_bits(Bitboard const& board, std::size_t start, std::size_t count) {
+    auto const word = start / Bitboard::word_bits;
+    auto const offset = start % Bitboard::word_bits;
+    auto value = board.get_word(static_cast<int>(word)) >> offset;
+    if (offset != 0 && word + 1 < Bitboard::word_count) {
+        value |= board.get_word(static_cast<int>(word + 1)) << (Bitboard::word_bits - offset);
+    }
+    return count == 64 ? value : value & ((std::uint64_t{ 1 } << count) - 1);
+}
+
+void write_bits(Bitboard& board, std::size_t start, std::uint64_t value) {
+    auto const word = start / Bitboard::word_bits;
+    auto const offset = start % Bitboard::word_bits;
+    board.set_word(static_cast<int>(word), board.get_word(static_cast<int>(word)) | value << offset);
+    if (offset != 0 && word + 1 < Bitboard::word_count) {
+        board.set_word(static_cast<int>(word + 1), board.get_word(static_cast<int>(word + 1)) | value >> (Bitboard::word_bits - offset));
+    }
+}
+
+constexpr std::size_t high_bits = BoardHistory::band_squares - 64;
+
+}
+
+// ----------------------------------------------------------------------------
+
+BoardHistory::BoardHistory(Game const& root)
+    : root_game(root)
+{
+    auto const root_players = root.get_players();
+    player_count = root_players.size();
+    std::copy(root_players.begin(), root_players.end(), players.begin());
+
+    Version version{
+        .chunks = {},
+        .remaining_pieces = {},
+        .parent = no_version,
+        .move = Move::pass(),
+        .ply = static_cast<std::uint16_t>(root.get_ply()),
+        .current_player = static_cast<std::uint8_t>(root.get_current_player_index()),
+        .finished_players = 0,
+        .monomino_placed_last = 0,
+    };
+
+    for (std::size_t band = 0; band < band_count; ++band) {
+        Chunk chunk{};
+        for (std::size_t player = 0; player < player_id_count; ++player) {
+            auto const& occupancy = root.get_occupancy(static_cast<PlayerId>(player));
+            chunk[player][0] = read_bits(occupancy, band * band_squares, 64);
+            chunk[player][1] = read_bits(occupancy, band * band_squares + 64, high_bits);
+        }
+        version.chunks[band] = static_cast<std::uint32_t>(chunks.size());
+        chunks.push_back(chunk);
+    }
+
+    for (std::size_t i = 0; i < player_count; ++i) {
+        auto const player = players[i];
+        version.remaining_pieces[to_index(player)] = root.get_remaining_pieces(player);
+        if (root.is_finished(player)) {
+            version.finished_players |= static_cast<std::uint8_t>(1 << to_index(player));
+        }
+    }
+    // The root history is gone from here, replay it once for the monomino bonus
+    for (std::size_t ply = 0; ply < root.get_ply(); ++ply) {
+        auto const move = root.get_move(ply);
+        if (!move.is_pass()) {
+            auto const bit = static_cast<std::uint8_t>(1 << to_index(root.get_move_player(ply)));
+            version.monomino_placed_last = static_cast<std::uint8_t>(get_piece(move) == PieceId::P1a
+                ? version.monomino_placed_last | bit
+                : version.monomino_placed_last & ~bit);
+        }
+    }
+
+    versions.push_back(version);
+}
+
+BoardVersion BoardHistory::apply(BoardVersion parent, Move move) {
+    assert(parent < versions.size());
+    assert(!get_view(parent).is_over());
+
+    auto version = versions[parent];
+    version.parent = parent;
+    version.move = move;
+    ++version.ply;
+
+    auto const player = players[version.current_player];
+    auto const bit = static_cast<std::uint8_t>(1 << to_index(player));
+    if (move.is_pass()) {
+        version.finished_players |= bit;
+    }
+    else {
+        auto const footprint = get_footprint(move);
+        assert((footprint & get_view(parent).get_forbidden(player)).none());
+
+        // Copy on write of the bands covered by the footprint, a piece spans at most two bands
+        for (std::size_t band = 0; band < band_count; ++band) {
+            auto const low = read_bits(footprint, band * band_squares, 64);
+            auto const high = read_bits(footprint, band * band_squares + 64, high_bits);
+            if ((low | high) == 0) {
+                continue;
+            }
+            auto chunk = chunks[version.chunks[band]];
+            chunk[to_index(player)][0] |= low;
+            chunk[to_index(player)][1] |= high;
+            version.chunks[band] = static_cast<std::uint32_t>(chunks.size());
+            chunks.push_back(chunk);
+        }
+
+        version.remaining_pieces[to_index(player)].erase(get_piece(move));
+        version.monomino_placed_last = static_cast<std::uint8_t>(get_piece(move) == PieceId::P1a
+            ? version.monomino_placed_last | bit
+            : version.monomino_placed_last & ~bit);
+    }
+    version.current_player = static_cast<std::uint8_t>(get_next_player(version));
+
+    versions.push_back(version);
+    return static_cast<BoardVersion>(versions.size() - 1);
+}
+
+std::size_t BoardHistory::get_next_player(Version const& version) const {
+    auto current = static_cast<std::size_t>(version.current_player);
+    // Same rule as Game: the turn goes to the next player not finished yet, if any
+    for (std::size_t i = 0; i < player_count; ++i) {
+        current = (current + 1) % player_count;
+        if (((version.finished_players >> to_index(players[current])) & 1) == 0) {
+            return current;
+        }
+    }
+    return version.current_player;
+}
+
+Game BoardHistory::get_game(BoardVersion version) const {
+    std::vector<Move> moves;
+    for (auto current = version; current != root_version; current = versions[current].parent) {
+        moves.push_back(versions[current].move);
+    }
+
+    auto game = root_game;
+    for (auto move = moves.rbegin(); move != moves.rend(); ++move) {
+        game.apply(*move);
+    }
+    return game;
+}
+
+std::size_t BoardHistory::get_memory_usage() const {
+    return versions.capacity() * sizeof(Version) + chunks.capacity() * sizeof(Chunk);
+}
+
+Bitboard BoardHistory::get_occupancy(Version const& version, PlayerId player) const {
+    Bitboard result;
+    for (std::size_t band = 0; band < band_count; ++band) {
+        auto const& words = chunks[version.chunks[band]][to_index(player)];
+        write_bits(result, band * band_squares, words[0]);
+        write_bits(result, band * band_squares + 64, words[1]);
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+PlayerId BoardView::get_current_player() const {
+    return history->players[history->versions[version].current_player];
+}
+
+Bitboard BoardView::get_occupancy(PlayerId player) const {
+    return history->get_occupancy(history->versions[version], player);
+}
+
+Bitboard BoardView::get_occupancy() const {
+    Bitboard result;
+    for (std::size_t i = 0; i < history->player_count; ++i) {
+        result |= get_occupancy(history->players[i]);
+    }
+    return result;
+}
+
+std::optional<PlayerId> BoardView::get_owner(Square square) const {
+    auto const band = square / BoardHistory::band_squares;
+    auto const offset = square % BoardHistory::band_squares;
+    auto const& chunk = history->chunks[history->versions[version].chunks[band]];
+    for (std::size_t player = 0; player < player_id_count; ++player) {
+        auto const word = chunk[player][offset / 64];
+        if ((word >> (offset % 64)) & 1) {
+            return static_cast<PlayerId>(player);
+        }
+    }
+    return std::nullopt;
+}
+
+Bitboard BoardView::get_forbidden(PlayerId player) const {
+    return blokus::get_forbidden(get_occupancy(player), get_occupancy());
+}
+
+Bitboard BoardView::get_anchors(PlayerId player) const {
+    return blokus::get_anchors(player, get_occupancy(player), get_occupancy());
+}
+
+PieceSet BoardView::get_remaining_pieces(PlayerId player) const {
+    return history->versions[version].remaining_pieces[to_index(player)];
+}
+
+bool BoardView::is_finished(PlayerId player) const {
+    return (history->versions[version].finished_players >> to_index(player)) & 1;
+}
+
+bool BoardView::is_over() const {
+    for (std::size_t i = 0; i < history->player_count; ++i) {
+        if (!is_finished(history->players[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int BoardView::get_score(PlayerId player) const {
+    auto const& current = history->versions[version];
+    return blokus::get_score(current.remaining_pieces[to_index(player)], (current.monomino_placed_last >> to_index(player)) & 1);
+}
+
+std::size_t BoardView::get_ply() const {
+    return history->versions[version].ply;
+}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Board.h"
+#include "Game.h"
+#include "Move.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+using BoardVersion = std::uint32_t;
+
+class BoardHistory;
+
+// Read only access to one version of a BoardHistory, every accessor is O(1)
+class BoardView {
+public:
+    BoardView(BoardHistory const& history, BoardVersion version) : history(&history), version(version) {}
+
+    BoardVersion get_version() const { return version; }
+
+    PlayerId get_current_player() const;
+    Bitboard get_occupancy(PlayerId player) const;
+    Bitboard get_occupancy() const;
+    // The player who covered the square, if any
+    std::optional<PlayerId> get_owner(Square square) const;
+
+    Bitboard get_forbidden(PlayerId player) const;
+    Bitboard get_anchors(PlayerId player) const;
+
+    PieceSet get_remaining_pieces(PlayerId player) const;
+    bool is_finished(PlayerId player) const;
+    bool is_over() const;
+    int get_score(PlayerId player) const;
+
+    std::size_t get_ply() const;
+
+private:
+    BoardHistory const* history;
+    BoardVersion version;
+};
+
+// ----------------------------------------------------------------------------
+
+// Persistent, structurally shared record of board states.
+// The board is cut in bands of five rows, 100 consecutive squares, stored as immutable chunks holding
+// the occupancy of every player. A version references one chunk per band, so a move only copies the
+// one or two bands it covers and every other chunk is shared with the parent version.
+// Versions form a tree: any version can be extended, which keeps the states of a whole search.
+class BoardHistory {
+public:
+    static constexpr std::size_t band_rows = 5;
+    static constexpr std::size_t band_squares = band_rows * board_size;
+    static constexpr std::size_t band_count = board_size / band_rows;
+
+    static constexpr BoardVersion root_version = 0;
+    static constexpr BoardVersion no_version = ~BoardVersion{ 0 };
+
+    explicit BoardHistory(Game const& root);
+
+    // The move must be legal in the parent version, see is_legal
+    BoardVersion apply(BoardVersion parent, Move move);
+
+    BoardView get_view(BoardVersion version) const { return { *this, version }; }
+
+    BoardVersion get_parent(BoardVersion version) const { return versions[version].parent; }
+    // The move leading from the parent to the version
+    Move get_move(BoardVersion version) const { return versions[version].move; }
+
+    // The root game with the moves of the version applied, O(ply)
+    Game get_game(BoardVersion version) const;
+
+    std::size_t get_version_count() const { return versions.size(); }
+    std::size_t get_chunk_count() const { return chunks.size(); }
+    // Bytes held by the versions and chunks
+    std::size_t get_memory_usage() const;
+
+private:
+    // Two words per player: the 64 first squares of the band and the 36 last ones
+    using Chunk = std::array<std::array<std::uint64_t, 2>, player_id_count>;
+
+    struct Version {
+        std::array<std::uint32_t, band_count> chunks;
+        std::array<PieceSet, player_id_count> remaining_pieces;
+        BoardVersion parent;
+        Move move;
+        std::uint16_t ply;
+        std::uint8_t current_player;
+        std::uint8_t finished_players;
+        // One bit per player whose last placed piece is the monomino
+        std::uint8_t monomino_placed_last;
+    };
+
+    Bitboard get_occupancy(Version const& version, PlayerId player) const;
+    std::size_t get_next_player(Version const& version) const;
+
+    Game root_game;
+    std::array<PlayerId, Game::max_player_count> players{};
+    std::size_t player_count{ 0 };
+    std::vector<Chunk> chunks;
+    std::vector<Version> versions;
+
+    friend class BoardView;
+};
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Lock free multi producer, multi consumer queue of fixed capacity (Dmitry Vyukov's design).
+// Each cell carries a sequence number telling whether it is ready to be written or read, so
+// producers and consumers only contend on their own position counter.
+template<class T>
+class BoundedQueue {
+public:
+    // The capacity is rounded up to a power of two
+    explicit BoundedQueue(std::size_t capacity)
+        : mask(std::bit_ceil(capacity < 2 ? std::size_t{ 2 } : capacity) - 1)
+        , cells(std::make_unique<Cell[]>(mask + 1))
+    {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(BoundedQueue const&) = delete;
+    BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+    // Fails when the queue is full, the value is left untouched then
+    bool try_push(T& value) {
+        auto position = push_position.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[position & mask];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (push_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = push_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> try_pop() {
+        auto position = pop_position.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells[position & mask];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0) {
+                if (pop_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    std::optional<T> value(std::move(cell.value));
+                    cell.sequence.store(position + mask + 1, std::memory_order_release);
+                    return value;
+                }
+            }
+            else if (difference < 0) {
+                return std::nullopt;
+            }
+            else {
+                position = pop_position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t get_capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // Keeps the producer and consumer counters on their own cache lines.
+    // Explicit padding rather than alignas, which warns (C4324) on every padded structure.
+    static constexpr std::size_t cache_line_size = 64;
+
+    std::size_t const mask;
+    std::unique_ptr<Cell[]> cells;
+    char push_padding[cache_line_size]{};
+    std::atomic<std::size_t> push_position{ 0 };
+    char pop_padding[cache_line_size - sizeof(std::atomic<std::size_t>)]{};
+    std::atomic<std::size_t> pop_position{ 0 };
+};
+
+}
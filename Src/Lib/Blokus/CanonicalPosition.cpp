@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "CanonicalPosition.h"
+
+#include "Move.h"
+
+namespace blokus {
+
+namespace {
+
+std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+constexpr std::size_t board_bytes = square_count / 8;
+
+}
+
+CanonicalPosition CanonicalPosition::from_game(Game const& game) {
+    auto const mover = game.get_current_player();
+
+    CanonicalPosition position;
+    for (auto const player : game.get_players()) {
+        auto const seat = get_seat(player, mover);
+        auto const bit = static_cast<std::uint8_t>(1 << seat);
+
+        game.get_occupancy(player).for_each([&position, seat, mover](Square square) {
+            position.occupancy[seat].set(to_player_frame(square, mover));
+        });
+        position.remaining_pieces[seat] = game.get_remaining_pieces(player);
+        position.seated_players |= bit;
+        if (game.is_finished(player)) {
+            position.finished_players |= bit;
+        }
+    }
+
+    // Only needed for the score of the players who placed every piece
+    for (auto const player : game.get_players()) {
+        if (!game.get_remaining_pieces(player).empty()) {
+            continue;
+        }
+        for (auto ply = game.get_ply(); ply-- > 0;) {
+            auto const move = game.get_move(ply);
+            if (game.get_move_player(ply) == player && !move.is_pass()) {
+                if (get_piece(move) == PieceId::P1a) {
+                    position.monomino_placed_last |= static_cast<std::uint8_t>(1 << get_seat(player, mover));
+                }
+                break;
+            }
+        }
+    }
+    return position;
+}
+
+std::uint64_t CanonicalPosition::get_hash() const {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+        for (int word = 0; word < Bitboard::word_count; ++word) {
+            hash = mix(hash ^ occupancy[seat].get_word(word)) + seat;
+        }
+        hash = mix(hash ^ remaining_pieces[seat].get_bits());
+    }
+    hash = mix(hash ^ (std::uint64_t{ seated_players } | std::uint64_t{ finished_players } << 8 | std::uint64_t{ monomino_placed_last } << 16));
+    return hash == 0 ? 1 : hash;
+}
+
+void CanonicalPosition::encode(std::vector<std::uint8_t>& output) const {
+    for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+        for (std::size_t byte = 0; byte < board_bytes; ++byte) {
+            auto const word = occupancy[seat].get_word(static_cast<int>(byte / 8));
+            output.push_back(static_cast<std::uint8_t>(word >> (byte % 8 * 8)));
+        }
+        auto const bits = remaining_pieces[seat].get_bits();
+        output.push_back(static_cast<std::uint8_t>(bits));
+        output.push_back(static_cast<std::uint8_t>(bits >> 8));
+        output.push_back(static_cast<std::uint8_t>(bits >> 16));
+    }
+    output.push_back(seated_players);
+    output.push_back(finished_players);
+    output.push_back(monomino_placed_last);
+}
+
+std::optional<CanonicalPosition> CanonicalPosition::decode(std::span<std::uint8_t const> input) {
+    if (input.size() < encoded_size) {
+        return std::nullopt;
+    }
+
+    CanonicalPosition position;
+    std::size_t offset = 0;
+    for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+        for (std::size_t byte = 0; byte < board_bytes; ++byte) {
+            auto const index = static_cast<int>(byte / 8);
+            auto const word = position.occupancy[seat].get_word(index) | std::uint64_t{ input[offset++] } << (byte % 8 * 8);
+            position.occupancy[seat].set_word(index, word);
+        }
+        auto const bits = input[offset] | input[offset + 1] << 8 | static_cast<std::uint32_t>(input[offset + 2]) << 16;
+        offset += 3;
+        if ((bits & ~PieceSet::all().get_bits()) != 0) {
+            return std::nullopt;
+        }
+        position.remaining_pieces[seat] = PieceSet::from_bits(bits);
+    }
+    position.seated_players = input[offset++];
+    position.finished_players = input[offset++];
+    position.monomino_placed_last = input[offset++];
+    return position;
+}
+
+}
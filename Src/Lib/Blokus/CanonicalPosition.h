@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Game.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// A position as seen from the player to move.
+// Rotating the board a quarter turn clockwise moves each corner to the corner of the next color, so
+// renaming the colors along with the rotation gives the same game with the turn order kept. The
+// canonical position is the rotation that puts the player to move in the red corner; its arrays are
+// indexed by seat, 0 being the player to move and the next seats following the turn order.
+// Mirror images are not merged: they reverse the turn order and are not the same game.
+struct CanonicalPosition {
+    static constexpr std::size_t encoded_size = player_id_count * (square_count / 8 + 3) + 3;
+
+    std::array<Bitboard, player_id_count> occupancy{};
+    std::array<PieceSet, player_id_count> remaining_pieces{};
+    // One bit per seat
+    std::uint8_t seated_players{ 0 };
+    std::uint8_t finished_players{ 0 };
+    std::uint8_t monomino_placed_last{ 0 };
+
+    static CanonicalPosition from_game(Game const& game);
+
+    // Never zero, so that zero can mark an empty slot
+    std::uint64_t get_hash() const;
+
+    // Fixed size encoding of encoded_size bytes
+    void encode(std::vector<std::uint8_t>& output) const;
+    static std::optional<CanonicalPosition> decode(std::span<std::uint8_t const> input);
+
+    friend bool operator==(CanonicalPosition const&, CanonicalPosition const&) = default;
+};
+
+// Seat of the player in the canonical position of a game where the mover is given
+constexpr std::size_t get_seat(PlayerId player, PlayerId mover) {
+    return (to_index(player) + player_id_count - to_index(mover)) % player_id_count;
+}
+
+}
@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "Compression.h"
+
+#include <array>
+#include <cstring>
+
+namespace blokus {
+
+namespace {
+
+constexpr std::size_t min_match = 4;
+constexpr std::size_t max_offset = 0xFFFF;
+constexpr unsigned hash_bits = 12;
+
+std::uint32_t read32(std::uint8_t const* data) {
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::uint32_t hash(std::uint32_t value) {
+    return (value * 2654435761u) >> (32 - hash_bits);
+}
+
+void write_length(std::vector<std::uint8_t>& output, std::size_t length) {
+    while (length >= 255) {
+        output.push_back(255);
+        length -= 255;
+    }
+    output.push_back(static_cast<std::uint8_t>(length));
+}
+
+void write_sequence(std::vector<std::uint8_t>& output, std::span<std::uint8_t const> literals, std::size_t offset, std::size_t match_length) {
+    auto const literal_nibble = literals.size() < 15 ? literals.size() : 15;
+    auto const match_nibble = match_length == 0 ? 0 : (match_length - min_match < 15 ? match_length - min_match : 15);
+    output.push_back(static_cast<std::uint8_t>(literal_nibble << 4 | match_nibble));
+    if (literal_nibble == 15) {
+        write_length(output, literals.size() - 15);
+    }
+    output.insert(output.end(), literals.begin(), literals.end());
+
+    if (match_length == 0) {
+        return;
+    }
+    output.push_back(static_cast<std::uint8_t>(offset));
+    output.push_back(static_cast<std::uint8_t>(offset >> 8));
+    if (match_nibble == 15) {
+        write_length(output, match_length - min_match - 15);
+    }
+}
+
+bool read_length(std::span<std::uint8_t const> input, std::size_t& position, std::size_t& length) {
+    while (true) {
+        if (position >= input.size()) {
+            return false;
+        }
+        auto const byte = input[position++];
+        length += byte;
+        if (byte != 255) {
+            return true;
+        }
+    }
+}
+
+}
+
+std::vector<std::uint8_t> lz_compress(std::span<std::uint8_t const> input) {
+    std::vector<std::uint8_t> output;
+    output.reserve(input.size() / 2 + 16);
+
+    // Most recent position of each hashed 4 byte sequence, plus one so that 0 means none
+    std::array<std::uint32_t, std::size_t{ 1 } << hash_bits> table{};
+
+    std::size_t literal_start = 0;
+    std::size_t position = 0;
+    while (position + min_match <= input.size()) {
+        auto const sequence = read32(&input[position]);
+        auto& slot = table[hash(sequence)];
+        auto const candidate = static_cast<std::size_t>(slot);
+        slot = static_cast<std::uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > max_offset || read32(&input[candidate - 1]) != sequence) {
+            ++position;
+            continue;
+        }
+
+        auto const match_start = candidate - 1;
+        auto length = min_match;
+        while (position + length < input.size() && input[match_start + length] == input[position + length]) {
+            ++length;
+        }
+
+        write_sequence(output, input.subspan(literal_start, position - literal_start), position - match_start, length);
+        position += length;
+        literal_start = position;
+    }
+
+    write_sequence(output, input.subspan(literal_start), 0, 0);
+    return output;
+}
+
+std::optional<std::vector<std::uint8_t>> lz_decompress(std::span<std::uint8_t const> input, std::size_t size) {
+    std::vector<std::uint8_t> output;
+    output.reserve(size);
+
+    std::size_t position = 0;
+    while (position < input.size()) {
+        auto const token = input[position++];
+
+        std::size_t literal_count = token >> 4;
+        if (literal_count == 15 && !read_length(input, position, literal_count)) {
+            return std::nullopt;
+        }
+        if (literal_count > input.size() - position || output.size() + literal_count > size) {
+            return std::nullopt;
+        }
+        output.insert(output.end(), input.begin() + position, input.begin() + position + literal_count);
+        position += literal_count;
+
+        // The last sequence has no match
+        if (position == input.size()) {
+            break;
+        }
+
+        if (input.size() - position < 2) {
+            return std::nullopt;
+        }
+        auto const offset = static_cast<std::size_t>(input[position]) | static_cast<std::size_t>(input[position + 1]) << 8;
+        position += 2;
+
+        std::size_t match_length = token & 0x0F;
+        if (match_length == 15 && !read_length(input, position, match_length)) {
+            return std::nullopt;
+        }
+        match_length += min_match;
+
+        if (offset == 0 || offset > output.size() || output.size() + match_length > size) {
+            return std::nullopt;
+        }
+        // Byte by byte, the match may overlap the bytes it produces
+        auto const start = output.size() - offset;
+        for (std::size_t i = 0; i < match_length; ++i) {
+            output.push_back(output[start + i]);
+        }
+    }
+
+    if (output.size() != size) {
+        return std::nullopt;
+    }
+    return output;
+}
+
+}
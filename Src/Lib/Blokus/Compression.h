@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Byte oriented LZ77 codec in the spirit of LZ4: fast on both ends, modest ratio.
+// A block is a sequence of (literals, match) pairs; each pair starts with a token byte holding the
+// literal count and the match length - 4 in its nibbles, 15 meaning more length bytes follow.
+// Matches reach back at most 64 KiB. The last pair has literals only.
+std::vector<std::uint8_t> lz_compress(std::span<std::uint8_t const> input);
+
+// Largest compressed size of size bytes, reached by input without any match
+constexpr std::size_t lz_compress_bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+// Nothing when the block is corrupted or doesn't decompress to exactly the expected size
+std::optional<std::vector<std::uint8_t>> lz_decompress(std::span<std::uint8_t const> input, std::size_t size);
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <utility>
+
+#include "Position.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+enum class CornerId { NW, NE, SE, SW };
+
+// ----------------------------------------------------------------------------
+
+class Corner {
+public:
+    constexpr Corner( Position position, CornerId cornerId)
+        : position(std::move(position))
+        , corner_id(cornerId)
+    {}
+
+    constexpr Position const& get_position() const { return position; }
+    constexpr CornerId get_corner_id() const { return corner_id; }
+
+private:
+    Position position;
+    CornerId corner_id;
+
+    friend auto operator<=>(Corner const&, Corner const&) = default;
+};
+
+}
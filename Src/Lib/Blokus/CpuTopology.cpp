@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "CpuTopology.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#endif
+
+namespace blokus {
+
+namespace {
+
+#ifdef _WIN32
+
+std::vector<std::vector<LogicalProcessor>> read_nodes() {
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationNumaNode, nullptr, &size);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return {};
+    }
+    std::vector<std::byte> buffer(size);
+    if (!GetLogicalProcessorInformationEx(RelationNumaNode, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &size)) {
+        return {};
+    }
+
+    std::vector<std::vector<LogicalProcessor>> nodes;
+    for (DWORD offset = 0; offset < size;) {
+        auto const& information = *reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX const*>(buffer.data() + offset);
+        offset += information.Size;
+        if (information.Relationship != RelationNumaNode) {
+            continue;
+        }
+        // A node spanning several processor groups only lists its first one here
+        auto const& affinity = information.NumaNode.GroupMask;
+        std::vector<LogicalProcessor> processors;
+        for (std::uint32_t number = 0; number < sizeof(KAFFINITY) * 8; ++number) {
+            if (((affinity.Mask >> number) & 1) != 0) {
+                processors.push_back({ affinity.Group, number });
+            }
+        }
+        if (!processors.empty()) {
+            nodes.push_back(std::move(processors));
+        }
+    }
+    return nodes;
+}
+
+#else
+
+// "0-3,8-11" as in /sys/devices/system/node/node<n>/cpulist
+std::vector<std::uint32_t> parse_cpu_list(std::string_view text) {
+    std::vector<std::uint32_t> cpus;
+    while (!text.empty()) {
+        auto const comma = text.find(',');
+        auto const range = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+        auto const dash = range.find('-');
+        std::uint32_t first = 0;
+        auto const first_text = range.substr(0, dash);
+        if (std::from_chars(first_text.data(), first_text.data() + first_text.size(), first).ec != std::errc()) {
+            return {};
+        }
+        auto last = first;
+        if (dash != std::string_view::npos) {
+            auto const last_text = range.substr(dash + 1);
+            if (std::from_chars(last_text.data(), last_text.data() + last_text.size(), last).ec != std::errc()) {
+                return {};
+            }
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::vector<std::vector<LogicalProcessor>> read_nodes() {
+    // The processors outside of the affinity of the process (taskset, containers) are left out
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    auto const has_affinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    std::vector<std::pair<std::uint32_t, std::vector<LogicalProcessor>>> numbered_nodes;
+    std::error_code error;
+    for (auto const& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        auto const name = entry.path().filename().string();
+        std::uint32_t node = 0;
+        if (!name.starts_with("node") || std::from_chars(name.data() + 4, name.data() + name.size(), node).ec != std::errc()) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string line;
+        std::getline(file, line);
+
+        std::vector<LogicalProcessor> processors;
+        for (auto const cpu : parse_cpu_list(line)) {
+            if (!has_affinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+                processors.push_back({ 0, cpu });
+            }
+        }
+        // Nodes of memory only have no processor
+        if (!processors.empty()) {
+            numbered_nodes.emplace_back(node, std::move(processors));
+        }
+    }
+
+    std::ranges::sort(numbered_nodes, {}, [](auto const& node) { return node.first; });
+    std::vector<std::vector<LogicalProcessor>> nodes;
+    for (auto& [node, processors] : numbered_nodes) {
+        nodes.push_back(std::move(processors));
+    }
+    return nodes;
+}
+
+#endif
+
+CpuTopology read_topology() {
+    CpuTopology topology;
+    topology.nodes = read_nodes();
+    if (topology.nodes.empty()) {
+        auto const count = std::max(std::thread::hardware_concurrency(), 1u);
+        auto& processors = topology.nodes.emplace_back();
+        for (std::uint32_t number = 0; number < count; ++number) {
+            processors.push_back({ 0, number });
+        }
+    }
+    return topology;
+}
+
+}
+
+std::size_t CpuTopology::get_processor_count() const {
+    std::size_t count = 0;
+    for (auto const& processors : nodes) {
+        count += processors.size();
+    }
+    return count;
+}
+
+CpuTopology const& get_cpu_topology() {
+    static CpuTopology const topology = read_topology();
+    return topology;
+}
+
+#ifdef _WIN32
+
+bool pin_current_thread(LogicalProcessor processor) {
+    GROUP_AFFINITY affinity{};
+    affinity.Group = processor.group;
+    affinity.Mask = KAFFINITY{ 1 } << processor.number;
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+}
+
+#else
+
+bool pin_current_thread(LogicalProcessor processor) {
+    if (processor.number >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(processor.number, &cpus);
+    // Zero is the calling thread
+    return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
+#endif
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Logical processor as the system numbers it. Windows numbers them within groups of at most 64.
+struct LogicalProcessor {
+    std::uint16_t group{ 0 };
+    std::uint32_t number{ 0 };
+};
+
+// Logical processors the process may run on, by NUMA node. A machine without NUMA, or whose
+// topology can't be read, is a single node of every hardware thread.
+struct CpuTopology {
+    std::vector<std::vector<LogicalProcessor>> nodes;
+
+    std::size_t get_processor_count() const;
+};
+
+CpuTopology const& get_cpu_topology();
+
+// Binds the calling thread to the processor, false when the system refuses
+bool pin_current_thread(LogicalProcessor processor);
+
+}
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "DagMcts.h"
+
+#include <atomic>
+#include <future>
+#include <vector>
+
+#include "Random.h"
+
+namespace blokus {
+
+DagMcts::DagMcts(DagMctsConfig config)
+    : config(config)
+    , graph(config.graph)
+{}
+
+DagMctsResult DagMcts::search(Game const& game, ThreadPool& pool, Deadline const& deadline, std::stop_token stop) {
+    auto const start = Deadline::Clock::now();
+    auto const thread_count = pool.get_thread_count();
+
+    // Each part of the table is cleared, and allocated on the first search, by a thread of the node
+    // it belongs to. The threads of a node race for its parts, reset() clears any part left over.
+    if (graph.get_partition_count() > 1) {
+        std::vector<std::future<void>> clears;
+        for (std::size_t task = 0; task < thread_count; ++task) {
+            clears.push_back(pool.submit([this, &pool] {
+                auto const node_count = pool.get_node_count();
+                for (auto partition = pool.get_node(*pool.get_current_worker()); partition < graph.get_partition_count(); partition += node_count) {
+                    graph.clear_partition(partition);
+                }
+            }));
+        }
+        for (auto& clear : clears) {
+            clear.get();
+        }
+    }
+    graph.reset(game, thread_count);
+    ++search_count;
+
+    std::atomic<std::uint32_t> next_iteration{ 0 };
+    std::atomic<std::uint32_t> completed{ 0 };
+    std::atomic<bool> deadline_reached{ false };
+    std::atomic<bool> cancelled{ false };
+
+    std::vector<std::future<void>> tasks;
+    for (std::size_t task = 0; task < thread_count; ++task) {
+        tasks.push_back(pool.submit([&] {
+            // The arena of a worker stays with its pool thread from one search to the next, so its
+            // blocks stay on the node that thread first touched them from
+            auto const worker = *pool.get_current_worker();
+            Random random(config.seed + search_count * 0x9E3779B97F4A7C15ull + worker);
+            while (next_iteration.fetch_add(1, std::memory_order_relaxed) < config.iterations) {
+                if (stop.stop_requested()) {
+                    cancelled = true;
+                    break;
+                }
+                if (deadline.has_expired()) {
+                    deadline_reached = true;
+                    break;
+                }
+                graph.run_iteration(worker, random, config.exploration);
+                completed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+
+    DagMctsResult result;
+    result.best_move = graph.get_best_move();
+    result.iterations = completed;
+    result.deadline_reached = deadline_reached;
+    result.cancelled = cancelled;
+    result.graph = graph.get_statistics();
+    result.arena = graph.get_arena_statistics();
+    result.elapsed = Deadline::Clock::now() - start;
+    return result;
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+
+#include "Arena.h"
+#include "Deadline.h"
+#include "Game.h"
+#include "Move.h"
+#include "SearchGraph.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct DagMctsConfig {
+    // Maximum number of iterations over all the threads, the search can also stop earlier on its deadline
+    std::uint32_t iterations{ 10000 };
+    float exploration{ 0.7f };
+    std::uint64_t seed{ 0 };
+    SearchGraphConfig graph{};
+};
+
+struct DagMctsResult {
+    Move best_move{ Move::pass() };
+    std::uint32_t iterations{ 0 };
+    bool deadline_reached{ false };
+    bool cancelled{ false };
+    std::chrono::nanoseconds elapsed{ 0 };
+    SearchGraphStatistics graph{};
+    ArenaStatistics arena{};
+};
+
+// ----------------------------------------------------------------------------
+
+// UCT search over the graph of positions, run by every thread of the pool at once.
+// Unlike Mcts the graph isn't kept between searches, a new search starts from an empty table.
+class DagMcts {
+public:
+    explicit DagMcts(DagMctsConfig config = {});
+
+    // The pool must not be busy with other tasks, the search takes one task per thread and
+    // the stop token and deadline are polled between iterations. With a pool of pinned threads and
+    // a table partition per NUMA node, the table is spread over the nodes and each thread creates
+    // its graph nodes in memory of its own node.
+    DagMctsResult search(Game const& game, ThreadPool& pool, Deadline const& deadline = Deadline::never(), std::stop_token stop = {});
+
+    DagMctsConfig const& get_config() const { return config; }
+
+private:
+    DagMctsConfig config;
+    SearchGraph graph;
+    // Keeps the playouts of successive searches apart
+    std::uint64_t search_count{ 0 };
+};
+
+}
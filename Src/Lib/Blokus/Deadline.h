@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Point in time on the monotonic clock after which a search must return its best move
+class Deadline {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Deadline never() { return Deadline{ Clock::time_point::max() }; }
+
+    template<class Rep, class Period>
+    static Deadline after(std::chrono::duration<Rep, Period> duration) {
+        return Deadline{ Clock::now() + std::chrono::duration_cast<Clock::duration>(duration) };
+    }
+
+    static Deadline at(Clock::time_point time) { return Deadline{ time }; }
+
+    bool is_never() const { return time == Clock::time_point::max(); }
+
+    bool has_expired() const {
+        return !is_never() && Clock::now() >= time;
+    }
+
+    Clock::duration get_remaining() const {
+        if (is_never()) {
+            return Clock::duration::max();
+        }
+        auto const remaining = time - Clock::now();
+        return remaining > Clock::duration::zero() ? remaining : Clock::duration::zero();
+    }
+
+    Clock::time_point get_time() const { return time; }
+
+private:
+    explicit Deadline(Clock::time_point time) : time(time) {}
+
+    Clock::time_point time;
+};
+
+}
@@ -0,0 +1,106 @@
+#include "pch.h"
+#include "Elo.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace blokus {
+
+namespace {
+
+constexpr double max_elo = 1000.0;
+
+// Per game variance of the score around its mean
+double get_score_variance(MatchScore const& score) {
+    auto const count = static_cast<double>(score.get_game_count());
+    auto const mean = score.get_score();
+    return (
+        score.wins * (1.0 - mean) * (1.0 - mean) +
+        score.draws * (0.5 - mean) * (0.5 - mean) +
+        score.losses * mean * mean) / count;
+}
+
+// Two sided normal quantile, found by bisection on erfc: precise enough and free of tables
+double get_normal_quantile(double confidence) {
+    auto low = 0.0;
+    auto high = 10.0;
+    auto const tail = 1.0 - confidence;
+    for (int i = 0; i < 100; ++i) {
+        auto const middle = (low + high) / 2.0;
+        if (std::erfc(middle / std::sqrt(2.0)) > tail) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return (low + high) / 2.0;
+}
+
+}
+
+double MatchScore::get_score() const {
+    auto const count = get_game_count();
+    if (count == 0) {
+        return 0.5;
+    }
+    return (wins + 0.5 * draws) / count;
+}
+
+double score_to_elo(double score) {
+    if (score <= 0.0) {
+        return -max_elo;
+    }
+    if (score >= 1.0) {
+        return max_elo;
+    }
+    return std::clamp(-400.0 * std::log10(1.0 / score - 1.0), -max_elo, max_elo);
+}
+
+double elo_to_score(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+EloEstimate estimate_elo(MatchScore const& score, double confidence) {
+    auto const count = score.get_game_count();
+    auto const mean = score.get_score();
+    if (count == 0) {
+        return { 0.0, -max_elo, max_elo };
+    }
+
+    auto const margin = get_normal_quantile(confidence) * std::sqrt(get_score_variance(score) / count);
+    return {
+        .elo = score_to_elo(mean),
+        .lower = score_to_elo(mean - margin),
+        .upper = score_to_elo(mean + margin),
+    };
+}
+
+SprtResult run_sprt(MatchScore const& score, SprtConfig const& config) {
+    SprtResult result{
+        .lower_bound = std::log(config.beta / (1.0 - config.alpha)),
+        .upper_bound = std::log((1.0 - config.beta) / config.alpha),
+    };
+
+    auto const count = score.get_game_count();
+    auto const variance = count == 0 ? 0.0 : get_score_variance(score);
+    // Not enough information before both a win and a loss or draw are seen
+    if (variance <= 0.0) {
+        return result;
+    }
+
+    auto const score0 = elo_to_score(config.elo0);
+    auto const score1 = elo_to_score(config.elo1);
+    auto const mean = score.get_score();
+    result.llr = 0.5 * count * (score1 - score0) * (2.0 * mean - score0 - score1) / variance;
+
+    if (result.llr >= result.upper_bound) {
+        result.status = SprtStatus::AcceptH1;
+    }
+    else if (result.llr <= result.lower_bound) {
+        result.status = SprtStatus::AcceptH0;
+    }
+    return result;
+}
+
+}
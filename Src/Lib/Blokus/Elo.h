@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Results of one engine against another
+struct MatchScore {
+    std::uint32_t wins{ 0 };
+    std::uint32_t draws{ 0 };
+    std::uint32_t losses{ 0 };
+
+    std::uint32_t get_game_count() const { return wins + draws + losses; }
+    // Points per game, a draw is half a point
+    double get_score() const;
+
+    friend bool operator==(MatchScore const&, MatchScore const&) = default;
+};
+
+struct EloEstimate {
+    double elo{ 0.0 };
+    // Confidence interval bounds
+    double lower{ 0.0 };
+    double upper{ 0.0 };
+};
+
+// Logistic Elo difference of the score, clamped to +/-1000 for perfect scores
+double score_to_elo(double score);
+double elo_to_score(double elo);
+
+// The interval comes from the normal approximation of the per game score variance
+EloEstimate estimate_elo(MatchScore const& score, double confidence = 0.95);
+
+// ----------------------------------------------------------------------------
+
+// Sequential probability ratio test of H0: elo = elo0 against H1: elo = elo1
+struct SprtConfig {
+    double elo0{ 0.0 };
+    double elo1{ 10.0 };
+    double alpha{ 0.05 };
+    double beta{ 0.05 };
+};
+
+enum class SprtStatus { Continue, AcceptH0, AcceptH1 };
+
+struct SprtResult {
+    // Log likelihood ratio, the test stops once it leaves the bounds
+    double llr{ 0.0 };
+    double lower_bound{ 0.0 };
+    double upper_bound{ 0.0 };
+    SprtStatus status{ SprtStatus::Continue };
+};
+
+// Generalized SPRT on the trinomial score distribution, with its usual normal approximation
+SprtResult run_sprt(MatchScore const& score, SprtConfig const& config);
+
+}
@@ -0,0 +1,269 @@
+#include "pch.h"
+#include "Endgame.h"
+
+#include <algorithm>
+#include <future>
+#include <unordered_set>
+#include <utility>
+
+#include "MoveGeneration.h"
+
+namespace blokus {
+
+namespace {
+
+Bitboard get_territory(Game const& game, PlayerId player) {
+    if (game.is_tracking_reachable()) {
+        return game.get_reachable(player);
+    }
+    return get_reachable(player, game.get_occupancy(player), game.get_occupancy());
+}
+
+// Squares of every subset of the pieces, the pieces being numbered by their position in the list
+std::vector<int> get_subset_squares(std::vector<PieceId> const& pieces) {
+    std::vector<int> result(std::size_t{ 1 } << pieces.size());
+    for (std::size_t subset = 1; subset < result.size(); ++subset) {
+        auto const piece = static_cast<std::size_t>(std::countr_zero(subset));
+        result[subset] = result[subset & (subset - 1)] + get_piece_size(pieces[piece]);
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+// Most squares one player can place in one area with each subset of its pieces
+struct RegionTable {
+    std::vector<int> best;
+    bool complete{ true };
+    std::uint64_t nodes{ 0 };
+};
+
+// One player placing its pieces one after the other in the area, the opponents never move.
+// Every set of pieces reached is feasible; the positions already visited are cached, since
+// placing the same pieces on the same squares in another order leads to the same position.
+class RegionSearch {
+public:
+    RegionSearch(PlayerId player, Bitboard const& own, Bitboard const& occupancy, Bitboard const& area,
+        std::vector<PieceId> const& pieces, std::uint64_t max_nodes)
+        : player(player)
+        , own(own)
+        , occupancy(occupancy)
+        , area(area)
+        , pieces(pieces)
+        , max_nodes(max_nodes)
+        , feasible(std::size_t{ 1 } << pieces.size())
+    {}
+
+    RegionTable run() {
+        RegionTable result;
+        visit({}, 0);
+        result.complete = complete;
+        result.nodes = visited.size();
+
+        // Best feasible subset within each subset, or only a bound when the search gave up
+        auto const squares = get_subset_squares(pieces);
+        auto const free_squares = (area & ~get_forbidden(own, occupancy)).count();
+        result.best.resize(feasible.size());
+        for (std::size_t subset = 0; subset < feasible.size(); ++subset) {
+            result.best[subset] = complete ? (feasible[subset] ? squares[subset] : 0) : std::min(squares[subset], free_squares);
+        }
+        for (std::size_t piece = 0; piece < pieces.size(); ++piece) {
+            auto const bit = std::size_t{ 1 } << piece;
+            for (std::size_t subset = 0; subset < feasible.size(); ++subset) {
+                if (subset & bit) {
+                    result.best[subset] = std::max(result.best[subset], result.best[subset ^ bit]);
+                }
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Key {
+        Bitboard placed;
+        std::uint32_t used;
+
+        friend bool operator==(Key const&, Key const&) = default;
+    };
+
+    struct KeyHash {
+        std::size_t operator()(Key const& key) const {
+            std::uint64_t hash = key.used * 0x9e3779b97f4a7c15ull;
+            for (int i = 0; i < Bitboard::word_count; ++i) {
+                hash = (hash ^ key.placed.get_word(i)) * 0xff51afd7ed558ccdull;
+                hash ^= hash >> 32;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    void visit(Bitboard const& placed, std::uint32_t used) {
+        if (visited.size() >= max_nodes) {
+            complete = false;
+            return;
+        }
+        if (!visited.insert({ placed, used }).second) {
+            return;
+        }
+        feasible[used] = true;
+
+        auto const own_now = own | placed;
+        auto const occupancy_now = occupancy | placed;
+        auto const blocked = get_forbidden(own_now, occupancy_now) | ~area;
+        auto const anchors = get_anchors(player, own_now, occupancy_now) & area;
+        anchors.for_each([&](Square anchor) {
+            auto const anchor_position = to_position(anchor);
+            for (std::size_t piece = 0; piece < pieces.size(); ++piece) {
+                if ((used >> piece) & 1) {
+                    continue;
+                }
+                auto const range = get_orientation_range(pieces[piece]);
+                for (auto index = range.first; index < range.last; ++index) {
+                    auto const& orientation = get_orientation(index);
+                    for (int i = 0; i < orientation.size; ++i) {
+                        Square origin;
+                        if (!get_origin(orientation, orientation.squares[i], anchor_position, origin)) {
+                            continue;
+                        }
+                        // A placement covering several anchors is only tried from the first of them
+                        Bitboard footprint;
+                        auto placeable = true;
+                        for (int j = 0; j < orientation.size && placeable; ++j) {
+                            auto const square = static_cast<Square>(origin + orientation.squares[j].y * board_size + orientation.squares[j].x);
+                            placeable = !blocked.test(square) && !(square < anchor && anchors.test(square));
+                            footprint.set(square);
+                        }
+                        if (placeable) {
+                            visit(placed | footprint, used | std::uint32_t{ 1 } << piece);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    PlayerId player;
+    Bitboard own;
+    Bitboard occupancy;
+    Bitboard area;
+    std::vector<PieceId> pieces;
+    std::uint64_t max_nodes;
+
+    std::unordered_set<Key, KeyHash> visited;
+    std::vector<bool> feasible;
+    bool complete{ true };
+};
+
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<Region> find_regions(Game const& game) {
+    auto const players = game.get_players();
+    std::array<Bitboard, Game::max_player_count> territories{};
+    Bitboard pending;
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        if (!game.is_finished(players[i])) {
+            territories[i] = get_territory(game, players[i]);
+            pending |= territories[i];
+        }
+    }
+
+    std::vector<Region> result;
+    while (pending.any()) {
+        auto& region = result.emplace_back();
+        region.squares = flood_fill(Bitboard::from_square(pending.lowest()), pending);
+        for (std::size_t i = 0; i < players.size(); ++i) {
+            if ((territories[i] & region.squares).any()) {
+                region.players |= static_cast<std::uint8_t>(1 << i);
+            }
+        }
+        pending ^= region.squares;
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+
+EndgameResult solve_endgame(Game const& game, ThreadPool& pool, EndgameConfig const& config) {
+    EndgameResult result;
+    result.regions = find_regions(game);
+
+    struct PlayerSearch {
+        std::vector<PieceId> pieces;
+        std::vector<std::future<RegionTable>> tables;
+    };
+    auto const players = game.get_players();
+    std::array<PlayerSearch, Game::max_player_count> searches;
+
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        auto const player = players[i];
+        auto const remaining = game.get_remaining_pieces(player);
+        result.exact[i] = true;
+        if (game.is_finished(player)) {
+            continue;
+        }
+        if (static_cast<std::size_t>(remaining.count()) > config.max_pieces) {
+            result.max_squares[i] = std::min(remaining.get_square_count(), get_territory(game, player).count());
+            result.exact[i] = false;
+            continue;
+        }
+
+        auto& search = searches[i];
+        for (std::size_t piece = 0; piece < piece_count; ++piece) {
+            if (remaining.contains(static_cast<PieceId>(piece))) {
+                search.pieces.push_back(static_cast<PieceId>(piece));
+            }
+        }
+
+        std::vector<Bitboard> areas;
+        for (auto const& region : result.regions) {
+            if ((region.players >> i) & 1) {
+                result.exact[i] = result.exact[i] && region.is_private();
+                if (config.decompose || areas.empty()) {
+                    areas.push_back(region.squares);
+                }
+                else {
+                    areas.back() |= region.squares;
+                }
+            }
+        }
+        for (auto const& area : areas) {
+            search.tables.push_back(pool.submit([player, area, pieces = search.pieces, &game, &config] {
+                return RegionSearch(player, game.get_occupancy(player), game.get_occupancy(), area, pieces, config.max_region_nodes).run();
+            }));
+        }
+    }
+
+    // The pieces of a player split between its regions, each region taking its best with its share
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        auto& search = searches[i];
+        if (search.tables.empty()) {
+            continue;
+        }
+        std::vector<int> combined;
+        for (auto& future : search.tables) {
+            auto const table = future.get();
+            result.exact[i] = result.exact[i] && table.complete;
+            result.nodes += table.nodes;
+            if (combined.empty()) {
+                combined = table.best;
+                continue;
+            }
+            auto const previous = combined;
+            for (std::size_t subset = 0; subset < combined.size(); ++subset) {
+                // Every share of the subset going to the new region, the empty one included
+                for (auto share = subset;; share = (share - 1) & subset) {
+                    combined[subset] = std::max(combined[subset], table.best[share] + previous[subset ^ share]);
+                    if (share == 0) {
+                        break;
+                    }
+                }
+            }
+        }
+        result.max_squares[i] = combined.back();
+    }
+    return result;
+}
+
+}
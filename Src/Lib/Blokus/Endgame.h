@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Game.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Part of the board no placement can cross. The free squares around it belong to nobody's territory,
+// so a piece placed in one region never changes what can be placed in another.
+struct Region {
+    Bitboard squares;
+    // One bit per player index in Game::get_players(), the unfinished players whose territory it is
+    std::uint8_t players{ 0 };
+
+    bool is_private() const { return std::popcount(players) == 1; }
+};
+
+// Connected parts of the territories of the unfinished players, by lowest square
+std::vector<Region> find_regions(Game const& game);
+
+// ----------------------------------------------------------------------------
+
+struct EndgameConfig {
+    // Players with more pieces left are only bounded, each subset of them gets a table entry
+    std::size_t max_pieces{ 12 };
+    // Positions visited in one region before giving up on it and only bounding it
+    std::uint64_t max_region_nodes{ 1 << 16 };
+    // Solve the union of the regions of each player as a single one, to measure the decomposition
+    bool decompose{ true };
+};
+
+struct EndgameResult {
+    std::vector<Region> regions;
+    // Indexed by the player position in Game::get_players(): the most squares the player can still
+    // place, ignoring the opponents. Exact when all its regions are private and fully searched,
+    // as nobody can take their squares away; an upper bound otherwise.
+    std::array<int, Game::max_player_count> max_squares{};
+    std::array<bool, Game::max_player_count> exact{};
+    std::uint64_t nodes{ 0 };
+};
+
+// Every (player, region) pair is searched as its own subproblem on the pool, with its own cache of the
+// positions already visited. A search only finds which sets of pieces fit in the region, one player
+// placing one piece after the other: the orders in which the pieces go to the different regions never
+// have to be tried, the tables of the regions are combined afterwards by splitting the pieces between them.
+EndgameResult solve_endgame(Game const& game, ThreadPool& pool, EndgameConfig const& config = {});
+
+}
@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "Engine.h"
+
+#include <cassert>
+#include <utility>
+
+#include "MoveGeneration.h"
+
+namespace blokus {
+
+Engine::Engine(EngineConfig config)
+    : config(config)
+    , time_manager(config.time)
+    , pool(config.pool)
+{
+    // Nothing is submitted yet, the workers don't look at their slots before the constructor returns
+    searches.resize(pool.get_thread_count());
+}
+
+Engine::~Engine() {
+    // The pool still runs the queued searches while joining, they return right away
+    shutdown.request_stop();
+}
+
+SearchHandle Engine::submit(SearchRequest request) {
+    std::stop_source stop;
+    ++pending;
+    auto const priority = request.priority;
+    auto future = pool.submit([this, request = std::move(request), token = stop.get_token()] {
+        auto result = run(request, token);
+        --pending;
+        return result;
+    }, priority);
+    return { std::move(future), std::move(stop) };
+}
+
+void Engine::submit(SearchRequest request, std::stop_token stop, Callback callback) {
+    ++pending;
+    auto const priority = request.priority;
+    pool.submit([this, request = std::move(request), stop = std::move(stop), callback = std::move(callback)] {
+        auto result = run(request, stop);
+        --pending;
+        callback(std::move(result));
+    }, priority);
+}
+
+MctsResult Engine::run(SearchRequest const& request, std::stop_token stop) {
+    // Either the caller or the engine shutdown stops the search
+    std::stop_source search_stop;
+    std::stop_callback const on_cancel(stop, [&search_stop] { search_stop.request_stop(); });
+    std::stop_callback const on_shutdown(shutdown.get_token(), [&search_stop] { search_stop.request_stop(); });
+
+    auto const worker = pool.get_current_worker();
+    assert(worker);
+    auto& mcts = searches[*worker];
+    if (!mcts) {
+        auto mcts_config = config.mcts;
+        mcts_config.seed += *worker;
+        mcts = std::make_unique<Mcts>(mcts_config);
+    }
+    auto const iterations = request.iterations != 0 ? request.iterations : config.mcts.iterations;
+    if (!request.time_control) {
+        return mcts->search(request.game, iterations, request.deadline, search_stop.get_token());
+    }
+
+    // The time manager doesn't change while the engine runs, only its statistics need the lock
+    MoveList moves;
+    generate_moves(request.game, moves);
+    auto const budget = time_manager.allot(request.game, *request.time_control, moves.size());
+    auto deadline = Deadline::after(budget);
+    if (request.deadline.get_time() < deadline.get_time()) {
+        deadline = request.deadline;
+    }
+    auto result = mcts->search(request.game, iterations, deadline, search_stop.get_token());
+    {
+        std::scoped_lock lock(time_mutex);
+        time_manager.record(budget, result.elapsed);
+    }
+    return result;
+}
+
+OverrunStatistics Engine::get_time_statistics() const {
+    std::scoped_lock lock(time_mutex);
+    return time_manager.get_statistics();
+}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+#include "Deadline.h"
+#include "Game.h"
+#include "Mcts.h"
+#include "ThreadPool.h"
+#include "TimeManager.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct EngineConfig {
+    // Its thread count bounds the number of searches running at once, whatever the number of games
+    // served. With pinned threads, the search memory of each worker stays on its NUMA node.
+    ThreadPoolConfig pool{ .thread_count = 4 };
+    // Every worker search shares this configuration, its seed is offset per search instance
+    MctsConfig mcts{};
+    TimeManagerConfig time{};
+};
+
+struct SearchRequest {
+    Game game;
+    // Zero uses the iterations of the engine configuration
+    std::uint32_t iterations{ 0 };
+    Deadline deadline{ Deadline::never() };
+    // With a clock, the time manager of the engine budgets the move and the deadline becomes the
+    // earlier of the two
+    std::optional<TimeControl> time_control{};
+    TaskPriority priority{ TaskPriority::Normal };
+};
+
+// ----------------------------------------------------------------------------
+
+// Result of a submitted search, cancelling makes the search return its best move so far
+class SearchHandle {
+public:
+    SearchHandle(std::future<MctsResult> future, std::stop_source stop)
+        : future(std::move(future))
+        , stop(std::move(stop))
+    {}
+
+    void cancel() { stop.request_stop(); }
+
+    bool is_ready() const {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    MctsResult get() { return future.get(); }
+
+    std::future<MctsResult>& get_future() { return future; }
+
+private:
+    std::future<MctsResult> future;
+    std::stop_source stop;
+};
+
+// ----------------------------------------------------------------------------
+
+// Runs the searches of many games on a bounded thread pool.
+// Searches are queued by priority; each pool worker searches with its own Mcts instance, created on
+// the worker's thread by its first search, so that its tree arena is recycled between requests and
+// allocated on the worker's node. The tree is reused when a request continues the game searched last
+// by that worker, which is the common case when a single game is served by a single thread.
+class Engine {
+public:
+    using Callback = std::function<void(MctsResult)>;
+
+    explicit Engine(EngineConfig config = {});
+    // Cancels every search, queued or running
+    ~Engine();
+
+    Engine(Engine const&) = delete;
+    Engine& operator=(Engine const&) = delete;
+
+    SearchHandle submit(SearchRequest request);
+
+    // The callback is invoked on a worker thread, it is meant to hand the result over to an event loop
+    void submit(SearchRequest request, std::stop_token stop, Callback callback);
+
+    // Searches queued or running
+    std::size_t get_pending_count() const { return pending.load(); }
+
+    std::size_t get_thread_count() const { return pool.get_thread_count(); }
+
+    // How far the searches with a clock went over their budget
+    OverrunStatistics get_time_statistics() const;
+
+private:
+    MctsResult run(SearchRequest const& request, std::stop_token stop);
+
+    EngineConfig config;
+    // By pool worker, each one only touched by its worker's thread
+    std::vector<std::unique_ptr<Mcts>> searches;
+    std::atomic<std::size_t> pending{ 0 };
+    std::stop_source shutdown;
+    mutable std::mutex time_mutex;
+    TimeManager time_manager;
+    // Declared last, its destructor drains the queue while the rest of the engine is alive
+    ThreadPool pool;
+};
+
+}
@@ -0,0 +1,38 @@
+#include "pch.h"
+#include "Evaluation.h"
+
+namespace blokus {
+
+Rewards get_rewards(Game const& game) {
+    auto const players = game.get_players();
+
+    std::array<int, Game::max_player_count> scores{};
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        scores[i] = game.get_score(players[i]);
+    }
+
+    Rewards rewards{};
+    if (players.size() < 2) {
+        rewards[0] = 1.0f;
+        return rewards;
+    }
+
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        float beaten = 0.0f;
+        for (std::size_t j = 0; j < players.size(); ++j) {
+            if (i == j) {
+                continue;
+            }
+            if (scores[i] > scores[j]) {
+                beaten += 1.0f;
+            }
+            else if (scores[i] == scores[j]) {
+                beaten += 0.5f;
+            }
+        }
+        rewards[i] = beaten / static_cast<float>(players.size() - 1);
+    }
+    return rewards;
+}
+
+}
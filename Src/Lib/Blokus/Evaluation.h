@@ -0,0 +1,19 @@
+#pragma once
+
+#include <array>
+
+#include "Game.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Indexed by the player position in Game::get_players()
+using Rewards = std::array<float, Game::max_player_count>;
+
+// Fraction of the other players beaten, ties count as half a win
+Rewards get_rewards(Game const& game);
+
+}
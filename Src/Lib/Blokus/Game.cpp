@@ -0,0 +1,244 @@
+#include "pch.h"
+#include "Game.h"
+
+#include <cassert>
+#include <utility>
+
+namespace blokus {
+
+namespace {
+
+// Grows the piece of the area around the seed until it contains an anchor, true when it does
+bool reaches_anchor(Bitboard& piece, Bitboard const& area, Bitboard const& anchors) {
+    while ((piece & anchors).none()) {
+        auto const next = get_dilation(piece) & area;
+        if (next == piece) {
+            return false;
+        }
+        piece = next;
+    }
+    return true;
+}
+
+}
+
+Bitboard get_forbidden(Bitboard const& own, Bitboard const& occupancy) {
+    return occupancy | get_edge_neighbours(own);
+}
+
+Bitboard get_anchors(PlayerId player, Bitboard const& own, Bitboard const& occupancy) {
+    if (own.none()) {
+        auto const start = to_square(get_starting_position(player));
+        return occupancy.test(start) ? Bitboard{} : Bitboard::from_square(start);
+    }
+    return get_corner_neighbours(own) & ~get_forbidden(own, occupancy);
+}
+
+Bitboard get_reachable(PlayerId player, Bitboard const& own, Bitboard const& occupancy) {
+    return flood_fill(get_anchors(player, own, occupancy), ~get_forbidden(own, occupancy));
+}
+
+int get_score(PieceSet remaining, bool monomino_placed_last) {
+    if (!remaining.empty()) {
+        return -remaining.get_square_count();
+    }
+    return monomino_placed_last ? 20 : 15;
+}
+
+// ----------------------------------------------------------------------------
+
+Game Game::CreateNew(std::vector<PlayerId> players) {
+    return { players };
+}
+
+Game::Game(std::vector<PlayerId> const& players) {
+    assert(!players.empty() && players.size() <= max_player_count);
+    player_count = players.size();
+    for (std::size_t i = 0; i < player_count; ++i) {
+        this->players[i] = players[i];
+        remaining_pieces[to_index(players[i])] = PieceSet::all();
+    }
+}
+
+std::vector<Move> Game::get_pieces_on_board() const {
+    std::vector<Move> result;
+    for (std::size_t ply = 0; ply < ply_count; ++ply) {
+        if (!history[ply].move.is_pass()) {
+            result.push_back(history[ply].move);
+        }
+    }
+    return result;
+}
+
+Bitboard Game::get_forbidden(PlayerId player) const {
+    return blokus::get_forbidden(occupancy[to_index(player)], all_occupancy);
+}
+
+Bitboard Game::get_anchors(PlayerId player) const {
+    return blokus::get_anchors(player, occupancy[to_index(player)], all_occupancy);
+}
+
+bool Game::is_over() const {
+    for (std::size_t i = 0; i < player_count; ++i) {
+        if (!is_finished(players[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int Game::get_score(PlayerId player) const {
+    auto monomino_placed_last = false;
+    for (auto ply = ply_count; ply-- > 0;) {
+        auto const& record = history[ply];
+        if (players[record.player_index] == player && !record.move.is_pass()) {
+            monomino_placed_last = get_piece(record.move) == PieceId::P1a;
+            break;
+        }
+    }
+    return blokus::get_score(remaining_pieces[to_index(player)], monomino_placed_last);
+}
+
+void Game::track_reachable() {
+    if (tracking_reachable) {
+        return;
+    }
+    tracking_reachable = true;
+    for (std::size_t i = 0; i < player_count; ++i) {
+        auto const player = players[i];
+        reachable[to_index(player)] = blokus::get_reachable(player, occupancy[to_index(player)], all_occupancy);
+    }
+}
+
+void Game::apply(Move const& move) {
+    assert(!is_over());
+    assert(ply_count < max_ply_count);
+
+    auto const player = get_current_player();
+    history[ply_count++] = { move, static_cast<std::uint8_t>(current_player) };
+
+    if (move.is_pass()) {
+        finished_players |= static_cast<std::uint8_t>(1 << to_index(player));
+    }
+    else {
+        auto const footprint = get_footprint(move);
+        assert((footprint & get_forbidden(player)).none());
+        occupancy[to_index(player)] |= footprint;
+        all_occupancy |= footprint;
+        remaining_pieces[to_index(player)].erase(get_piece(move));
+        if (tracking_reachable) {
+            shrink_reachable(player, footprint);
+        }
+    }
+
+    advance_current_player();
+}
+
+void Game::undo() {
+    assert(ply_count > 0);
+
+    // Cleared so that stale history doesn't take part in the comparison of games
+    auto const record = std::exchange(history[--ply_count], {});
+    current_player = record.player_index;
+    auto const player = get_current_player();
+
+    if (record.move.is_pass()) {
+        finished_players &= static_cast<std::uint8_t>(~(1 << to_index(player)));
+    }
+    else {
+        auto const footprint = get_footprint(record.move);
+        occupancy[to_index(player)] ^= footprint;
+        all_occupancy ^= footprint;
+        remaining_pieces[to_index(player)].insert(get_piece(record.move));
+        if (tracking_reachable) {
+            grow_reachable(player, footprint);
+        }
+    }
+}
+
+// A placement only takes squares away from the territories: what is left stays, except the pieces
+// cut off from every anchor. Usually it stays in one piece around the footprint, which a flood limited
+// to the squares near it shows, and keeps an anchor: the mover gets new ones along the footprint, the
+// others keep theirs unless the footprint covers one. Otherwise each piece touching the footprint grows
+// until it finds an anchor, pockets without any close off quickly and are dropped.
+void Game::shrink_reachable(PlayerId mover, Bitboard const& footprint) {
+    auto const mover_blocked = footprint | get_edge_neighbours(footprint);
+    auto const footprint_corners = get_corner_neighbours(footprint);
+    auto const footprint_area = get_dilation(footprint);
+    for (std::size_t i = 0; i < player_count; ++i) {
+        auto const player = players[i];
+        auto& territory = reachable[to_index(player)];
+        auto const removed = territory & (player == mover ? mover_blocked : footprint);
+        if (removed.none()) {
+            continue;
+        }
+        territory ^= removed;
+
+        auto const removed_area = get_dilation(removed);
+        auto border = removed_area & territory;
+        if (border.none()) {
+            continue;
+        }
+        auto const nearby = get_dilation(removed_area) & territory;
+        auto const around = flood_fill(Bitboard::from_square(border.lowest()), nearby);
+        if ((border & ~around).none()) {
+            if (player == mover ? (around & footprint_corners).any()
+                : !covers_anchor(player, footprint, footprint_area, all_occupancy ^ footprint)) {
+                continue;
+            }
+        }
+
+        auto const anchors = get_anchors(player);
+        while (border.any()) {
+            auto piece = Bitboard::from_square(border.lowest());
+            if (!reaches_anchor(piece, territory, anchors)) {
+                territory ^= piece;
+            }
+            border &= ~piece;
+        }
+    }
+}
+
+// Removing a placement only gives squares back: the old territory seeds the flood, which only has to
+// spread over what the footprint freed. The others keep their territory when it doesn't touch the
+// footprint and the footprint covered none of their anchors.
+void Game::grow_reachable(PlayerId mover, Bitboard const& footprint) {
+    auto const footprint_area = get_dilation(footprint);
+    for (std::size_t i = 0; i < player_count; ++i) {
+        auto const player = players[i];
+        auto& territory = reachable[to_index(player)];
+        if (player == mover) {
+            territory = flood_fill(territory | get_anchors(player), ~get_forbidden(player));
+            continue;
+        }
+        auto const regained = covers_anchor(player, footprint, footprint_area, all_occupancy);
+        if (!regained && (footprint_area & territory).none()) {
+            continue;
+        }
+        auto const seeds = regained ? territory | (get_anchors(player) & footprint) : territory;
+        territory = flood_fill(seeds, ~get_forbidden(player));
+    }
+}
+
+// Whether the footprint covers an anchor of a player other than its owner, the occupancy without it.
+// The anchors are only worked out when a piece of the player is close enough to the footprint.
+bool Game::covers_anchor(PlayerId player, Bitboard const& footprint, Bitboard const& footprint_area,
+    Bitboard const& free_occupancy) const
+{
+    auto const& own = occupancy[to_index(player)];
+    if (own.none()) {
+        return footprint.test(to_square(get_starting_position(player)));
+    }
+    return (footprint_area & own).any() && (blokus::get_anchors(player, own, free_occupancy) & footprint).any();
+}
+
+void Game::advance_current_player() {
+    if (is_over()) {
+        return;
+    }
+    do {
+        current_player = (current_player + 1) % player_count;
+    } while (is_finished(get_current_player()));
+}
+
+}
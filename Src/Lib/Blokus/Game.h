@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Move.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Rules shared by the board representations
+
+// Squares where a player can't place a square: occupied or sharing an edge with its own pieces
+Bitboard get_forbidden(Bitboard const& own, Bitboard const& occupancy);
+
+// Free squares where the next piece of a player must place one of its squares
+Bitboard get_anchors(PlayerId player, Bitboard const& own, Bitboard const& occupancy);
+
+// Free squares the player could still cover whatever pieces it has left: connected to its anchors
+// through edges or corners, without crossing a square it is forbidden
+Bitboard get_reachable(PlayerId player, Bitboard const& own, Bitboard const& occupancy);
+
+// Minus one per square left, +15 when all the pieces are placed, +5 more when the monomino is placed last
+int get_score(PieceSet remaining, bool monomino_placed_last);
+
+// ----------------------------------------------------------------------------
+
+// Full game state, apply/undo a move at a time.
+// Everything is stored in fixed size arrays so that copying a game never allocates.
+class Game {
+public:
+    static constexpr std::size_t max_player_count = player_id_count;
+    // Every player places all its pieces and then passes once
+    static constexpr std::size_t max_ply_count = max_player_count * (piece_count + 1);
+
+    static Game CreateNew(std::vector<PlayerId> players);
+
+    std::vector<Move> get_pieces_on_board() const;
+
+    PlayerId get_current_player() const {
+        return players[current_player];
+    }
+
+    std::span<PlayerId const> get_players() const {
+        return { players.data(), player_count };
+    }
+
+    std::size_t get_current_player_index() const { return current_player; }
+
+    Bitboard const& get_occupancy(PlayerId player) const { return occupancy[to_index(player)]; }
+    Bitboard const& get_occupancy() const { return all_occupancy; }
+
+    // Squares where the player can't place a square: occupied or sharing an edge with its own pieces
+    Bitboard get_forbidden(PlayerId player) const;
+
+    // Free squares where the next piece of the player must place one of its squares
+    Bitboard get_anchors(PlayerId player) const;
+
+    // The territories are only kept once asked for, from then on apply/undo update them instead of
+    // flooding the whole board, copies of the game included
+    void track_reachable();
+    bool is_tracking_reachable() const { return tracking_reachable; }
+
+    // Same as blokus::get_reachable, the game must be tracking them
+    Bitboard const& get_reachable(PlayerId player) const {
+        assert(tracking_reachable);
+        return reachable[to_index(player)];
+    }
+
+    PieceSet get_remaining_pieces(PlayerId player) const { return remaining_pieces[to_index(player)]; }
+
+    // A player is finished once it passed, it has no more legal moves
+    bool is_finished(PlayerId player) const { return (finished_players >> to_index(player)) & 1; }
+    bool is_over() const;
+
+    // Minus one per square left, +15 when all the pieces are placed, +5 more when the monomino is placed last
+    int get_score(PlayerId player) const;
+
+    std::size_t get_ply() const { return ply_count; }
+    Move get_move(std::size_t ply) const { return history[ply].move; }
+    PlayerId get_move_player(std::size_t ply) const { return players[history[ply].player_index]; }
+
+    // The move must be legal, see is_legal
+    void apply(Move const& move);
+    void undo();
+
+private:
+    Game(std::vector<PlayerId> const& players);
+
+    void advance_current_player();
+    void shrink_reachable(PlayerId mover, Bitboard const& footprint);
+    void grow_reachable(PlayerId mover, Bitboard const& footprint);
+    bool covers_anchor(PlayerId player, Bitboard const& footprint, Bitboard const& footprint_area,
+        Bitboard const& free_occupancy) const;
+
+    struct PlyRecord {
+        Move move;
+        std::uint8_t player_index;
+
+        friend auto operator<=>(PlyRecord const&, PlyRecord const&) = default;
+    };
+
+    std::array<PlayerId, max_player_count> players{};
+    std::size_t player_count{ 0 };
+    std::size_t current_player{ 0 };
+
+    std::array<Bitboard, player_id_count> occupancy{};
+    Bitboard all_occupancy;
+    std::array<Bitboard, player_id_count> reachable{};
+    bool tracking_reachable{ false };
+    std::array<PieceSet, player_id_count> remaining_pieces{};
+    std::uint8_t finished_players{ 0 };
+
+    std::array<PlyRecord, max_ply_count> history{};
+    std::size_t ply_count{ 0 };
+
+    friend auto operator<=>(Game const&, Game const&) = default;
+};
+
+}
@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "GameClient.h"
+
+#include <array>
+#include <charconv>
+#include <stdexcept>
+
+#include "Protocol.h"
+
+namespace blokus {
+
+GameClient::GameClient(std::string const& host, std::uint16_t port)
+    : socket(Socket::connect_tcp(host, port))
+{}
+
+void GameClient::send(std::string_view line) {
+    std::string data(line);
+    data += '\n';
+    std::string_view remaining = data;
+    while (!remaining.empty()) {
+        auto const result = socket.send(remaining);
+        if (result.status != IoStatus::Done) {
+            throw std::runtime_error("connection lost");
+        }
+        remaining.remove_prefix(result.size);
+    }
+}
+
+std::string GameClient::receive() {
+    while (true) {
+        auto const end = input.find('\n', consumed);
+        if (end != std::string::npos) {
+            auto line = input.substr(consumed, end - consumed);
+            consumed = end + 1;
+            // Compact once the consumed part dominates, not on every line
+            if (consumed > 4096 && consumed * 2 > input.size()) {
+                input.erase(0, consumed);
+                consumed = 0;
+            }
+            return line;
+        }
+
+        std::array<char, 4096> buffer;
+        auto const result = socket.receive(buffer);
+        if (result.status != IoStatus::Done) {
+            throw std::runtime_error("connection lost");
+        }
+        input.append(buffer.data(), result.size);
+    }
+}
+
+std::string GameClient::request(std::string_view line) {
+    send(line);
+    return receive();
+}
+
+std::string GameClient::expect_reply(std::string_view line, std::string_view reply) {
+    auto const response = request(line);
+    std::string_view arguments = response;
+    if (next_token(arguments) != reply) {
+        throw std::runtime_error("game server: " + response);
+    }
+    auto const start = arguments.find_first_not_of(' ');
+    return std::string(start == std::string_view::npos ? std::string_view{} : arguments.substr(start));
+}
+
+std::uint32_t GameClient::create_game(std::vector<PlayerId> const& players) {
+    auto const arguments = expect_reply("new " + format_players(players), "game");
+    std::uint32_t id = 0;
+    std::from_chars(arguments.data(), arguments.data() + arguments.size(), id);
+    return id;
+}
+
+void GameClient::play(std::uint32_t game_id, Move move) {
+    auto line = "play " + std::to_string(game_id) + ' ';
+    append_move(line, move);
+    expect_reply(line, "ok");
+}
+
+std::vector<Move> GameClient::get_moves(std::uint32_t game_id) {
+    auto const reply = expect_reply("moves " + std::to_string(game_id), "moves");
+    std::string_view arguments = reply;
+    // Skips the move count
+    next_token(arguments);
+
+    std::vector<Move> moves;
+    for (auto token = next_token(arguments); !token.empty(); token = next_token(arguments)) {
+        moves.push_back(parse_move(token).value_or(Move::pass()));
+    }
+    return moves;
+}
+
+Move GameClient::get_bot_move(std::uint32_t game_id, std::uint32_t iterations, std::uint32_t milliseconds) {
+    auto line = "bot " + std::to_string(game_id) + ' ' + std::to_string(iterations);
+    if (milliseconds != 0) {
+        line += ' ' + std::to_string(milliseconds);
+    }
+    return parse_move(expect_reply(line, "move")).value_or(Move::pass());
+}
+
+void GameClient::close_game(std::uint32_t game_id) {
+    expect_reply("close " + std::to_string(game_id), "ok");
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Move.h"
+#include "PlayerId.h"
+#include "Socket.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Blocking client of the game server line protocol, throws std::runtime_error on error replies.
+// send and receive can be used apart to pipeline requests.
+class GameClient {
+public:
+    GameClient(std::string const& host, std::uint16_t port);
+
+    void send(std::string_view line);
+    // Next reply line, without its new line
+    std::string receive();
+
+    std::string request(std::string_view line);
+
+    std::uint32_t create_game(std::vector<PlayerId> const& players);
+    void play(std::uint32_t game_id, Move move);
+    std::vector<Move> get_moves(std::uint32_t game_id);
+    Move get_bot_move(std::uint32_t game_id, std::uint32_t iterations, std::uint32_t milliseconds = 0);
+    void close_game(std::uint32_t game_id);
+
+private:
+    // Returns the reply arguments after checking its first token
+    std::string expect_reply(std::string_view line, std::string_view reply);
+
+    Socket socket;
+    std::string input;
+    std::size_t consumed{ 0 };
+};
+
+}
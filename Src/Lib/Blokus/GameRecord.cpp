@@ -0,0 +1,85 @@
+#include "pch.h"
+#include "GameRecord.h"
+
+#include <cassert>
+#include <limits>
+
+namespace blokus {
+
+GameRecord GameRecord::from_game(Game const& game) {
+    GameRecord record;
+    auto const players = game.get_players();
+    record.players.assign(players.begin(), players.end());
+    record.moves.reserve(game.get_ply());
+    for (std::size_t ply = 0; ply < game.get_ply(); ++ply) {
+        record.moves.push_back(game.get_move(ply));
+    }
+    for (auto const player : players) {
+        record.scores.push_back(game.get_score(player));
+    }
+    return record;
+}
+
+void append_record(std::vector<std::uint8_t>& output, GameRecord const& record) {
+    output.push_back(static_cast<std::uint8_t>(record.players.size()));
+    for (auto const player : record.players) {
+        output.push_back(static_cast<std::uint8_t>(to_index(player)));
+    }
+    output.push_back(static_cast<std::uint8_t>(record.moves.size()));
+    for (auto const move : record.moves) {
+        output.push_back(static_cast<std::uint8_t>(move.get_value()));
+        output.push_back(static_cast<std::uint8_t>(move.get_value() >> 8));
+    }
+    assert(record.scores.size() == record.players.size());
+    for (auto const score : record.scores) {
+        // Scores run from -89 to 20
+        assert(score >= std::numeric_limits<std::int8_t>::min() && score <= std::numeric_limits<std::int8_t>::max());
+        output.push_back(static_cast<std::uint8_t>(static_cast<std::int8_t>(score)));
+    }
+}
+
+std::optional<GameRecord> read_record(std::span<std::uint8_t const> input, std::size_t& offset) {
+    auto position = offset;
+    auto const remaining = [&input, &position] { return input.size() - position; };
+
+    if (remaining() < 1) {
+        return std::nullopt;
+    }
+    std::size_t const player_count = input[position++];
+    if (player_count == 0 || player_count > Game::max_player_count || remaining() < player_count + 1) {
+        return std::nullopt;
+    }
+
+    GameRecord record;
+    for (std::size_t i = 0; i < player_count; ++i) {
+        auto const index = input[position++];
+        if (index >= player_id_count) {
+            return std::nullopt;
+        }
+        record.players.push_back(static_cast<PlayerId>(index));
+    }
+
+    std::size_t const move_count = input[position++];
+    if (move_count > Game::max_ply_count || remaining() < 2 * move_count) {
+        return std::nullopt;
+    }
+    record.moves.reserve(move_count);
+    for (std::size_t i = 0; i < move_count; ++i) {
+        auto const value = static_cast<std::uint16_t>(input[position] | input[position + 1] << 8);
+        record.moves.push_back(Move::from_value(value));
+        position += 2;
+    }
+
+    if (remaining() < player_count) {
+        return std::nullopt;
+    }
+    record.scores.reserve(player_count);
+    for (std::size_t i = 0; i < player_count; ++i) {
+        record.scores.push_back(static_cast<std::int8_t>(input[position++]));
+    }
+
+    offset = position;
+    return record;
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Game.h"
+#include "Move.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// A finished game as stored in the shards: the seating, the moves and the final scores. Everything
+// else replays from the moves, the scores let a replay be checked against the game that was played.
+struct GameRecord {
+    std::vector<PlayerId> players;
+    std::vector<Move> moves;
+    // One per player, in seating order
+    std::vector<int> scores;
+
+    static GameRecord from_game(Game const& game);
+
+    friend bool operator==(GameRecord const&, GameRecord const&) = default;
+};
+
+// Binary layout: player count, one byte per player, move count, two little endian bytes per move,
+// one signed byte per player score
+void append_record(std::vector<std::uint8_t>& output, GameRecord const& record);
+
+// Reads the record at the offset and moves the offset past it, nothing when the bytes are malformed
+std::optional<GameRecord> read_record(std::span<std::uint8_t const> input, std::size_t& offset);
+
+}
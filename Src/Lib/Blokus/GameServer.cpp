@@ -0,0 +1,298 @@
+#include "pch.h"
+#include "GameServer.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <utility>
+
+#include "MoveGeneration.h"
+#include "MoveList.h"
+
+namespace blokus {
+
+GameServer::GameServer(GameServerConfig config)
+    : config(config)
+    , listener(Socket::listen_tcp(config.host, config.port))
+    , port(listener.get_local_port())
+    , engine(config.engine)
+{
+    listener.set_non_blocking(true);
+    poller.add(listener.get_handle(), listener_key);
+
+    std::tie(wake_reader, wake_writer) = Socket::make_pair();
+    wake_reader.set_non_blocking(true);
+    wake_writer.set_non_blocking(true);
+    poller.add(wake_reader.get_handle(), wake_key);
+}
+
+GameServer::~GameServer() {
+    for (auto& [key, session] : sessions) {
+        session->bot_stop.request_stop();
+    }
+}
+
+void GameServer::run() {
+    std::vector<PollEvent> events;
+    while (!stopping.load()) {
+        // The timeout only matters when a stop request loses its wake up byte
+        poller.wait(events, std::chrono::milliseconds(100));
+        for (auto const& event : events) {
+            if (event.key == listener_key) {
+                accept_sessions();
+                continue;
+            }
+            if (event.key == wake_key) {
+                deliver_completions();
+                continue;
+            }
+
+            // An earlier event of the batch may have closed the session
+            auto const found = sessions.find(event.key);
+            if (found == sessions.end()) {
+                continue;
+            }
+            auto& session = *found->second;
+            if (event.readable || event.closed) {
+                read(event.key, session);
+            }
+            if (event.writable && sessions.contains(event.key)) {
+                flush(event.key, session);
+            }
+        }
+    }
+}
+
+void GameServer::stop() {
+    stopping.store(true);
+    wake();
+}
+
+void GameServer::wake() {
+    // Nothing to do when the socket buffer is full, the loop is already due to wake up
+    char const byte = 0;
+    wake_writer.send({ &byte, 1 });
+}
+
+void GameServer::accept_sessions() {
+    while (true) {
+        auto socket = listener.accept();
+        if (!socket.is_valid()) {
+            return;
+        }
+        if (sessions.size() >= config.max_sessions) {
+            continue;
+        }
+
+        socket.set_non_blocking(true);
+        auto const key = next_session_key++;
+        poller.add(socket.get_handle(), key);
+        auto session = std::make_unique<Session>();
+        session->socket = std::move(socket);
+        sessions.emplace(key, std::move(session));
+        ++session_count;
+    }
+}
+
+void GameServer::read(std::uint64_t key, Session& session) {
+    std::array<char, 4096> buffer;
+    while (true) {
+        auto const result = session.socket.receive(buffer);
+        if (result.status == IoStatus::WouldBlock) {
+            break;
+        }
+        if (result.status != IoStatus::Done) {
+            close_session(key);
+            return;
+        }
+        session.input.append(buffer.data(), result.size);
+        // The rest stays in the socket until these requests are handled, the poller reports it again
+        auto const max_input_size = session.waiting_for_bot ? config.max_pending_input : config.max_line_size;
+        if (result.size < buffer.size() || session.input.size() > max_input_size) {
+            break;
+        }
+    }
+
+    handle_requests(key, session);
+}
+
+void GameServer::handle_requests(std::uint64_t key, Session& session) {
+    std::size_t consumed = 0;
+    while (!session.waiting_for_bot) {
+        auto const end = session.input.find('\n', consumed);
+        if (end == std::string::npos) {
+            break;
+        }
+        auto const line = std::string_view(session.input).substr(consumed, end - consumed);
+        consumed = end + 1;
+
+        if (auto const command = parse_command(line)) {
+            handle_request(key, session, *command);
+        }
+        else {
+            session.output += "error malformed request\n";
+        }
+    }
+    session.input.erase(0, consumed);
+
+    // The socket is still read while a bot request runs, so that a closed session is noticed
+    auto const max_input_size = session.waiting_for_bot ? config.max_pending_input : config.max_line_size;
+    if (session.input.size() > max_input_size) {
+        close_session(key);
+        return;
+    }
+    flush(key, session);
+}
+
+void GameServer::handle_request(std::uint64_t key, Session& session, Command const& command) {
+    auto& output = session.output;
+
+    if (command.type == CommandType::Ping) {
+        output += "pong\n";
+        return;
+    }
+
+    if (command.type == CommandType::New) {
+        if (session.games.size() >= config.max_games_per_session) {
+            output += "error too many games\n";
+            return;
+        }
+        auto const id = session.next_game_id++;
+        session.games.emplace(id, Game::CreateNew(command.players));
+        output += "game " + std::to_string(id) + '\n';
+        return;
+    }
+
+    auto const found = session.games.find(command.game_id);
+    if (found == session.games.end()) {
+        output += "error unknown game\n";
+        return;
+    }
+    auto& game = found->second;
+
+    switch (command.type) {
+    case CommandType::Play:
+        if (!is_legal(game, command.move)) {
+            output += "error illegal move\n";
+            return;
+        }
+        game.apply(command.move);
+        output += "ok\n";
+        return;
+
+    case CommandType::Moves: {
+        MoveList moves;
+        if (!game.is_over()) {
+            generate_moves(game, moves);
+        }
+        output += "moves ";
+        output += std::to_string(moves.size());
+        for (auto const move : moves) {
+            output += ' ';
+            append_move(output, move);
+        }
+        output += '\n';
+        return;
+    }
+
+    case CommandType::Bot: {
+        if (game.is_over()) {
+            output += "error game over\n";
+            return;
+        }
+        SearchRequest request{ .game = game, .iterations = std::min(command.iterations, config.max_bot_iterations) };
+        auto const time = command.milliseconds != 0
+            ? std::min<std::chrono::milliseconds>(std::chrono::milliseconds(command.milliseconds), config.max_bot_time)
+            : config.max_bot_time;
+        request.deadline = Deadline::after(time);
+        if (command.clock) {
+            request.time_control = TimeControl{
+                .remaining = std::chrono::milliseconds(command.milliseconds),
+                .increment = std::chrono::milliseconds(command.increment),
+            };
+            // The clock budgets the move, max_bot_time stays the hard cap
+            request.deadline = Deadline::after(config.max_bot_time);
+        }
+        session.waiting_for_bot = true;
+        session.bot_stop = {};
+        engine.submit(std::move(request), session.bot_stop.get_token(), [this, key](MctsResult result) {
+            {
+                std::scoped_lock lock(completions_mutex);
+                completions.push_back({ key, result.best_move });
+            }
+            wake();
+        });
+        return;
+    }
+
+    case CommandType::Close:
+        session.games.erase(found);
+        output += "ok\n";
+        return;
+
+    default:
+        return;
+    }
+}
+
+void GameServer::flush(std::uint64_t key, Session& session) {
+    while (!session.output.empty()) {
+        auto const result = session.socket.send(session.output);
+        if (result.status == IoStatus::WouldBlock) {
+            break;
+        }
+        if (result.status != IoStatus::Done) {
+            close_session(key);
+            return;
+        }
+        session.output.erase(0, result.size);
+    }
+    if (session.output.size() > config.max_pending_output) {
+        close_session(key);
+        return;
+    }
+
+    // Only watch writes while some output is pending, a writable socket would wake the loop forever
+    auto const watch_writes = !session.output.empty();
+    if (watch_writes != session.watching_writes) {
+        session.watching_writes = watch_writes;
+        poller.modify(session.socket.get_handle(), key, watch_writes);
+    }
+}
+
+void GameServer::close_session(std::uint64_t key) {
+    auto const found = sessions.find(key);
+    auto& session = *found->second;
+    session.bot_stop.request_stop();
+    poller.remove(session.socket.get_handle());
+    sessions.erase(found);
+    --session_count;
+}
+
+void GameServer::deliver_completions() {
+    std::array<char, 256> buffer;
+    while (wake_reader.receive(buffer).status == IoStatus::Done) {
+    }
+
+    std::vector<Completion> delivered;
+    {
+        std::scoped_lock lock(completions_mutex);
+        delivered.swap(completions);
+    }
+
+    for (auto const& completion : delivered) {
+        // The session may have closed while its bot was searching
+        auto const found = sessions.find(completion.session_key);
+        if (found == sessions.end()) {
+            continue;
+        }
+        auto& session = *found->second;
+        session.waiting_for_bot = false;
+        session.output += "move ";
+        append_move(session.output, completion.move);
+        session.output += '\n';
+        handle_requests(completion.session_key, session);
+    }
+}
+
+}
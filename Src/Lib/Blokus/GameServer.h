@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine.h"
+#include "Game.h"
+#include "Mcts.h"
+#include "Poller.h"
+#include "Protocol.h"
+#include "Socket.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct GameServerConfig {
+    std::string host{ "127.0.0.1" };
+    // Zero picks any free port, see GameServer::get_port
+    std::uint16_t port{ 0 };
+    std::size_t max_sessions{ 10000 };
+    std::size_t max_games_per_session{ 256 };
+    // A longer line without a new line closes the session
+    std::size_t max_line_size{ 1024 };
+    // Requests received while a bot request runs wait unread, more than this closes the session
+    std::size_t max_pending_input{ 64 * 1024 };
+    // Replies not yet taken by a client that doesn't read, more than this closes the session
+    std::size_t max_pending_output{ 1024 * 1024 };
+    // Bot requests asking for more are cut down to these, a request without a time gets the maximum
+    std::uint32_t max_bot_iterations{ 1000000 };
+    std::chrono::milliseconds max_bot_time{ std::chrono::seconds(30) };
+    EngineConfig engine{};
+};
+
+// ----------------------------------------------------------------------------
+
+// Serves the line protocol of Protocol.h to many sessions from a single event loop thread.
+// Each session owns its games; bot requests run on the engine threads and their replies are handed
+// back to the loop. A session stops reading its requests while one of its bot requests is running,
+// which keeps the replies in order.
+class GameServer {
+public:
+    explicit GameServer(GameServerConfig config = {});
+    ~GameServer();
+
+    GameServer(GameServer const&) = delete;
+    GameServer& operator=(GameServer const&) = delete;
+
+    std::uint16_t get_port() const { return port; }
+
+    // Bot requests given a clock, against the budget the server allotted them
+    OverrunStatistics get_time_statistics() const { return engine.get_time_statistics(); }
+
+    // Runs the event loop until stop is called
+    void run();
+
+    // Can be called from any thread, or a signal handler
+    void stop();
+
+    std::size_t get_session_count() const { return session_count.load(); }
+
+private:
+    struct Session {
+        Socket socket;
+        std::string input;
+        std::string output;
+        std::unordered_map<std::uint32_t, Game> games;
+        std::uint32_t next_game_id{ 1 };
+        // Cancels the running bot request when the session closes
+        std::stop_source bot_stop;
+        bool waiting_for_bot{ false };
+        bool watching_writes{ false };
+    };
+
+    struct Completion {
+        std::uint64_t session_key;
+        Move move;
+    };
+
+    void accept_sessions();
+    void read(std::uint64_t key, Session& session);
+    void handle_requests(std::uint64_t key, Session& session);
+    void handle_request(std::uint64_t key, Session& session, Command const& command);
+    void flush(std::uint64_t key, Session& session);
+    void close_session(std::uint64_t key);
+    void deliver_completions();
+    void wake();
+
+    GameServerConfig config;
+    Socket listener;
+    std::uint16_t port{ 0 };
+    Poller poller;
+    // The engine threads write a byte to wake the loop up once a bot reply is ready
+    Socket wake_reader;
+    Socket wake_writer;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Session>> sessions;
+    std::uint64_t next_session_key{ first_session_key };
+    std::atomic<std::size_t> session_count{ 0 };
+    std::atomic<bool> stopping{ false };
+
+    std::mutex completions_mutex;
+    std::vector<Completion> completions;
+
+    // Declared last, running searches are cancelled before the sessions go away
+    Engine engine;
+
+    static constexpr std::uint64_t listener_key = 0;
+    static constexpr std::uint64_t wake_key = 1;
+    static constexpr std::uint64_t first_session_key = 2;
+};
+
+}
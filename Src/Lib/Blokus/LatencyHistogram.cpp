@@ -0,0 +1,106 @@
+#include "pch.h"
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+namespace blokus {
+
+LatencyHistogram::LatencyHistogram(unsigned precision_bits)
+    : precision_bits(precision_bits)
+{
+    assert(precision_bits >= 2 && precision_bits <= 16);
+    auto const half = std::size_t{ 1 } << (precision_bits - 1);
+    // Exact buckets, then half as many per remaining power of two
+    buckets.resize(2 * half + (64 - precision_bits) * half);
+}
+
+std::size_t LatencyHistogram::to_bucket(std::uint64_t value) const {
+    auto const exact = std::uint64_t{ 1 } << precision_bits;
+    if (value < exact) {
+        return static_cast<std::size_t>(value);
+    }
+    auto const half = exact / 2;
+    auto const shift = static_cast<unsigned>(std::bit_width(value)) - precision_bits;
+    auto const mantissa = (value >> shift) - half;
+    return static_cast<std::size_t>(exact + (shift - 1) * half + mantissa);
+}
+
+std::uint64_t LatencyHistogram::get_highest_equivalent(std::size_t bucket) const {
+    auto const exact = std::size_t{ 1 } << precision_bits;
+    if (bucket < exact) {
+        return bucket;
+    }
+    auto const half = exact / 2;
+    auto const shift = static_cast<unsigned>((bucket - exact) / half + 1);
+    auto const mantissa = static_cast<std::uint64_t>((bucket - exact) % half + half);
+    return (mantissa << shift) + ((std::uint64_t{ 1 } << shift) - 1);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds value) {
+    auto const ticks = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(value.count(), 0));
+    ++buckets[to_bucket(ticks)];
+    min = count == 0 ? ticks : std::min(min, ticks);
+    max = std::max(max, ticks);
+    sum += static_cast<double>(ticks);
+    ++count;
+}
+
+void LatencyHistogram::merge(LatencyHistogram const& other) {
+    assert(precision_bits == other.precision_bits);
+    if (other.count == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    min = count == 0 ? other.min : std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    count += other.count;
+}
+
+void LatencyHistogram::clear() {
+    std::ranges::fill(buckets, 0);
+    count = 0;
+    min = 0;
+    max = 0;
+    sum = 0;
+}
+
+std::chrono::nanoseconds LatencyHistogram::get_min() const {
+    return std::chrono::nanoseconds(min);
+}
+
+std::chrono::nanoseconds LatencyHistogram::get_max() const {
+    return std::chrono::nanoseconds(max);
+}
+
+std::chrono::nanoseconds LatencyHistogram::get_mean() const {
+    if (count == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+    return std::chrono::nanoseconds(static_cast<std::int64_t>(std::llround(sum / static_cast<double>(count))));
+}
+
+std::chrono::nanoseconds LatencyHistogram::get_percentile(double percentile) const {
+    if (count == 0) {
+        return std::chrono::nanoseconds(0);
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto const rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count))), 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            // The bucket bound can exceed the largest recorded value
+            return std::chrono::nanoseconds(std::min(get_highest_equivalent(i), max));
+        }
+    }
+    return std::chrono::nanoseconds(max);
+}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Log-linear histogram of durations in the spirit of HdrHistogram.
+// Values below 2^precision_bits nanoseconds are exact, every power of two above is split in
+// 2^(precision_bits - 1) buckets, so a reported value is within 2^(1 - precision_bits) of the recorded one.
+class LatencyHistogram {
+public:
+    explicit LatencyHistogram(unsigned precision_bits = 7);
+
+    void record(std::chrono::nanoseconds value);
+    // Both histograms must have the same precision
+    void merge(LatencyHistogram const& other);
+    void clear();
+
+    std::uint64_t get_count() const { return count; }
+    std::chrono::nanoseconds get_min() const;
+    std::chrono::nanoseconds get_max() const;
+    std::chrono::nanoseconds get_mean() const;
+
+    // Highest value equivalent to the recorded value at the percentile, from 0 to 100
+    std::chrono::nanoseconds get_percentile(double percentile) const;
+
+private:
+    std::size_t to_bucket(std::uint64_t value) const;
+    std::uint64_t get_highest_equivalent(std::size_t bucket) const;
+
+    unsigned precision_bits;
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count{ 0 };
+    std::uint64_t min{ 0 };
+    std::uint64_t max{ 0 };
+    // Exact up to about a hundred days of nanoseconds
+    double sum{ 0 };
+};
+
+}
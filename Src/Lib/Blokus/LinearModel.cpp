@@ -0,0 +1,149 @@
+#include "pch.h"
+#include "LinearModel.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace blokus {
+
+namespace {
+
+constexpr std::array<char, 4> model_magic{ 'B', 'K', 'L', 'M' };
+constexpr std::uint32_t model_version = 2;
+
+void write32(std::ostream& stream, std::uint32_t value) {
+    std::array<char, 4> const bytes{
+        static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24),
+    };
+    stream.write(bytes.data(), bytes.size());
+}
+
+bool read32(std::istream& stream, std::uint32_t& value) {
+    std::array<unsigned char, 4> bytes;
+    if (!stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+        return false;
+    }
+    value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    return true;
+}
+
+void write_weights(std::ostream& stream, std::span<float const> weights) {
+    for (auto const weight : weights) {
+        write32(stream, std::bit_cast<std::uint32_t>(weight));
+    }
+}
+
+bool read_weights(std::istream& stream, std::span<float> weights) {
+    for (auto& weight : weights) {
+        std::uint32_t bits;
+        if (!read32(stream, bits)) {
+            return false;
+        }
+        weight = std::bit_cast<float>(bits);
+    }
+    return true;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+LinearModel::LinearModel()
+    : policy_weights(features::policy_size)
+    , value_weights(features::value_size)
+{}
+
+LinearModel LinearModel::load(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open model " + path.string());
+    }
+    try {
+        return load(file);
+    }
+    catch (std::runtime_error const& error) {
+        throw std::runtime_error(std::string(error.what()) + ": " + path.string());
+    }
+}
+
+void LinearModel::save(std::filesystem::path const& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    save(file);
+    if (!file.flush()) {
+        throw std::runtime_error("cannot write model " + path.string());
+    }
+}
+
+LinearModel LinearModel::load(std::istream& stream) {
+    std::array<char, 4> magic;
+    std::uint32_t version = 0;
+    std::uint32_t policy_size = 0;
+    std::uint32_t value_size = 0;
+    if (!stream.read(magic.data(), magic.size()) || magic != model_magic ||
+        !read32(stream, version) || !read32(stream, policy_size) || !read32(stream, value_size)) {
+        throw std::runtime_error("not a model");
+    }
+    // The sizes change with the features, weights of other features can't be used
+    if (version != model_version || policy_size != features::policy_size || value_size != features::value_size) {
+        throw std::runtime_error("model with other features");
+    }
+
+    LinearModel model;
+    if (!read_weights(stream, model.policy_weights) || !read_weights(stream, model.value_weights)) {
+        throw std::runtime_error("truncated model");
+    }
+    return model;
+}
+
+void LinearModel::save(std::ostream& stream) const {
+    stream.write(model_magic.data(), model_magic.size());
+    write32(stream, model_version);
+    write32(stream, static_cast<std::uint32_t>(policy_weights.size()));
+    write32(stream, static_cast<std::uint32_t>(value_weights.size()));
+    write_weights(stream, policy_weights);
+    write_weights(stream, value_weights);
+}
+
+void LinearModel::get_priors(Game const& game, std::span<Move const> moves, std::span<float> priors) const {
+    assert(priors.size() == moves.size());
+    if (moves.empty()) {
+        return;
+    }
+
+    PositionFeatures const position(game);
+    auto max_score = -std::numeric_limits<float>::infinity();
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        priors[i] = get_sparse_dot(policy_weights, position.get_move_features(moves[i]).get());
+        max_score = std::max(max_score, priors[i]);
+    }
+    float sum = 0.0f;
+    for (auto& prior : priors) {
+        prior = std::exp(prior - max_score);
+        sum += prior;
+    }
+    for (auto& prior : priors) {
+        prior /= sum;
+    }
+}
+
+Rewards LinearModel::evaluate(Game const& game) const {
+    Rewards result{};
+    std::vector<std::uint32_t> indices;
+    indices.reserve(features::value_size);
+    auto const players = game.get_players();
+    for (std::size_t i = 0; i < players.size(); ++i) {
+        indices.clear();
+        PositionFeatures::get_value_features(game, players[i], indices);
+        result[i] = 1.0f / (1.0f + std::exp(-get_sparse_dot(value_weights, indices)));
+    }
+    return result;
+}
+
+}
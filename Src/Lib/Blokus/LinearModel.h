@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "Evaluation.h"
+#include "Game.h"
+#include "ModelFeatures.h"
+#include "Move.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Sum of the weights of the active features of a sparse binary vector
+inline float get_sparse_dot(std::span<float const> weights, std::span<std::uint32_t const> indices) {
+    // Independent sums keep several loads in flight, the gathers being the only cost
+    float sums[4]{};
+    std::size_t i = 0;
+    for (; i + 4 <= indices.size(); i += 4) {
+        sums[0] += weights[indices[i]];
+        sums[1] += weights[indices[i + 1]];
+        sums[2] += weights[indices[i + 2]];
+        sums[3] += weights[indices[i + 3]];
+    }
+    for (; i < indices.size(); ++i) {
+        sums[0] += weights[indices[i]];
+    }
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// ----------------------------------------------------------------------------
+
+// Linear policy and value over the sparse features of ModelFeatures.h.
+// The policy is a softmax over the scores of the legal moves, the value a logistic estimate of the
+// reward of each player as given by get_rewards. A new model has all its weights at zero: uniform
+// priors and even values.
+//
+// File layout: "BKLM", 4 bytes version, 4 bytes policy size, 4 bytes value size, then the policy
+// and value weights as little endian floats. I/O failures and malformed files throw std::runtime_error.
+class LinearModel {
+public:
+    LinearModel();
+
+    static LinearModel load(std::filesystem::path const& path);
+    void save(std::filesystem::path const& path) const;
+
+    // Same layout, for models that travel through memory or the network
+    static LinearModel load(std::istream& stream);
+    void save(std::ostream& stream) const;
+
+    // Probabilities of the moves, which must be the legal moves of the game in any order
+    void get_priors(Game const& game, std::span<Move const> moves, std::span<float> priors) const;
+
+    // Indexed by the player position in Game::get_players(), finished players included
+    Rewards evaluate(Game const& game) const;
+
+    std::span<float> get_policy_weights() { return policy_weights; }
+    std::span<float const> get_policy_weights() const { return policy_weights; }
+    std::span<float> get_value_weights() { return value_weights; }
+    std::span<float const> get_value_weights() const { return value_weights; }
+
+private:
+    std::vector<float> policy_weights;
+    std::vector<float> value_weights;
+};
+
+}
@@ -0,0 +1,192 @@
+#include "pch.h"
+#include "MappedFile.h"
+
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace blokus {
+
+namespace {
+
+#ifdef _WIN32
+[[noreturn]] void throw_last_error(char const* what) {
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+}
+#else
+[[noreturn]] void throw_last_error(char const* what) {
+    throw std::system_error(errno, std::system_category(), what);
+}
+#endif
+
+}
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::filesystem::path const& path, std::uint64_t minimum_size) {
+    file_handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        throw_last_error("CreateFileW");
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file_handle, &file_size)) {
+        close();
+        throw_last_error("GetFileSizeEx");
+    }
+    size = static_cast<std::uint64_t>(file_size.QuadPart);
+    if (size < minimum_size) {
+        size = minimum_size;
+    }
+    map();
+}
+
+void MappedFile::map() {
+    // Mapping a file larger than it is extends it
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+    if (mapping_handle == nullptr) {
+        throw_last_error("CreateFileMappingW");
+    }
+    data = static_cast<std::uint8_t*>(MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (data == nullptr) {
+        throw_last_error("MapViewOfFile");
+    }
+}
+
+void MappedFile::unmap() {
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+        data = nullptr;
+    }
+    if (mapping_handle != nullptr) {
+        CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+    }
+}
+
+void MappedFile::flush() const {
+    if (data != nullptr && (!FlushViewOfFile(data, 0) || !FlushFileBuffers(file_handle))) {
+        throw_last_error("FlushViewOfFile");
+    }
+}
+
+void MappedFile::close() {
+    unmap();
+    if (file_handle != nullptr) {
+        CloseHandle(file_handle);
+        file_handle = nullptr;
+    }
+    size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : file_handle(std::exchange(other.file_handle, nullptr))
+    , mapping_handle(std::exchange(other.mapping_handle, nullptr))
+    , data(std::exchange(other.data, nullptr))
+    , size(std::exchange(other.size, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        file_handle = std::exchange(other.file_handle, nullptr);
+        mapping_handle = std::exchange(other.mapping_handle, nullptr);
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+    }
+    return *this;
+}
+
+#else
+
+MappedFile::MappedFile(std::filesystem::path const& path, std::uint64_t minimum_size) {
+    descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (descriptor < 0) {
+        throw_last_error("open");
+    }
+
+    struct stat status {};
+    if (::fstat(descriptor, &status) != 0) {
+        auto const error = errno;
+        close();
+        throw std::system_error(error, std::system_category(), "fstat");
+    }
+    size = static_cast<std::uint64_t>(status.st_size);
+    if (size < minimum_size) {
+        size = minimum_size;
+    }
+    map();
+}
+
+void MappedFile::map() {
+    if (::ftruncate(descriptor, static_cast<off_t>(size)) != 0) {
+        throw_last_error("ftruncate");
+    }
+    auto const address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (address == MAP_FAILED) {
+        throw_last_error("mmap");
+    }
+    data = static_cast<std::uint8_t*>(address);
+}
+
+void MappedFile::unmap() {
+    if (data != nullptr) {
+        ::munmap(data, size);
+        data = nullptr;
+    }
+}
+
+void MappedFile::flush() const {
+    if (data != nullptr && ::msync(data, size, MS_SYNC) != 0) {
+        throw_last_error("msync");
+    }
+}
+
+void MappedFile::close() {
+    unmap();
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+    size = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : descriptor(std::exchange(other.descriptor, -1))
+    , data(std::exchange(other.data, nullptr))
+    , size(std::exchange(other.size, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        descriptor = std::exchange(other.descriptor, -1);
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+void MappedFile::resize(std::uint64_t new_size) {
+    unmap();
+    size = new_size;
+    map();
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// A file mapped read-write in memory, changes reach the file through the page cache.
+// Failures to open, resize or map throw std::system_error.
+class MappedFile {
+public:
+    MappedFile() = default;
+    // Creates the file if needed and grows it to at least the minimum size
+    MappedFile(std::filesystem::path const& path, std::uint64_t minimum_size);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool is_open() const { return data != nullptr; }
+
+    std::uint8_t* get_data() const { return data; }
+    std::uint64_t get_size() const { return size; }
+
+    // Remaps the whole file, pointers into the old mapping become invalid
+    void resize(std::uint64_t new_size);
+
+    // Writes the dirty pages back to the file
+    void flush() const;
+
+    void close();
+
+private:
+    void map();
+    void unmap();
+
+#ifdef _WIN32
+    void* file_handle{ nullptr };
+    void* mapping_handle{ nullptr };
+#else
+    int descriptor{ -1 };
+#endif
+    std::uint8_t* data{ nullptr };
+    std::uint64_t size{ 0 };
+};
+
+}
@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "Mcts.h"
+
+#include <utility>
+
+namespace blokus {
+
+Mcts::Mcts(MctsConfig config)
+    : config(config)
+    , tree(config.arena, config.model.get())
+    , random(config.seed)
+{}
+
+MctsResult Mcts::search(Game const& game, Deadline const& deadline, std::stop_token stop) {
+    return search(game, config.iterations, deadline, std::move(stop));
+}
+
+MctsResult Mcts::search(Game const& game, std::uint32_t iterations, Deadline const& deadline, std::stop_token stop) {
+    auto const start = Deadline::Clock::now();
+
+    MctsResult result;
+    if (config.reuse_tree && tree.advance(game)) {
+        result.reused_visits = tree.get_root().visits;
+    }
+    else {
+        tree.reset(game);
+    }
+
+    // An iteration takes about a millisecond, polling the clock on each one is cheap enough
+    while (result.iterations < iterations) {
+        if (stop.stop_requested()) {
+            result.cancelled = true;
+            break;
+        }
+        if (deadline.has_expired()) {
+            result.deadline_reached = true;
+            break;
+        }
+        tree.run_iteration(random, config.exploration);
+        ++result.iterations;
+    }
+
+    result.best_move = tree.get_best_move();
+    result.arena = tree.get_arena_statistics();
+    result.elapsed = Deadline::Clock::now() - start;
+    return result;
+}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+
+#include "Arena.h"
+#include "Deadline.h"
+#include "Game.h"
+#include "Move.h"
+#include "Random.h"
+#include "SearchTree.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct MctsConfig {
+    // Maximum number of iterations, the search can also stop earlier on its deadline
+    std::uint32_t iterations{ 10000 };
+    float exploration{ 0.7f };
+    std::uint64_t seed{ 0 };
+    // Keep the subtree of the moves played since the previous search
+    bool reuse_tree{ true };
+    ArenaConfig arena{};
+    // Move priors and leaf values instead of UCT and random playouts, see SearchTree.
+    // Shared, read only, by every search of the configuration.
+    std::shared_ptr<LinearModel const> model{};
+};
+
+struct MctsResult {
+    Move best_move{ Move::pass() };
+    std::uint32_t iterations{ 0 };
+    // Root visits carried over from the previous search
+    std::uint32_t reused_visits{ 0 };
+    // The deadline stopped the search before the maximum number of iterations
+    bool deadline_reached{ false };
+    // A stop request ended the search, the best move is the best one found so far
+    bool cancelled{ false };
+    std::chrono::nanoseconds elapsed{ 0 };
+    ArenaStatistics arena{};
+};
+
+// ----------------------------------------------------------------------------
+
+// Single threaded UCT search, the tree arena is kept between searches
+class Mcts {
+public:
+    explicit Mcts(MctsConfig config = {});
+
+    // The stop token is polled between iterations, like the deadline
+    MctsResult search(Game const& game, Deadline const& deadline = Deadline::never(), std::stop_token stop = {});
+
+    // Runs at most the given number of iterations instead of the configured ones
+    MctsResult search(Game const& game, std::uint32_t iterations, Deadline const& deadline, std::stop_token stop = {});
+
+    MctsConfig const& get_config() const { return config; }
+
+private:
+    MctsConfig config;
+    SearchTree tree;
+    Random random;
+};
+
+}
@@ -0,0 +1,120 @@
+#include "pch.h"
+#include "ModelFeatures.h"
+
+#include <cassert>
+
+namespace blokus {
+
+namespace {
+
+// Squares between the board and each player frame, both ways
+struct FrameTables {
+    std::array<std::array<Square, square_count>, player_id_count> to_frame;
+    std::array<std::array<Square, square_count>, player_id_count> to_board;
+
+    FrameTables() {
+        for (std::size_t player = 0; player < player_id_count; ++player) {
+            for (Square square = 0; square < square_count; ++square) {
+                auto const frame_square = to_player_frame(square, static_cast<PlayerId>(player));
+                to_frame[player][square] = frame_square;
+                to_board[player][frame_square] = square;
+            }
+        }
+    }
+};
+
+FrameTables const& get_frame_tables() {
+    static FrameTables const tables;
+    return tables;
+}
+
+enum class Neighbour : std::uint16_t { Free, Own, Opponent, OffBoard };
+
+}
+
+// ----------------------------------------------------------------------------
+
+PositionFeatures::PositionFeatures(Game const& game)
+    : mover(game.get_current_player())
+    , anchors(game.get_anchors(mover))
+{
+    auto const& tables = get_frame_tables();
+    auto const& to_frame = tables.to_frame[to_index(mover)];
+    auto const& to_board = tables.to_board[to_index(mover)];
+    auto const& own = game.get_occupancy(mover);
+    auto const& occupancy = game.get_occupancy();
+    auto const forbidden = game.get_forbidden(mover);
+
+    // Neighbours in the order of the frame, so that a pattern means the same for every color
+    anchors.for_each([&](Square anchor) {
+        auto const center = to_position(to_frame[anchor]);
+        std::uint16_t pattern = 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (dx == 0 && dy == 0) {
+                    continue;
+                }
+                Position const neighbour{ center.get_x() + dx, center.get_y() + dy };
+                auto value = Neighbour::OffBoard;
+                if (is_on_board(neighbour)) {
+                    auto const square = to_board[to_square(neighbour)];
+                    value = own.test(square) ? Neighbour::Own : occupancy.test(square) ? Neighbour::Opponent : Neighbour::Free;
+                }
+                pattern = static_cast<std::uint16_t>(pattern << 2 | static_cast<std::uint16_t>(value));
+            }
+        }
+        patterns[anchor] = pattern;
+
+        // Same as get_pattern_key, with the neighbours taken in the frame
+        PatternKey key = 0;
+        for (int dy = -pattern_radius; dy <= pattern_radius; ++dy) {
+            for (int dx = -pattern_radius; dx <= pattern_radius; ++dx) {
+                Position const neighbour{ center.get_x() + dx, center.get_y() + dy };
+                if ((dx != 0 || dy != 0) && is_on_board(neighbour) && !forbidden.test(to_board[to_square(neighbour)])) {
+                    key |= PatternKey{ 1 } << get_pattern_bit(dx, dy);
+                }
+            }
+        }
+        key_indices[anchor] = static_cast<std::uint16_t>(get_pattern_index(key));
+    });
+}
+
+MoveFeatures PositionFeatures::get_move_features(Move move) const {
+    MoveFeatures result;
+    if (move.is_pass()) {
+        return result;
+    }
+
+    auto const& to_frame = get_frame_tables().to_frame[to_index(mover)];
+    auto const piece_offset = features::piece_square_offset + static_cast<std::uint32_t>(get_piece(move)) * square_count;
+    auto const footprint = get_footprint(move);
+    footprint.for_each([&](Square square) {
+        result.indices[result.count++] = piece_offset + to_frame[square];
+    });
+    (footprint & anchors).for_each([&](Square square) {
+        result.indices[result.count++] = features::anchor_pattern_offset + patterns[square];
+        result.indices[result.count++] = features::anchor_key_offset + key_indices[square];
+    });
+    assert(result.count <= features::max_move_features);
+    return result;
+}
+
+void PositionFeatures::get_value_features(Game const& game, PlayerId player, std::vector<std::uint32_t>& indices) {
+    auto const& to_frame = get_frame_tables().to_frame[to_index(player)];
+    auto const& own = game.get_occupancy(player);
+    own.for_each([&](Square square) {
+        indices.push_back(features::own_square_offset + to_frame[square]);
+    });
+    (game.get_occupancy() & ~own).for_each([&](Square square) {
+        indices.push_back(features::opponent_square_offset + to_frame[square]);
+    });
+    auto const remaining = game.get_remaining_pieces(player);
+    for (std::size_t piece = 0; piece < piece_count; ++piece) {
+        if (remaining.contains(static_cast<PieceId>(piece))) {
+            indices.push_back(features::piece_left_offset + static_cast<std::uint32_t>(piece));
+        }
+    }
+    indices.push_back(features::bias_index);
+}
+
+}
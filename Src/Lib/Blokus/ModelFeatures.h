@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "AnchorPattern.h"
+#include "Bitboard.h"
+#include "Game.h"
+#include "Move.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Sparse binary features of the linear model, every square seen from the player concerned (see
+// to_player_frame) so that the four colors share their weights.
+//
+// Move features, scored by the policy:
+//  piece square:   one per square covered, piece_count * square_count of them
+//  anchor pattern: one per anchor of the mover covered, the 3x3 neighbourhood of the anchor with
+//                  2 bits per neighbour (free, own, opponent, off the board)
+//  anchor key:     one per anchor of the mover covered, the 5x5 pattern key of the anchor (see
+//                  AnchorPattern.h) in the frame of the mover, by its pattern index
+// Position features, scored by the value for one player:
+//  own square, opponent square, piece left, and a bias
+namespace features {
+
+constexpr std::uint32_t piece_square_offset = 0;
+constexpr std::uint32_t anchor_pattern_offset = piece_square_offset + static_cast<std::uint32_t>(piece_count * square_count);
+constexpr std::uint32_t anchor_pattern_count = 1 << 16;
+constexpr std::uint32_t anchor_key_offset = anchor_pattern_offset + anchor_pattern_count;
+constexpr std::uint32_t anchor_key_count = 1 << pattern_index_bits;
+constexpr std::uint32_t policy_size = anchor_key_offset + anchor_key_count;
+
+constexpr std::uint32_t own_square_offset = 0;
+constexpr std::uint32_t opponent_square_offset = own_square_offset + square_count;
+constexpr std::uint32_t piece_left_offset = opponent_square_offset + square_count;
+constexpr std::uint32_t bias_index = piece_left_offset + static_cast<std::uint32_t>(piece_count);
+constexpr std::uint32_t value_size = bias_index + 1;
+
+// Five squares and at most one anchor per square, two features per anchor
+constexpr std::size_t max_move_features = 15;
+
+}
+
+// Indices of the features of a move, fixed size so that scoring every child doesn't allocate
+struct MoveFeatures {
+    std::array<std::uint32_t, features::max_move_features> indices;
+    std::size_t count{ 0 };
+
+    std::span<std::uint32_t const> get() const { return { indices.data(), count }; }
+};
+
+// ----------------------------------------------------------------------------
+
+// What the features of the moves of one position share: the frame of the mover and the
+// patterns around each of its anchors, computed once for all the moves
+class PositionFeatures {
+public:
+    explicit PositionFeatures(Game const& game);
+
+    // The move must be a legal move of the player to move, a pass has no features
+    MoveFeatures get_move_features(Move move) const;
+
+    // Appends the value features of the player
+    static void get_value_features(Game const& game, PlayerId player, std::vector<std::uint32_t>& indices);
+
+private:
+    PlayerId mover;
+    Bitboard anchors;
+    // Only meaningful on the anchors
+    std::array<std::uint16_t, square_count> patterns{};
+    std::array<std::uint16_t, square_count> key_indices{};
+};
+
+}
@@ -0,0 +1,245 @@
+#include "pch.h"
+#include "ModelTraining.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "Evaluation.h"
+#include "MoveGeneration.h"
+#include "MoveList.h"
+#include "Random.h"
+#include "RecordValidation.h"
+
+namespace blokus {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Relaxed loads and stores only: concurrent updates of a weight may be lost, never torn
+using SharedWeights = std::vector<std::atomic<float>>;
+
+float get_shared_dot(SharedWeights const& weights, std::span<std::uint32_t const> indices) {
+    float sum = 0.0f;
+    for (auto const index : indices) {
+        sum += weights[index].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+void add_shared(SharedWeights& weights, std::span<std::uint32_t const> indices, float delta) {
+    for (auto const index : indices) {
+        auto& weight = weights[index];
+        weight.store(weight.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+}
+
+struct Sums {
+    std::uint64_t positions{ 0 };
+    double policy_loss{ 0.0 };
+    std::uint64_t policy_hits{ 0 };
+    double value_loss{ 0.0 };
+};
+
+class Trainer {
+public:
+    Trainer(SharedWeights& policy, SharedWeights& value, float policy_rate, float value_rate)
+        : policy(policy)
+        , value(value)
+        , policy_rate(policy_rate)
+        , value_rate(value_rate)
+    {}
+
+    void train(GameRecord const& record) {
+        // The targets are the final rewards, the game is replayed once to get them
+        auto game = Game::CreateNew(record.players);
+        for (auto const move : record.moves) {
+            game.apply(move);
+        }
+        auto const rewards = get_rewards(game);
+
+        game = Game::CreateNew(record.players);
+        for (auto const move : record.moves) {
+            generate_moves(game, moves);
+            if (moves.size() > 1) {
+                train_policy(game, move);
+                train_value(game, rewards[game.get_current_player_index()]);
+                ++sums.positions;
+            }
+            game.apply(move);
+        }
+    }
+
+    Sums const& get_sums() const { return sums; }
+
+private:
+    void train_policy(Game const& game, Move played) {
+        PositionFeatures const position(game);
+        move_features.clear();
+        scores.clear();
+        std::size_t played_index = moves.size();
+        auto max_score = -std::numeric_limits<float>::infinity();
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            if (moves[i] == played) {
+                played_index = i;
+            }
+            auto const& features = move_features.emplace_back(position.get_move_features(moves[i]));
+            scores.push_back(get_shared_dot(policy, features.get()));
+            max_score = std::max(max_score, scores.back());
+        }
+        if (played_index == moves.size()) {
+            return;
+        }
+
+        float sum = 0.0f;
+        for (auto& score : scores) {
+            score = std::exp(score - max_score);
+            sum += score;
+        }
+        auto best = std::size_t{ 0 };
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            auto const probability = scores[i] / sum;
+            auto const gradient = probability - (i == played_index ? 1.0f : 0.0f);
+            // Most moves are unlikely, their updates are too small to matter
+            if (std::abs(gradient) > 1e-4f) {
+                add_shared(policy, move_features[i].get(), -policy_rate * gradient);
+            }
+            best = scores[i] > scores[best] ? i : best;
+        }
+        sums.policy_loss -= std::log(std::max(scores[played_index] / sum, 1e-30f));
+        sums.policy_hits += best == played_index;
+    }
+
+    void train_value(Game const& game, float reward) {
+        value_features.clear();
+        PositionFeatures::get_value_features(game, game.get_current_player(), value_features);
+        auto const prediction = 1.0f / (1.0f + std::exp(-get_shared_dot(value, value_features)));
+        // Gradient of the cross entropy of the logistic output
+        add_shared(value, value_features, -value_rate * (prediction - reward));
+        sums.value_loss += (prediction - reward) * (prediction - reward);
+    }
+
+    SharedWeights& policy;
+    SharedWeights& value;
+    float policy_rate;
+    float value_rate;
+
+    MoveList moves;
+    std::vector<MoveFeatures> move_features;
+    std::vector<float> scores;
+    std::vector<std::uint32_t> value_features;
+    Sums sums;
+};
+
+SharedWeights to_shared(std::span<float const> weights) {
+    SharedWeights result(weights.size());
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        result[i].store(weights[i], std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void from_shared(SharedWeights const& shared, std::span<float> weights) {
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        weights[i] = shared[i].load(std::memory_order_relaxed);
+    }
+}
+
+// Indices of the records that replay as valid games, the moves of the others could be anything
+std::vector<std::size_t> get_valid_records(std::span<GameRecord const> records, ThreadPool& pool) {
+    auto const chunk_count = std::min(records.size(), pool.get_thread_count() * 4);
+    std::vector<std::future<std::vector<std::size_t>>> chunks;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        auto const first = records.size() * chunk / chunk_count;
+        auto const last = records.size() * (chunk + 1) / chunk_count;
+        chunks.push_back(pool.submit([records, first, last] {
+            std::vector<std::size_t> valid;
+            for (auto i = first; i < last; ++i) {
+                if (validate_record(records[i]).status == RecordStatus::Valid) {
+                    valid.push_back(i);
+                }
+            }
+            return valid;
+        }));
+    }
+
+    std::vector<std::size_t> valid;
+    for (auto& chunk : chunks) {
+        auto const indices = chunk.get();
+        valid.insert(valid.end(), indices.begin(), indices.end());
+    }
+    return valid;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+void train_linear_model(LinearModel& model, std::span<GameRecord const> records, ThreadPool& pool,
+    TrainingConfig const& config, EpochCallback const& on_epoch)
+{
+    auto policy = to_shared(model.get_policy_weights());
+    auto value = to_shared(model.get_value_weights());
+
+    Random random(config.seed);
+    auto order = get_valid_records(records, pool);
+    auto const skipped_games = records.size() - order.size();
+    auto policy_rate = config.policy_learning_rate;
+    auto value_rate = config.value_learning_rate;
+
+    for (std::size_t epoch = 0; epoch < config.epochs; ++epoch) {
+        auto const start = Clock::now();
+        for (auto i = order.size(); i > 1; --i) {
+            std::swap(order[i - 1], order[random.uniform(static_cast<std::uint32_t>(i))]);
+        }
+
+        // A few chunks per thread even out the game lengths
+        auto const chunk_count = std::min(order.size(), pool.get_thread_count() * 4);
+        std::vector<std::future<Sums>> chunks;
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            auto const first = order.size() * chunk / chunk_count;
+            auto const last = order.size() * (chunk + 1) / chunk_count;
+            chunks.push_back(pool.submit([&, first, last] {
+                Trainer trainer(policy, value, policy_rate, value_rate);
+                for (auto i = first; i < last; ++i) {
+                    trainer.train(records[order[i]]);
+                }
+                return trainer.get_sums();
+            }));
+        }
+
+        Sums total;
+        for (auto& chunk : chunks) {
+            auto const sums = chunk.get();
+            total.positions += sums.positions;
+            total.policy_loss += sums.policy_loss;
+            total.policy_hits += sums.policy_hits;
+            total.value_loss += sums.value_loss;
+        }
+
+        if (on_epoch) {
+            auto const positions = static_cast<double>(std::max<std::uint64_t>(total.positions, 1));
+            EpochStatistics statistics;
+            statistics.epoch = epoch;
+            statistics.positions = total.positions;
+            statistics.skipped_games = skipped_games;
+            statistics.policy_loss = total.policy_loss / positions;
+            statistics.policy_accuracy = static_cast<double>(total.policy_hits) / positions;
+            statistics.value_loss = total.value_loss / positions;
+            statistics.elapsed = Clock::now() - start;
+            on_epoch(statistics);
+        }
+        policy_rate *= config.decay;
+        value_rate *= config.decay;
+    }
+
+    from_shared(policy, model.get_policy_weights());
+    from_shared(value, model.get_value_weights());
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "GameRecord.h"
+#include "LinearModel.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct TrainingConfig {
+    std::size_t epochs{ 4 };
+    float policy_learning_rate{ 0.05f };
+    // Lower than the policy one, a position has a hundred value features against ten per move
+    float value_learning_rate{ 0.005f };
+    // Applied to both learning rates after each epoch
+    float decay{ 0.7f };
+    std::uint64_t seed{ 0 };
+};
+
+// Measured on the fly while training, so the weights move during the measure
+struct EpochStatistics {
+    std::size_t epoch{ 0 };
+    // Positions with more than one legal move, the others teach nothing
+    std::uint64_t positions{ 0 };
+    // Records left out for not replaying as valid games
+    std::uint64_t skipped_games{ 0 };
+    // Mean cross entropy of the moves played
+    double policy_loss{ 0.0 };
+    // Fraction of the positions where the move played had the highest prior
+    double policy_accuracy{ 0.0 };
+    // Mean squared error of the predicted reward of the player to move
+    double value_loss{ 0.0 };
+    std::chrono::nanoseconds elapsed{ 0 };
+};
+
+using EpochCallback = std::function<void(EpochStatistics const&)>;
+
+// Stochastic gradient descent on the moves played and the final rewards of the games, lock free on
+// every thread of the pool (Hogwild): the threads update the shared weights without synchronization
+// and may overwrite each other's updates, which the sparse features make rare.
+// Each epoch replays the games in a new random order. The records are checked with validate_record
+// first, the invalid ones are skipped.
+void train_linear_model(LinearModel& model, std::span<GameRecord const> records, ThreadPool& pool,
+    TrainingConfig const& config = {}, EpochCallback const& on_epoch = {});
+
+}
@@ -0,0 +1,30 @@
+#include "pch.h"
+#include "Move.h"
+
+namespace blokus {
+
+PieceId get_piece(Move const& move) {
+    return get_orientation(move.get_orientation()).piece;
+}
+
+OrientedPiece const& get_oriented_piece(Move const& move) {
+    return get_oriented_piece(move.get_orientation());
+}
+
+Position get_position(Move const& move) {
+    return to_position(move.get_square());
+}
+
+Bitboard get_footprint(Move const& move) {
+    auto const& orientation = get_orientation(move.get_orientation());
+    auto const square = move.get_square();
+
+    Bitboard result;
+    for (int i = 0; i < orientation.size; ++i) {
+        auto const& offset = orientation.squares[i];
+        result.set(static_cast<Square>(square + offset.y * board_size + offset.x));
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include "Bitboard.h"
+#include "Board.h"
+#include "Orientation.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// A move is a piece orientation placed at a square, packed in 16 bits:
+// | orientation (7 bits, 0..90) | square (9 bits, 0..399) |
+// The square is where the (0, 0) offset of the orientation lands on the board.
+// The pass move uses the otherwise unused all ones value.
+class Move {
+public:
+    static constexpr int square_bits = 9;
+    static constexpr std::uint16_t square_mask = (1 << square_bits) - 1;
+
+    static_assert(square_count <= (1 << square_bits));
+    static_assert(orientation_count <= (1 << (16 - square_bits)));
+
+    // Left uninitialized so that move arrays don't pay for zeroing
+    Move() = default;
+
+    constexpr Move(OrientationIndex orientation, Square square)
+        : value(static_cast<std::uint16_t>((orientation << square_bits) | square))
+    {
+        assert(orientation < orientation_count);
+        assert(square < square_count);
+    }
+
+    static constexpr Move pass() { return from_value(0xFFFF); }
+
+    static constexpr Move from_value(std::uint16_t value) {
+        Move move;
+        move.value = value;
+        return move;
+    }
+
+    constexpr bool is_pass() const { return value == 0xFFFF; }
+
+    constexpr OrientationIndex get_orientation() const {
+        assert(!is_pass());
+        return static_cast<OrientationIndex>(value >> square_bits);
+    }
+
+    constexpr Square get_square() const {
+        assert(!is_pass());
+        return static_cast<Square>(value & square_mask);
+    }
+
+    constexpr std::uint16_t get_value() const { return value; }
+
+private:
+    std::uint16_t value;
+
+    friend constexpr bool operator==(Move const& lhs, Move const& rhs) { return lhs.value == rhs.value; }
+    friend constexpr auto operator<=>(Move const& lhs, Move const& rhs) { return lhs.value <=> rhs.value; }
+};
+
+static_assert(sizeof(Move) == 2);
+
+// ----------------------------------------------------------------------------
+
+PieceId get_piece(Move const& move);
+OrientedPiece const& get_oriented_piece(Move const& move);
+Position get_position(Move const& move);
+
+// Board squares covered by the move
+Bitboard get_footprint(Move const& move);
+
+}
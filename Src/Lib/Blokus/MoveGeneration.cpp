@@ -0,0 +1,212 @@
+#include "pch.h"
+#include "MoveGeneration.h"
+
+#include <bit>
+#include <bitset>
+
+#include "AnchorPattern.h"
+
+namespace blokus {
+
+namespace {
+
+// Remaining pieces that may fit at the anchor, the others are skipped without trying their placements
+std::uint32_t get_candidate_pieces(std::uint32_t remaining_pieces, PatternKey key) {
+    return remaining_pieces & get_fitting_pieces(key).get_bits();
+}
+
+// The key of each anchor comes from get_key(forbidden, anchor)
+template<class GetKey>
+void generate_moves(Game const& game, MoveList& moves, GetKey const& get_key) {
+    moves.clear();
+    if (game.is_over()) {
+        return;
+    }
+
+    auto const player = game.get_current_player();
+    auto const remaining = game.get_remaining_pieces(player).get_bits();
+    auto const forbidden = game.get_forbidden(player);
+    auto const anchors = game.get_anchors(player);
+
+    // The same placement can cover several anchors, only check it once
+    std::bitset<orientation_count * square_count> checked;
+
+    anchors.for_each([&](Square anchor) {
+        auto const anchor_position = to_position(anchor);
+        for (auto pieces = get_candidate_pieces(remaining, get_key(forbidden, anchor)); pieces != 0; pieces &= pieces - 1) {
+            auto const piece = static_cast<PieceId>(std::countr_zero(pieces));
+            auto const range = get_orientation_range(piece);
+            for (auto index = range.first; index < range.last; ++index) {
+                auto const& orientation = get_orientation(index);
+                for (int i = 0; i < orientation.size; ++i) {
+                    Square origin;
+                    if (!get_origin(orientation, orientation.squares[i], anchor_position, origin)) {
+                        continue;
+                    }
+                    auto const key = index * square_count + origin;
+                    if (checked.test(key)) {
+                        continue;
+                    }
+                    checked.set(key);
+                    if (fits(index, origin, forbidden)) {
+                        moves.push_back({ index, origin });
+                    }
+                }
+            }
+        }
+    });
+
+    if (moves.empty()) {
+        moves.push_back(Move::pass());
+    }
+}
+
+}
+
+bool get_origin(Orientation const& orientation, Offset const& offset, Position const& anchor, Square& origin) {
+    auto const x = anchor.get_x() - offset.x;
+    auto const y = anchor.get_y() - offset.y;
+    if (x < 0 || y < 0 || x + orientation.width > board_size || y + orientation.height > board_size) {
+        return false;
+    }
+    origin = to_square({ x, y });
+    return true;
+}
+
+bool fits(OrientationIndex orientation_index, Square square, Bitboard const& forbidden) {
+    auto const& orientation = get_orientation(orientation_index);
+    for (int i = 0; i < orientation.size; ++i) {
+        auto const& offset = orientation.squares[i];
+        if (forbidden.test(static_cast<Square>(square + offset.y * board_size + offset.x))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void generate_moves(Game const& game, MoveList& moves) {
+    generate_moves(game, moves, [](Bitboard const& forbidden, Square anchor) {
+        return get_pattern_key(forbidden, anchor);
+    });
+}
+
+void generate_moves(Game const& game, PatternTracker const& patterns, MoveList& moves) {
+    generate_moves(game, moves, [&game, &patterns](Bitboard const&, Square anchor) {
+        return patterns.get_key(game.get_current_player(), anchor);
+    });
+}
+
+bool is_legal(Game const& game, Move const& move) {
+    if (game.is_over()) {
+        return false;
+    }
+
+    if (move.is_pass()) {
+        return !has_legal_move(game);
+    }
+
+    // Moves can come from the outside, validate the encoding itself first
+    if (move.get_orientation() >= orientation_count || move.get_square() >= square_count) {
+        return false;
+    }
+
+    auto const player = game.get_current_player();
+    auto const& orientation = get_orientation(move.get_orientation());
+    if (!game.get_remaining_pieces(player).contains(orientation.piece)) {
+        return false;
+    }
+
+    auto const origin = get_position(move);
+    if (origin.get_x() + orientation.width > board_size || origin.get_y() + orientation.height > board_size) {
+        return false;
+    }
+
+    auto const footprint = get_footprint(move);
+    return
+        (footprint & game.get_forbidden(player)).none() &&
+        (footprint & game.get_anchors(player)).any();
+}
+
+bool has_legal_move(Game const& game) {
+    if (game.is_over()) {
+        return false;
+    }
+    auto const move = MoveSource(game).next();
+    return move && !move->is_pass();
+}
+
+// ----------------------------------------------------------------------------
+
+MoveSource::MoveSource(Game const& game) {
+    if (game.is_over()) {
+        finished = true;
+        return;
+    }
+    auto const player = game.get_current_player();
+    forbidden = game.get_forbidden(player);
+    anchors = game.get_anchors(player);
+    pending_anchors = anchors;
+    remaining_pieces = game.get_remaining_pieces(player).get_bits();
+    next_anchor();
+}
+
+bool MoveSource::next_anchor() {
+    if (pending_anchors.none()) {
+        return false;
+    }
+    anchor = pending_anchors.lowest();
+    pending_anchors.reset(anchor);
+    pending_pieces = get_candidate_pieces(remaining_pieces, get_pattern_key(forbidden, anchor));
+    return next_piece() || next_anchor();
+}
+
+bool MoveSource::next_piece() {
+    if (pending_pieces == 0) {
+        return false;
+    }
+    auto const piece = static_cast<PieceId>(std::countr_zero(pending_pieces));
+    pending_pieces &= pending_pieces - 1;
+    auto const range = get_orientation_range(piece);
+    orientation = range.first;
+    orientation_end = range.last;
+    offset = 0;
+    orientation_size = get_orientation(orientation).size;
+    return true;
+}
+
+std::optional<Move> MoveSource::next() {
+    while (!finished) {
+        auto const anchor_position = to_position(anchor);
+        while (offset < orientation_size) {
+            auto const& shape = get_orientation(orientation);
+            Square origin;
+            if (!get_origin(shape, shape.squares[offset++], anchor_position, origin)) {
+                continue;
+            }
+            // A placement covering several anchors is produced at the first of them, like generate_moves does
+            auto placeable = true;
+            for (int i = 0; i < shape.size && placeable; ++i) {
+                auto const square = static_cast<Square>(origin + shape.squares[i].y * board_size + shape.squares[i].x);
+                placeable = !forbidden.test(square) && !(square < anchor && anchors.test(square));
+            }
+            if (placeable) {
+                produced = true;
+                return Move{ orientation, origin };
+            }
+        }
+
+        if (++orientation < orientation_end) {
+            offset = 0;
+            orientation_size = get_orientation(orientation).size;
+        }
+        else if (!next_piece() && !next_anchor()) {
+            finished = true;
+            if (!produced) {
+                return Move::pass();
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+}
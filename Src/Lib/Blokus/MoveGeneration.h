@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "AnchorPattern.h"
+#include "Bitboard.h"
+#include "Game.h"
+#include "Move.h"
+#include "MoveList.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// All the legal moves of the current player, or only the pass move when there is none. Only the
+// first MoveList::capacity moves are kept.
+void generate_moves(Game const& game, MoveList& moves);
+// Same, with the pattern keys of the anchors read from a tracker following the game
+void generate_moves(Game const& game, PatternTracker const& patterns, MoveList& moves);
+
+bool is_legal(Game const& game, Move const& move);
+
+// Whether the current player can place a piece, stops at the first one found
+bool has_legal_move(Game const& game);
+
+// Whether the orientation fits with its (0, 0) offset at the square, given the forbidden squares
+bool fits(OrientationIndex orientation, Square square, Bitboard const& forbidden);
+
+// Origin of the orientation when its offset lands on the anchor, false if the piece leaves the board
+bool get_origin(Orientation const& orientation, Offset const& offset, Position const& anchor, Square& origin);
+
+// ----------------------------------------------------------------------------
+
+// Produces the moves of generate_moves one at a time and in the same order, for the consumers that
+// only need the first few. The state is a position in the anchors x pieces x orientations x squares
+// loops, so stopping early skips the rest of the work.
+// The game must outlive the source and stay unchanged while it's used.
+class MoveSource {
+public:
+    explicit MoveSource(Game const& game);
+
+    // Next legal move, the pass move when no piece fits at all, nothing once every move was produced
+    std::optional<Move> next();
+
+private:
+    bool next_anchor();
+    bool next_piece();
+
+    Bitboard forbidden;
+    Bitboard anchors;
+    // Anchors not visited yet
+    Bitboard pending_anchors;
+    std::uint32_t remaining_pieces{ 0 };
+
+    Square anchor{ 0 };
+    // Pieces not tried yet among the ones that may fit at the anchor
+    std::uint32_t pending_pieces{ 0 };
+    OrientationIndex orientation{ 0 };
+    OrientationIndex orientation_end{ 0 };
+    // Square of the orientation put on the anchor
+    int offset{ 0 };
+    int orientation_size{ 0 };
+
+    bool produced{ false };
+    bool finished{ false };
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+#include "Move.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Fixed capacity, stack allocated, list of moves.
+// The capacity is not a proven bound: a move is any of the 91 orientations at any of the 400
+// squares, which no stack list can hold. Random games stay under 1000 moves, 4096 moves keeps a
+// wide margin and the whole list in 8 KiB, well inside L1. A position with more moves keeps its
+// first 4096, all legal, the others are dropped without writing past the list.
+class MoveList {
+public:
+    static constexpr std::size_t capacity = 4096;
+
+    using value_type = Move;
+    using iterator = Move*;
+    using const_iterator = Move const*;
+
+    MoveList() = default;
+
+    MoveList(MoveList const& other)
+        : count(other.count)
+    {
+        std::copy(other.begin(), other.end(), moves.begin());
+    }
+
+    MoveList& operator=(MoveList const& other) {
+        count = other.count;
+        std::copy(other.begin(), other.end(), moves.begin());
+        return *this;
+    }
+
+    // Dropped once the list is full
+    void push_back(Move const& move) {
+        if (count < capacity) {
+            moves[count++] = move;
+        }
+    }
+
+    void clear() { count = 0; }
+
+    // Only shrinks, used to keep the best moves after ordering
+    void resize(std::size_t size) {
+        assert(size <= count);
+        count = size;
+    }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](std::size_t index) { assert(index < count); return moves[index]; }
+    Move const& operator[](std::size_t index) const { assert(index < count); return moves[index]; }
+
+    iterator begin() { return moves.data(); }
+    iterator end() { return moves.data() + count; }
+    const_iterator begin() const { return moves.data(); }
+    const_iterator end() const { return moves.data() + count; }
+
+private:
+    std::array<Move, capacity> moves;
+    std::size_t count{ 0 };
+};
+
+}
@@ -0,0 +1,207 @@
+#include "pch.h"
+#include "MoveOrdering.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <optional>
+
+namespace blokus {
+
+namespace {
+
+constexpr int size_weight = 8;
+constexpr int created_anchor_weight = 2;
+constexpr int blocked_anchor_weight = 2;
+// Per piece the owner of a blocked anchor could have placed there
+constexpr int blocked_piece_weight = 1;
+constexpr int max_static_score = 255;
+
+// Above any history (32 bits shifted by 8) and static score (8 bits), the move goes below all of them
+constexpr std::uint64_t killer_key = std::uint64_t{ 1 } << 46;
+
+}
+
+StaticScorer::StaticScorer(Game const& game) {
+    prepare(game, [](PlayerId, Bitboard const& opponent_forbidden, Square anchor) {
+        return get_pattern_key(opponent_forbidden, anchor);
+    });
+}
+
+StaticScorer::StaticScorer(Game const& game, PatternTracker const& patterns) {
+    prepare(game, [&patterns](PlayerId opponent, Bitboard const&, Square anchor) {
+        return patterns.get_key(opponent, anchor);
+    });
+}
+
+template<class GetKey>
+void StaticScorer::prepare(Game const& game, GetKey const& get_key) {
+    auto const player = game.get_current_player();
+    forbidden = game.get_forbidden(player);
+    anchors = game.get_anchors(player);
+    for (auto const other : game.get_players()) {
+        if (other == player || game.is_finished(other)) {
+            continue;
+        }
+        auto const other_anchors = game.get_anchors(other);
+        auto const other_forbidden = game.get_forbidden(other);
+        auto const remaining = game.get_remaining_pieces(other).get_bits();
+        other_anchors.for_each([&](Square anchor) {
+            auto const fitting = std::popcount(remaining & get_fitting_pieces(get_key(other, other_forbidden, anchor)).get_bits());
+            // Anchors shared by several opponents add up
+            anchor_pieces[anchor] = static_cast<std::uint8_t>((opponent_anchors.test(anchor) ? anchor_pieces[anchor] : 0) + fitting);
+        });
+        opponent_anchors |= other_anchors;
+    }
+}
+
+int StaticScorer::score(Move const& move) const {
+    if (move.is_pass()) {
+        return 0;
+    }
+    auto const footprint = get_footprint(move);
+    // Same as get_anchors after the move, without the anchors the player already had
+    auto const created = get_corner_neighbours(footprint) & ~forbidden & ~get_edge_neighbours(footprint) & ~anchors;
+    auto const blocked = footprint & opponent_anchors;
+    auto blocked_pieces = 0;
+    blocked.for_each([this, &blocked_pieces](Square square) {
+        blocked_pieces += anchor_pieces[square];
+    });
+    return std::min(max_static_score,
+        size_weight * footprint.count() +
+        created_anchor_weight * created.count() +
+        blocked_anchor_weight * blocked.count() +
+        blocked_piece_weight * blocked_pieces);
+}
+
+// ----------------------------------------------------------------------------
+
+HistoryTable::HistoryTable()
+    : counts(player_id_count * piece_count * square_count, 0)
+{}
+
+std::size_t HistoryTable::get_index(PlayerId player, Move const& move) {
+    return (to_index(player) * piece_count + to_index(get_piece(move))) * square_count + move.get_square();
+}
+
+void HistoryTable::add(PlayerId player, Move const& move, int depth) {
+    if (move.is_pass()) {
+        return;
+    }
+    auto& count = counts[get_index(player, move)];
+    // Saturates instead of wrapping around
+    auto const bonus = static_cast<std::uint32_t>(depth * depth);
+    constexpr auto max_count = std::numeric_limits<std::uint32_t>::max();
+    count = count > max_count - bonus ? max_count : count + bonus;
+}
+
+std::uint32_t HistoryTable::get(PlayerId player, Move const& move) const {
+    return move.is_pass() ? 0 : counts[get_index(player, move)];
+}
+
+void HistoryTable::age() {
+    for (auto& count : counts) {
+        count /= 2;
+    }
+}
+
+void HistoryTable::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+}
+
+// ----------------------------------------------------------------------------
+
+void KillerTable::add(std::size_t ply, Move const& move) {
+    if (ply >= slots.size()) {
+        std::array<Move, slot_count> empty;
+        empty.fill(Move::pass());
+        slots.resize(ply + 1, empty);
+    }
+    auto& killers = slots[ply];
+    if (killers[0] == move) {
+        return;
+    }
+    std::move_backward(killers.begin(), killers.end() - 1, killers.end());
+    killers[0] = move;
+}
+
+std::size_t KillerTable::find(std::size_t ply, Move const& move) const {
+    if (ply >= slots.size() || move.is_pass()) {
+        return slot_count;
+    }
+    auto const& killers = slots[ply];
+    return static_cast<std::size_t>(std::find(killers.begin(), killers.end(), move) - killers.begin());
+}
+
+// ----------------------------------------------------------------------------
+
+MoveOrderer::MoveOrderer(MoveOrderingConfig config)
+    : config(config)
+{
+    keys.reserve(MoveList::capacity);
+}
+
+void MoveOrderer::order(Game const& game, MoveList& moves, std::size_t ply) {
+    if (moves.size() < 2 || (!config.static_score && !config.killers && !config.history)) {
+        return;
+    }
+    std::optional<StaticScorer> scorer;
+    if (config.static_score) {
+        scorer.emplace(game);
+    }
+    order(game, scorer, moves, ply);
+}
+
+void MoveOrderer::order(Game const& game, PatternTracker const& patterns, MoveList& moves, std::size_t ply) {
+    if (moves.size() < 2 || (!config.static_score && !config.killers && !config.history)) {
+        return;
+    }
+    std::optional<StaticScorer> scorer;
+    if (config.static_score) {
+        scorer.emplace(game, patterns);
+    }
+    order(game, scorer, moves, ply);
+}
+
+void MoveOrderer::order(Game const& game, std::optional<StaticScorer> const& scorer, MoveList& moves, std::size_t ply) {
+    auto const player = game.get_current_player();
+    keys.clear();
+    for (auto const move : moves) {
+        std::uint64_t key = 0;
+        if (config.killers) {
+            if (auto const slot = killers.find(ply, move); slot < KillerTable::slot_count) {
+                key += killer_key >> slot;
+            }
+        }
+        if (config.history) {
+            key += std::uint64_t{ history.get(player, move) } << 8;
+        }
+        if (scorer) {
+            key += static_cast<std::uint64_t>(scorer->score(move));
+        }
+        // Inverted so that equal keys keep the smaller move value first
+        keys.push_back(key << 16 | static_cast<std::uint16_t>(~move.get_value()));
+    }
+
+    std::sort(keys.begin(), keys.end(), std::greater<>{});
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        moves[i] = Move::from_value(static_cast<std::uint16_t>(~keys[i]));
+    }
+}
+
+void MoveOrderer::add_cutoff(Game const& game, Move const& move, std::size_t ply, int depth) {
+    if (config.killers) {
+        killers.add(ply, move);
+    }
+    if (config.history) {
+        history.add(game.get_current_player(), move, depth);
+    }
+}
+
+void MoveOrderer::start_search() {
+    history.age();
+    killers.clear();
+}
+
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "AnchorPattern.h"
+#include "Bitboard.h"
+#include "Game.h"
+#include "Move.h"
+#include "MoveList.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct MoveOrderingConfig {
+    bool static_score{ true };
+    bool killers{ true };
+    bool history{ true };
+};
+
+// ----------------------------------------------------------------------------
+
+// Estimate of a move before any search: its size, the anchors it creates for the player and the
+// anchors of the opponents it takes, each one worth the pieces its owner could still place there.
+// Prepared once per position and then applied to each move.
+class StaticScorer {
+public:
+    explicit StaticScorer(Game const& game);
+    // Same, with the pattern keys of the opponent anchors read from a tracker following the game
+    StaticScorer(Game const& game, PatternTracker const& patterns);
+
+    // Fits in 8 bits
+    int score(Move const& move) const;
+
+private:
+    // The key of each opponent anchor comes from get_key(opponent, forbidden to the opponent, anchor)
+    template<class GetKey>
+    void prepare(Game const& game, GetKey const& get_key);
+
+    Bitboard forbidden;
+    Bitboard anchors;
+    Bitboard opponent_anchors;
+    // Pieces the opponents have left that fit at each of their anchors, only meaningful on the anchors
+    std::array<std::uint8_t, square_count> anchor_pieces{};
+};
+
+// ----------------------------------------------------------------------------
+
+// Moves that caused cutoffs, by player, piece and square, weighted by the depth searched below them
+class HistoryTable {
+public:
+    HistoryTable();
+
+    void add(PlayerId player, Move const& move, int depth);
+    std::uint32_t get(PlayerId player, Move const& move) const;
+
+    // Halves every entry, so that the previous searches count less than the current one
+    void age();
+    void clear();
+
+private:
+    static std::size_t get_index(PlayerId player, Move const& move);
+
+    std::vector<std::uint32_t> counts;
+};
+
+// ----------------------------------------------------------------------------
+
+// The last moves that caused a cutoff at each ply of the search, often good in the sibling positions
+class KillerTable {
+public:
+    static constexpr std::size_t slot_count = 2;
+
+    void add(std::size_t ply, Move const& move);
+    // Slot of the move at the ply, slot_count when it isn't a killer
+    std::size_t find(std::size_t ply, Move const& move) const;
+
+    void clear() { slots.clear(); }
+
+private:
+    std::vector<std::array<Move, slot_count>> slots;
+};
+
+// ----------------------------------------------------------------------------
+
+// Sorts the moves of a position, killers first, then by history and static score
+class MoveOrderer {
+public:
+    explicit MoveOrderer(MoveOrderingConfig config = {});
+
+    // The ply counts from the root of the search
+    void order(Game const& game, MoveList& moves, std::size_t ply);
+    // Same, with the pattern keys read from a tracker following the game
+    void order(Game const& game, PatternTracker const& patterns, MoveList& moves, std::size_t ply);
+    void add_cutoff(Game const& game, Move const& move, std::size_t ply, int depth);
+
+    // Keeps an aged history, the killers belong to the positions of the previous search
+    void start_search();
+
+    MoveOrderingConfig const& get_config() const { return config; }
+
+private:
+    void order(Game const& game, std::optional<StaticScorer> const& scorer, MoveList& moves, std::size_t ply);
+
+    MoveOrderingConfig config;
+    HistoryTable history;
+    KillerTable killers;
+    // Sort keys, with the move in the low bits
+    std::vector<std::uint64_t> keys;
+};
+
+}
@@ -0,0 +1,234 @@
+#include "pch.h"
+#include "MoveQuery.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace blokus {
+
+namespace {
+
+// Rows filtered at once, the selection stays in the L1 cache
+constexpr std::size_t block_size = 4096;
+// Keys of narrow columns index a vector, the others go through a hash map
+constexpr std::int64_t dense_key_limit = 1 << 16;
+
+using Selection = std::array<std::uint8_t, block_size>;
+
+struct Accumulator {
+    std::uint64_t count{ 0 };
+    std::int64_t sum{ 0 };
+    std::int64_t min{ std::numeric_limits<std::int64_t>::max() };
+    std::int64_t max{ std::numeric_limits<std::int64_t>::min() };
+
+    void add(std::int64_t value) {
+        ++count;
+        sum += value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(Accumulator const& other) {
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+// Accumulators of the groups seen by one task
+struct Groups {
+    std::int64_t key_offset{ 0 };
+    std::vector<Accumulator> dense;
+    std::unordered_map<std::int64_t, Accumulator> sparse;
+
+    Accumulator& get(std::int64_t key) {
+        auto const index = key - key_offset;
+        if (index >= 0 && index < static_cast<std::int64_t>(dense.size())) {
+            return dense[static_cast<std::size_t>(index)];
+        }
+        return sparse[key];
+    }
+};
+
+// Kept branch free and as narrow as the column allows so that the compiler vectorizes the loop
+template<class T, class Compare>
+void filter(std::span<T const> values, std::int64_t value, Compare compare, Selection& selection) {
+    using Wide = std::conditional_t<sizeof(T) < sizeof(std::int32_t), std::int32_t, std::int64_t>;
+    // Just outside the range of the column when beyond it, which keeps the result of every comparison
+    auto const bounded = static_cast<Wide>(std::clamp<std::int64_t>(value,
+        std::int64_t{ std::numeric_limits<T>::min() } - 1,
+        std::int64_t{ std::numeric_limits<T>::max() } + 1));
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        selection[i] &= static_cast<std::uint8_t>(compare(static_cast<Wide>(values[i]), bounded));
+    }
+}
+
+template<class T>
+void filter(std::span<T const> values, Condition const& condition, Selection& selection) {
+    switch (condition.comparison) {
+    case Comparison::Equal:         filter(values, condition.value, std::equal_to<>{}, selection); break;
+    case Comparison::NotEqual:      filter(values, condition.value, std::not_equal_to<>{}, selection); break;
+    case Comparison::Less:          filter(values, condition.value, std::less<>{}, selection); break;
+    case Comparison::LessEqual:     filter(values, condition.value, std::less_equal<>{}, selection); break;
+    case Comparison::Greater:       filter(values, condition.value, std::greater<>{}, selection); break;
+    case Comparison::GreaterEqual:  filter(values, condition.value, std::greater_equal<>{}, selection); break;
+    }
+}
+
+void scan(MoveTable const& table, MoveQuery const& query, std::size_t begin, std::size_t end, Groups& groups) {
+    Selection selection;
+    for (auto block = begin; block < end; block += block_size) {
+        auto const size = std::min(block_size, end - block);
+        std::fill_n(selection.begin(), size, std::uint8_t{ 1 });
+        for (auto const& condition : query.conditions) {
+            table.visit(condition.column, [&](auto column) {
+                filter(column.subspan(block, size), condition, selection);
+            });
+        }
+
+        // Without grouping the key column is a constant, read from no column at all
+        auto const accumulate = [&](auto keys) {
+            table.visit(query.aggregated, [&](auto values) {
+                for (std::size_t i = 0; i < size; ++i) {
+                    if (selection[i] != 0) {
+                        auto const key = keys.empty() ? 0 : static_cast<std::int64_t>(keys[block + i]);
+                        groups.get(key).add(static_cast<std::int64_t>(values[block + i]));
+                    }
+                }
+            });
+        };
+        if (query.group_by) {
+            table.visit(*query.group_by, accumulate);
+        }
+        else {
+            accumulate(std::span<std::uint8_t const>{});
+        }
+    }
+}
+
+// Smallest value and number of values of the column, for the dense accumulators
+std::pair<std::int64_t, std::int64_t> get_key_range(MoveTable const& table, std::optional<MoveColumn> group_by) {
+    if (!group_by) {
+        return { 0, 1 };
+    }
+    switch (*group_by) {
+    case MoveColumn::Game:      return { 0, std::min<std::int64_t>(table.get_game_count(), dense_key_limit) };
+    case MoveColumn::Square:    return { 0, square_count };
+    case MoveColumn::Score:     return { std::numeric_limits<std::int8_t>::min(), 256 };
+    default:                    return { 0, 256 };
+    }
+}
+
+double get_value(Accumulator const& accumulator, Aggregation aggregation) {
+    switch (aggregation) {
+    case Aggregation::Count:    return static_cast<double>(accumulator.count);
+    case Aggregation::Sum:      return static_cast<double>(accumulator.sum);
+    case Aggregation::Min:      return static_cast<double>(accumulator.min);
+    case Aggregation::Max:      return static_cast<double>(accumulator.max);
+    case Aggregation::Mean:     return static_cast<double>(accumulator.sum) / static_cast<double>(accumulator.count);
+    }
+    return 0.0;
+}
+
+}
+
+std::optional<Condition> parse_condition(std::string_view text) {
+    constexpr std::array<std::pair<std::string_view, Comparison>, 7> operators{ {
+        // Two character operators first, "<" would match the start of "<="
+        { "!=", Comparison::NotEqual },
+        { "<=", Comparison::LessEqual },
+        { ">=", Comparison::GreaterEqual },
+        { "==", Comparison::Equal },
+        { "=", Comparison::Equal },
+        { "<", Comparison::Less },
+        { ">", Comparison::Greater },
+    } };
+
+    for (auto const& [symbol, comparison] : operators) {
+        auto const position = text.find(symbol);
+        if (position == std::string_view::npos) {
+            continue;
+        }
+        auto const column = parse_column_name(text.substr(0, position));
+        auto const value_text = text.substr(position + symbol.size());
+        if (!column) {
+            return std::nullopt;
+        }
+        if (*column == MoveColumn::Piece) {
+            if (auto const piece = parse_piece_name(value_text)) {
+                return Condition{ *column, comparison, static_cast<std::int64_t>(to_index(*piece)) };
+            }
+        }
+        std::int64_t value = 0;
+        auto const [end, error] = std::from_chars(value_text.data(), value_text.data() + value_text.size(), value);
+        if (error != std::errc{} || end != value_text.data() + value_text.size()) {
+            return std::nullopt;
+        }
+        return Condition{ *column, comparison, value };
+    }
+    return std::nullopt;
+}
+
+std::vector<QueryGroup> run_query(MoveTable const& table, MoveQuery const& query, ThreadPool& pool) {
+    auto const [key_offset, key_count] = get_key_range(table, query.group_by);
+
+    // A few ranges per thread so that a slow thread doesn't hold the others
+    auto const row_count = table.get_row_count();
+    auto const range_count = std::max<std::size_t>(pool.get_thread_count() * 4, 1);
+    auto const range_size = (row_count / range_count + block_size) / block_size * block_size;
+
+    std::vector<std::future<Groups>> tasks;
+    for (std::size_t begin = 0; begin < row_count; begin += range_size) {
+        auto const end = std::min(begin + range_size, row_count);
+        tasks.push_back(pool.submit([&table, &query, begin, end, key_offset, key_count] {
+            Groups groups;
+            groups.key_offset = key_offset;
+            groups.dense.resize(static_cast<std::size_t>(key_count));
+            scan(table, query, begin, end, groups);
+            return groups;
+        }));
+    }
+
+    Groups total;
+    total.key_offset = key_offset;
+    total.dense.resize(static_cast<std::size_t>(key_count));
+    for (auto& task : tasks) {
+        auto const groups = task.get();
+        for (std::size_t i = 0; i < groups.dense.size(); ++i) {
+            total.dense[i].merge(groups.dense[i]);
+        }
+        for (auto const& [key, accumulator] : groups.sparse) {
+            total.get(key).merge(accumulator);
+        }
+    }
+
+    std::vector<QueryGroup> result;
+    auto const add_group = [&result, &query](std::int64_t key, Accumulator const& accumulator) {
+        if (accumulator.count != 0) {
+            result.push_back({ key, accumulator.count, get_value(accumulator, query.aggregation) });
+        }
+    };
+    for (std::size_t i = 0; i < total.dense.size(); ++i) {
+        add_group(key_offset + static_cast<std::int64_t>(i), total.dense[i]);
+    }
+    for (auto const& [key, accumulator] : total.sparse) {
+        add_group(key, accumulator);
+    }
+    std::sort(result.begin(), result.end(), [](QueryGroup const& lhs, QueryGroup const& rhs) { return lhs.key < rhs.key; });
+    if (result.empty() && !query.group_by) {
+        result.push_back({});
+    }
+    return result;
+}
+
+}
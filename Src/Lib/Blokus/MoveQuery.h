@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "MoveTable.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+enum class Comparison : std::uint8_t { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual };
+
+struct Condition {
+    MoveColumn column;
+    Comparison comparison;
+    std::int64_t value;
+};
+
+enum class Aggregation : std::uint8_t { Count, Sum, Min, Max, Mean };
+
+// Rows matching every condition, grouped by the values of a column or all in one group,
+// e.g. how often the winners play 5l in their first 4 moves: piece = 20, turn < 4, rank = 0, count
+struct MoveQuery {
+    std::vector<Condition> conditions;
+    std::optional<MoveColumn> group_by;
+    Aggregation aggregation{ Aggregation::Count };
+    // Ignored by Count
+    MoveColumn aggregated{ MoveColumn::Score };
+};
+
+struct QueryGroup {
+    // Zero without grouping
+    std::int64_t key{ 0 };
+    std::uint64_t count{ 0 };
+    // Count as a number for Count
+    double value{ 0.0 };
+};
+
+// Parses "<column><comparison><value>" such as "turn<4" or "piece=5l", pieces can be given by name
+std::optional<Condition> parse_condition(std::string_view text);
+
+// Scans the table in blocks split across the pool, one group per distinct key in increasing key order
+std::vector<QueryGroup> run_query(MoveTable const& table, MoveQuery const& query, ThreadPool& pool);
+
+}
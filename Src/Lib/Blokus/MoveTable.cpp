@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "MoveTable.h"
+
+#include <array>
+
+namespace blokus {
+
+namespace {
+
+constexpr std::array<std::string_view, move_column_count> column_names{
+    "game", "ply", "turn", "player", "piece", "orientation", "square", "score", "rank",
+};
+
+template<class T>
+void append_column(std::vector<T>& column, std::vector<T> const& other) {
+    column.insert(column.end(), other.begin(), other.end());
+}
+
+}
+
+std::string_view get_column_name(MoveColumn column) {
+    return column_names[static_cast<std::size_t>(column)];
+}
+
+std::optional<MoveColumn> parse_column_name(std::string_view name) {
+    for (std::size_t i = 0; i < move_column_count; ++i) {
+        if (column_names[i] == name) {
+            return static_cast<MoveColumn>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+// ----------------------------------------------------------------------------
+
+void MoveTable::add_game(GameRecord const& record) {
+    auto game = Game::CreateNew(record.players);
+    for (auto const move : record.moves) {
+        game.apply(move);
+    }
+
+    std::array<std::int8_t, player_id_count> final_scores{};
+    std::array<std::uint8_t, player_id_count> final_ranks{};
+    for (auto const player : game.get_players()) {
+        final_scores[to_index(player)] = static_cast<std::int8_t>(game.get_score(player));
+    }
+    for (auto const player : game.get_players()) {
+        for (auto const other : game.get_players()) {
+            if (final_scores[to_index(other)] > final_scores[to_index(player)]) {
+                ++final_ranks[to_index(player)];
+            }
+        }
+    }
+
+    std::array<std::uint8_t, player_id_count> player_turns{};
+    for (std::size_t ply = 0; ply < game.get_ply(); ++ply) {
+        auto const move = game.get_move(ply);
+        if (move.is_pass()) {
+            continue;
+        }
+        auto const player = to_index(game.get_move_player(ply));
+        games.push_back(game_count);
+        plies.push_back(static_cast<std::uint8_t>(ply));
+        turns.push_back(player_turns[player]++);
+        players.push_back(static_cast<std::uint8_t>(player));
+        pieces.push_back(static_cast<std::uint8_t>(get_piece(move)));
+        orientations.push_back(static_cast<std::uint8_t>(move.get_orientation()));
+        squares.push_back(move.get_square());
+        scores.push_back(final_scores[player]);
+        ranks.push_back(final_ranks[player]);
+    }
+    ++game_count;
+}
+
+void MoveTable::append(MoveTable const& other) {
+    auto const first = games.size();
+    append_column(games, other.games);
+    for (auto i = first; i < games.size(); ++i) {
+        games[i] += game_count;
+    }
+    append_column(plies, other.plies);
+    append_column(turns, other.turns);
+    append_column(players, other.players);
+    append_column(pieces, other.pieces);
+    append_column(orientations, other.orientations);
+    append_column(squares, other.squares);
+    append_column(scores, other.scores);
+    append_column(ranks, other.ranks);
+    game_count += other.game_count;
+}
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "GameRecord.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Columns of the move table, one row per piece placed
+enum class MoveColumn : std::uint8_t {
+    Game,           // index of the game in the table
+    Ply,            // index of the move in the game, passes included
+    Turn,           // index of the move among the moves of the player
+    Player,         // PlayerId
+    Piece,          // PieceId
+    Orientation,    // OrientationIndex
+    Square,
+    Score,          // final score of the player
+    Rank,           // number of players with a better final score, 0 for the winners
+};
+
+constexpr std::size_t move_column_count = 9;
+
+std::string_view get_column_name(MoveColumn column);
+std::optional<MoveColumn> parse_column_name(std::string_view name);
+
+// ----------------------------------------------------------------------------
+
+// Moves of recorded games stored column by column, so that a scan reads only the columns it needs
+class MoveTable {
+public:
+    // Replays the record for the final scores. The record must be valid, records read from a file are
+    // checked with validate_record first.
+    void add_game(GameRecord const& record);
+    // Appends the rows of the other table, renumbering its games after the ones of this table
+    void append(MoveTable const& other);
+
+    std::size_t get_row_count() const { return squares.size(); }
+    std::uint32_t get_game_count() const { return game_count; }
+
+    // Calls f with the span of the column values, whose type depends on the column
+    template<class F>
+    decltype(auto) visit(MoveColumn column, F&& f) const;
+
+private:
+    std::vector<std::uint32_t> games;
+    std::vector<std::uint8_t> plies;
+    std::vector<std::uint8_t> turns;
+    std::vector<std::uint8_t> players;
+    std::vector<std::uint8_t> pieces;
+    std::vector<std::uint8_t> orientations;
+    std::vector<std::uint16_t> squares;
+    std::vector<std::int8_t> scores;
+    std::vector<std::uint8_t> ranks;
+    std::uint32_t game_count{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+template<class F>
+decltype(auto) MoveTable::visit(MoveColumn column, F&& f) const {
+    switch (column) {
+    case MoveColumn::Game:          return f(std::span<std::uint32_t const>(games));
+    case MoveColumn::Ply:           return f(std::span<std::uint8_t const>(plies));
+    case MoveColumn::Turn:          return f(std::span<std::uint8_t const>(turns));
+    case MoveColumn::Player:        return f(std::span<std::uint8_t const>(players));
+    case MoveColumn::Piece:         return f(std::span<std::uint8_t const>(pieces));
+    case MoveColumn::Orientation:   return f(std::span<std::uint8_t const>(orientations));
+    case MoveColumn::Square:        return f(std::span<std::uint16_t const>(squares));
+    case MoveColumn::Score:         return f(std::span<std::int8_t const>(scores));
+    default:                        return f(std::span<std::uint8_t const>(ranks));
+    }
+}
+
+}
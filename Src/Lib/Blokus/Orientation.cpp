@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "Orientation.h"
+
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+#include <vector>
+
+namespace blokus {
+
+namespace {
+
+// Base shapes, in PieceId order, rows separated by '/'
+constexpr std::array<std::string_view, piece_count> piece_shapes = {
+    "X",
+    "XX",
+    "XXX", "XX/X",
+    "XXXX", "XXX/X", "XXX/.X", "XX/XX", "XX/.XX",
+    "XXXXX", "XXXX/X", "XXXX/.X", "XXX/XX", "XXX/..XX", "XXX/X/X", "XXX/.X/.X", ".X/XXX/.X", "XX/X/XX", "XX/.X/.XX", "XX/.XX/.X", "XX/.XX/..X",
+};
+
+std::vector<Position> parse_shape(std::string_view shape) {
+    std::vector<Position> squares;
+    int x = 0;
+    int y = 0;
+    for (auto c : shape) {
+        if (c == '/') {
+            x = 0;
+            ++y;
+            continue;
+        }
+        if (c == 'X') {
+            squares.emplace_back(x, y);
+        }
+        ++x;
+    }
+    return squares;
+}
+
+std::vector<Position> normalize(std::vector<Position> squares) {
+    auto const min_x = std::ranges::min(squares, {}, &Position::get_x).get_x();
+    auto const min_y = std::ranges::min(squares, {}, &Position::get_y).get_y();
+    for (auto& square : squares) {
+        square = square - PositionDelta{ min_x, min_y };
+    }
+    std::ranges::sort(squares);
+    return squares;
+}
+
+// The 8 symmetries of the square: 4 rotations, with and without reflection
+Position transform(Position const& position, int symmetry) {
+    auto x = position.get_x();
+    auto y = position.get_y();
+    if (symmetry >= 4) {
+        x = -x;
+    }
+    for (int i = 0; i < symmetry % 4; ++i) {
+        x = std::exchange(y, -x);
+    }
+    return { x, y };
+}
+
+struct OrientationTable {
+    OrientationTable() {
+        std::size_t index = 0;
+        for (std::size_t piece = 0; piece < piece_count; ++piece) {
+            auto const base = parse_shape(piece_shapes[piece]);
+            std::vector<std::vector<Position>> unique_squares;
+
+            for (int symmetry = 0; symmetry < 8; ++symmetry) {
+                std::vector<Position> squares;
+                for (auto const& square : base) {
+                    squares.push_back(transform(square, symmetry));
+                }
+                squares = normalize(std::move(squares));
+                if (std::ranges::find(unique_squares, squares) == unique_squares.end()) {
+                    unique_squares.push_back(std::move(squares));
+                }
+            }
+
+            ranges[piece].first = static_cast<OrientationIndex>(index);
+            for (auto& squares : unique_squares) {
+                assert(index < orientation_count);
+                auto& orientation = orientations[index];
+                orientation.piece = static_cast<PieceId>(piece);
+                orientation.size = static_cast<std::uint8_t>(squares.size());
+                orientation.width = static_cast<std::uint8_t>(std::ranges::max(squares, {}, &Position::get_x).get_x() + 1);
+                orientation.height = static_cast<std::uint8_t>(std::ranges::max(squares, {}, &Position::get_y).get_y() + 1);
+                for (std::size_t i = 0; i < squares.size(); ++i) {
+                    orientation.squares[i] = { static_cast<std::uint8_t>(squares[i].get_x()), static_cast<std::uint8_t>(squares[i].get_y()) };
+                }
+                oriented_pieces.emplace_back(std::move(squares));
+                ++index;
+            }
+            ranges[piece].last = static_cast<OrientationIndex>(index);
+        }
+        assert(index == orientation_count);
+    }
+
+    std::array<Orientation, orientation_count> orientations{};
+    std::array<OrientationRange, piece_count> ranges{};
+    std::vector<OrientedPiece> oriented_pieces;
+};
+
+OrientationTable const& get_orientation_table() {
+    static OrientationTable const table;
+    return table;
+}
+
+}
+
+std::span<Orientation const, orientation_count> get_orientations() {
+    return get_orientation_table().orientations;
+}
+
+Orientation const& get_orientation(OrientationIndex orientation) {
+    assert(orientation < orientation_count);
+    return get_orientation_table().orientations[orientation];
+}
+
+OrientationRange get_orientation_range(PieceId piece) {
+    return get_orientation_table().ranges[to_index(piece)];
+}
+
+OrientedPiece const& get_oriented_piece(OrientationIndex orientation) {
+    assert(orientation < orientation_count);
+    return get_orientation_table().oriented_pieces[orientation];
+}
+
+}
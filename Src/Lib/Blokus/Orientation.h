@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "OrientedPiece.h"
+#include "Piece.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Every distinct rotation/reflection of the 21 pieces, grouped by piece
+using OrientationIndex = std::uint8_t;
+constexpr std::size_t orientation_count = 91;
+
+struct Offset {
+    std::uint8_t x;
+    std::uint8_t y;
+};
+
+// The squares are normalized so that the smallest x and the smallest y are 0
+struct Orientation {
+    PieceId piece;
+    std::uint8_t size;
+    std::uint8_t width;
+    std::uint8_t height;
+    std::array<Offset, max_piece_size> squares;
+};
+
+struct OrientationRange {
+    OrientationIndex first;
+    OrientationIndex last; // exclusive
+};
+
+std::span<Orientation const, orientation_count> get_orientations();
+Orientation const& get_orientation(OrientationIndex orientation);
+OrientationRange get_orientation_range(PieceId piece);
+
+// Decoded, heap based, version of an orientation
+OrientedPiece const& get_oriented_piece(OrientationIndex orientation);
+
+}
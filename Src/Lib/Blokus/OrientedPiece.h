@@ -0,0 +1,28 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Position.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+class OrientedPiece {
+public:
+    constexpr OrientedPiece(std::vector<Position> squares)
+        : squares(std::move(squares))
+    {}
+
+    constexpr std::vector<Position> const& get_squares() const { return squares; }
+
+private:
+    std::vector<Position> squares;
+
+    friend auto operator<=>(OrientedPiece const&, OrientedPiece const&) = default;
+};
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// All pieces
+// 1  | 2  | 3   | 4  | 5    | 6   | 7   | 8  | 9   | 10    | 11   | 12   | 13  | 14   | 15  | 16  | 17  | 18 | 19  | 20  | 21  |
+// 1a | 2a | 3a  | 3b | 4a   | 4b  | 4c  | 4d | 4e  | 5a    | 5b   | 5c   | 5d  | 5e   | 5f  | 5g  | 5h  | 5i | 5j  | 5k  | 5l  |
+// X  | XX | XXX | XX | XXXX | XXX | XXX | XX | XX  | XXXXX | XXXX | XXXX | XXX | XXX  | XXX | XXX |  X  | XX | XX  | XX  | XX  |
+//    |    |     | X  |      | X   |  X  | XX |  XX |       | X    |  X   | XX  |   XX | X   |  X  | XXX | X  |  X  |  XX |  XX |
+//    |    |     |    |      |     |     |    |     |       |      |      |     |      | X   |  X  |  X  | XX |  XX |  X  |   X |
+enum class PieceId : std::uint8_t {
+    P1a,
+    P2a,
+    P3a, P3b,
+    P4a, P4b, P4c, P4d, P4e,
+    P5a, P5b, P5c, P5d, P5e, P5f, P5g, P5h, P5i, P5j, P5k, P5l,
+};
+
+constexpr std::size_t piece_count = 21;
+constexpr int max_piece_size = 5;
+
+constexpr std::size_t to_index(PieceId piece) {
+    return static_cast<std::size_t>(piece);
+}
+
+constexpr int get_piece_size(PieceId piece) {
+    auto const index = to_index(piece);
+    if (index < 1) return 1;
+    if (index < 2) return 2;
+    if (index < 4) return 3;
+    if (index < 9) return 4;
+    return 5;
+}
+
+// Name of the piece in the table above, e.g. "5l"
+constexpr std::string_view get_piece_name(PieceId piece) {
+    constexpr std::string_view names[piece_count]{
+        "1a", "2a", "3a", "3b", "4a", "4b", "4c", "4d", "4e",
+        "5a", "5b", "5c", "5d", "5e", "5f", "5g", "5h", "5i", "5j", "5k", "5l",
+    };
+    return names[to_index(piece)];
+}
+
+constexpr std::optional<PieceId> parse_piece_name(std::string_view name) {
+    for (std::size_t i = 0; i < piece_count; ++i) {
+        if (get_piece_name(static_cast<PieceId>(i)) == name) {
+            return static_cast<PieceId>(i);
+        }
+    }
+    return std::nullopt;
+}
+
+// ----------------------------------------------------------------------------
+
+// Set of pieces, one bit per PieceId
+class PieceSet {
+public:
+    constexpr PieceSet() = default;
+
+    static constexpr PieceSet all() {
+        return PieceSet{ (std::uint32_t{ 1 } << piece_count) - 1 };
+    }
+
+    constexpr bool contains(PieceId piece) const { return (bits >> to_index(piece)) & 1; }
+    constexpr void insert(PieceId piece) { bits |= std::uint32_t{ 1 } << to_index(piece); }
+    constexpr void erase(PieceId piece) { bits &= ~(std::uint32_t{ 1 } << to_index(piece)); }
+
+    constexpr bool empty() const { return bits == 0; }
+    constexpr int count() const { return std::popcount(bits); }
+
+    // Sum of the squares of all the pieces in the set
+    constexpr int get_square_count() const {
+        int result = 0;
+        for (std::size_t i = 0; i < piece_count; ++i) {
+            if ((bits >> i) & 1) {
+                result += get_piece_size(static_cast<PieceId>(i));
+            }
+        }
+        return result;
+    }
+
+    constexpr std::uint32_t get_bits() const { return bits; }
+
+    static constexpr PieceSet from_bits(std::uint32_t bits) {
+        assert((bits & ~all().bits) == 0);
+        return PieceSet{ bits };
+    }
+
+private:
+    constexpr explicit PieceSet(std::uint32_t bits) : bits(bits) {}
+
+    std::uint32_t bits{ 0 };
+
+    friend auto operator<=>(PieceSet const&, PieceSet const&) = default;
+};
+
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+enum class PlayerId { Red, Green, Blue, Yellow };
+
+constexpr std::size_t player_id_count = 4;
+
+constexpr std::size_t to_index(PlayerId player) {
+    return static_cast<std::size_t>(player);
+}
+
+}
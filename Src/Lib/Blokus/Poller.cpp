@@ -0,0 +1,155 @@
+#include "pch.h"
+#include "Poller.h"
+
+#include <array>
+#include <cassert>
+#include <system_error>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace blokus {
+
+#ifdef _WIN32
+
+Poller::Poller() = default;
+
+Poller::~Poller() = default;
+
+void Poller::add(SocketHandle socket, std::uint64_t key, bool watch_writes) {
+    assert(!indices.contains(socket));
+    indices.emplace(socket, entries.size());
+    entries.push_back({ socket, key, watch_writes });
+}
+
+void Poller::modify(SocketHandle socket, std::uint64_t key, bool watch_writes) {
+    auto& entry = entries[indices.at(socket)];
+    entry.key = key;
+    entry.watch_writes = watch_writes;
+}
+
+void Poller::remove(SocketHandle socket) {
+    auto const found = indices.find(socket);
+    assert(found != indices.end());
+    // Swap with the last entry to keep the array dense
+    auto const index = found->second;
+    indices.erase(found);
+    if (index + 1 != entries.size()) {
+        entries[index] = entries.back();
+        indices[entries[index].socket] = index;
+    }
+    entries.pop_back();
+}
+
+void Poller::wait(std::vector<PollEvent>& events, std::chrono::milliseconds timeout) {
+    events.clear();
+    if (entries.empty()) {
+        Sleep(static_cast<DWORD>(timeout.count()));
+        return;
+    }
+
+    // WSAPoll is linear in the number of sockets anyway, rebuilding the array costs about the same
+    std::vector<WSAPOLLFD> descriptors(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        descriptors[i].fd = entries[i].socket;
+        descriptors[i].events = static_cast<SHORT>(POLLRDNORM | (entries[i].watch_writes ? POLLWRNORM : 0));
+    }
+
+    auto const ready = WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), static_cast<INT>(timeout.count()));
+    if (ready == SOCKET_ERROR) {
+        throw std::system_error(WSAGetLastError(), std::system_category(), "WSAPoll");
+    }
+
+    for (std::size_t i = 0; i < descriptors.size() && events.size() < static_cast<std::size_t>(ready); ++i) {
+        auto const revents = descriptors[i].revents;
+        if (revents == 0) {
+            continue;
+        }
+        events.push_back({
+            .key = entries[i].key,
+            .readable = (revents & POLLRDNORM) != 0,
+            .writable = (revents & POLLWRNORM) != 0,
+            .closed = (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0,
+        });
+    }
+}
+
+#else
+
+namespace {
+
+epoll_event make_event(std::uint64_t key, bool watch_writes) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (watch_writes ? EPOLLOUT : 0u);
+    event.data.u64 = key;
+    return event;
+}
+
+[[noreturn]] void throw_last_error(char const* what) {
+    throw std::system_error(errno, std::system_category(), what);
+}
+
+}
+
+Poller::Poller()
+    : epoll(epoll_create1(EPOLL_CLOEXEC))
+{
+    if (epoll < 0) {
+        throw_last_error("epoll_create1");
+    }
+}
+
+Poller::~Poller() {
+    close(epoll);
+}
+
+void Poller::add(SocketHandle socket, std::uint64_t key, bool watch_writes) {
+    auto event = make_event(key, watch_writes);
+    if (epoll_ctl(epoll, EPOLL_CTL_ADD, socket, &event) != 0) {
+        throw_last_error("epoll_ctl");
+    }
+}
+
+void Poller::modify(SocketHandle socket, std::uint64_t key, bool watch_writes) {
+    auto event = make_event(key, watch_writes);
+    if (epoll_ctl(epoll, EPOLL_CTL_MOD, socket, &event) != 0) {
+        throw_last_error("epoll_ctl");
+    }
+}
+
+void Poller::remove(SocketHandle socket) {
+    epoll_ctl(epoll, EPOLL_CTL_DEL, socket, nullptr);
+}
+
+void Poller::wait(std::vector<PollEvent>& events, std::chrono::milliseconds timeout) {
+    events.clear();
+
+    // Bounded batch, the remaining ready sockets are reported by the next call
+    std::array<epoll_event, 256> ready;
+    auto const count = epoll_wait(epoll, ready.data(), static_cast<int>(ready.size()), static_cast<int>(timeout.count()));
+    if (count < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        throw_last_error("epoll_wait");
+    }
+
+    for (int i = 0; i < count; ++i) {
+        auto const flags = ready[i].events;
+        events.push_back({
+            .key = ready[i].data.u64,
+            .readable = (flags & (EPOLLIN | EPOLLRDHUP)) != 0,
+            .writable = (flags & EPOLLOUT) != 0,
+            .closed = (flags & (EPOLLERR | EPOLLHUP)) != 0,
+        });
+    }
+}
+
+#endif
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Socket.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct PollEvent {
+    std::uint64_t key{ 0 };
+    bool readable{ false };
+    bool writable{ false };
+    // Hang up or error, the socket should be closed
+    bool closed{ false };
+};
+
+// ----------------------------------------------------------------------------
+
+// Level triggered readiness notification over many sockets: epoll on Linux, WSAPoll on Windows.
+// Every registered socket is watched for reads, writes are watched on demand.
+class Poller {
+public:
+    Poller();
+    ~Poller();
+
+    Poller(Poller const&) = delete;
+    Poller& operator=(Poller const&) = delete;
+
+    void add(SocketHandle socket, std::uint64_t key, bool watch_writes = false);
+    void modify(SocketHandle socket, std::uint64_t key, bool watch_writes);
+    void remove(SocketHandle socket);
+
+    // Replaces the events with the ready sockets, waits at most the timeout when there is none
+    void wait(std::vector<PollEvent>& events, std::chrono::milliseconds timeout);
+
+private:
+#ifdef _WIN32
+    struct Entry {
+        SocketHandle socket;
+        std::uint64_t key;
+        bool watch_writes;
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<SocketHandle, std::size_t> indices;
+#else
+    int epoll{ -1 };
+#endif
+};
+
+}
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "Ponderer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <utility>
+
+#include "MoveGeneration.h"
+#include "MoveList.h"
+
+namespace blokus {
+
+Ponderer::Ponderer(ThreadPool& pool, PonderConfig config)
+    : pool(pool)
+    , config(config)
+{
+    assert(config.worker_count > 0);
+    for (std::size_t i = 0; i < config.worker_count; ++i) {
+        workers.push_back(std::make_unique<Worker>(SearchTree{ config.arena }, Random{ config.seed + i }));
+    }
+}
+
+Ponderer::~Ponderer() {
+    stop();
+}
+
+void Ponderer::start(Game const& game) {
+    stop();
+    reroot(game);
+    launch(std::numeric_limits<std::uint32_t>::max(), config.ponder_priority);
+}
+
+void Ponderer::stop() {
+    stop_requested = true;
+    wait();
+    stop_requested = false;
+}
+
+void Ponderer::wait() {
+    for (auto& future : pending) {
+        future.get();
+    }
+    pending.clear();
+}
+
+void Ponderer::update(Game const& game) {
+    auto const was_running = is_running();
+    stop();
+    reroot(game);
+    if (was_running) {
+        launch(std::numeric_limits<std::uint32_t>::max(), config.ponder_priority);
+    }
+}
+
+MctsResult Ponderer::search(Game const& game, std::uint32_t iterations, Deadline const& deadline) {
+    auto const start = Deadline::Clock::now();
+    stop();
+    reroot(game);
+
+    MctsResult result;
+    result.reused_visits = static_cast<std::uint32_t>(std::min<std::uint64_t>(get_root_visits(), std::numeric_limits<std::uint32_t>::max()));
+
+    auto const worker_count = static_cast<std::uint32_t>(workers.size());
+    launch((iterations + worker_count - 1) / worker_count, TaskPriority::Normal, deadline);
+    wait();
+
+    result.iterations = static_cast<std::uint32_t>(get_root_visits() - result.reused_visits);
+    result.deadline_reached = result.iterations < iterations && deadline.has_expired();
+    result.best_move = get_best_move();
+    for (auto const& worker : workers) {
+        auto const statistics = worker->tree.get_arena_statistics();
+        result.arena.used_size += statistics.used_size;
+        result.arena.reserved_size += statistics.reserved_size;
+        result.arena.high_water_mark += statistics.high_water_mark;
+        result.arena.block_count += statistics.block_count;
+        result.arena.failed_allocation_count += statistics.failed_allocation_count;
+    }
+    result.elapsed = Deadline::Clock::now() - start;
+    return result;
+}
+
+std::uint64_t Ponderer::get_root_visits() const {
+    std::uint64_t result = 0;
+    for (auto const& worker : workers) {
+        if (worker->tree.has_root()) {
+            result += worker->tree.get_root().visits;
+        }
+    }
+    return result;
+}
+
+void Ponderer::reroot(Game const& game) {
+    assert(!is_running());
+    for (auto& worker : workers) {
+        if (!worker->tree.advance(game)) {
+            worker->tree.reset(game);
+        }
+    }
+}
+
+void Ponderer::launch(std::uint32_t iterations_per_worker, TaskPriority priority, Deadline const& deadline) {
+    assert(!is_running());
+    for (auto& worker : workers) {
+        pending.push_back(pool.submit([this, &worker = *worker, iterations_per_worker, deadline] {
+            for (std::uint32_t i = 0; i < iterations_per_worker && !stop_requested.load(std::memory_order_relaxed) && !deadline.has_expired(); ++i) {
+                worker.tree.run_iteration(worker.random, config.exploration);
+            }
+        }, priority));
+    }
+}
+
+Move Ponderer::get_best_move() const {
+    auto const& game = workers.front()->tree.get_root_game();
+
+    MoveList moves;
+    generate_moves(game, moves);
+    if (moves.empty()) {
+        return Move::pass();
+    }
+    if (moves.size() == 1) {
+        return moves[0];
+    }
+
+    // Root children are generated in the same order by every tree, but a tree may not be expanded yet
+    std::vector<std::uint64_t> visits(moves.size(), 0);
+    for (auto const& worker : workers) {
+        auto const& root = worker->tree.get_root();
+        for (std::uint16_t i = 0; i < root.child_count; ++i) {
+            auto const& child = root.children[i];
+            auto const index = i < moves.size() && moves[i] == child.move
+                ? i
+                : static_cast<std::size_t>(std::ranges::find(moves, child.move) - moves.begin());
+            visits[index] += child.visits;
+        }
+    }
+    auto const best = std::ranges::max_element(visits) - visits.begin();
+    return moves[static_cast<std::size_t>(best)];
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "Arena.h"
+#include "Deadline.h"
+#include "Game.h"
+#include "Mcts.h"
+#include "Random.h"
+#include "SearchTree.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct PonderConfig {
+    // One search tree per worker, their root statistics are merged for the decision
+    std::size_t worker_count{ 4 };
+    float exploration{ 0.7f };
+    std::uint64_t seed{ 0 };
+    ArenaConfig arena{};
+    // Pondering runs until stopped: below the other tasks of a shared pool, the tasks queued meanwhile
+    // go first, though a pondering task that started keeps its thread until stop().
+    // The iterations of search() run at Normal priority.
+    TaskPriority ponder_priority{ TaskPriority::Low };
+};
+
+// ----------------------------------------------------------------------------
+
+// Root parallel search that keeps running on the thread pool during the other players turns.
+// Workers check the stop flag between iterations, so stopping costs at most one playout.
+class Ponderer {
+public:
+    Ponderer(ThreadPool& pool, PonderConfig config = {});
+    ~Ponderer();
+
+    Ponderer(Ponderer const&) = delete;
+    Ponderer& operator=(Ponderer const&) = delete;
+
+    // Starts searching the game position in the background, whoever has to play
+    void start(Game const& game);
+
+    // Returns once every worker is out of its current iteration
+    void stop();
+
+    bool is_running() const { return !pending.empty(); }
+
+    // A move was played: re-roots every tree, pondering goes on when it was running
+    void update(Game const& game);
+
+    // Stops pondering, re-roots on the game and runs the iterations, shared between the workers,
+    // or less when the deadline expires first.
+    // The result iterations don't count the reused ones, see reused_visits.
+    MctsResult search(Game const& game, std::uint32_t iterations, Deadline const& deadline = Deadline::never());
+
+    // Sum of the root visits of every tree
+    std::uint64_t get_root_visits() const;
+
+private:
+    struct Worker {
+        SearchTree tree;
+        Random random;
+    };
+
+    void reroot(Game const& game);
+    void launch(std::uint32_t iterations_per_worker, TaskPriority priority, Deadline const& deadline = Deadline::never());
+    void wait();
+    Move get_best_move() const;
+
+    ThreadPool& pool;
+    PonderConfig config;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::future<void>> pending;
+    std::atomic<bool> stop_requested{ false };
+};
+
+}
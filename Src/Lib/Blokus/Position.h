@@ -0,0 +1,53 @@
+#pragma once
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+class Position {
+public:
+    constexpr Position(int x, int y)
+        : x(x)
+        , y(y)
+    {}
+
+    constexpr int get_x() const { return x; }
+    constexpr int get_y() const { return y; }
+
+private:
+    int x;
+    int y;
+
+    friend auto operator<=>(Position const&, Position const&) = default;
+};
+
+// ----------------------------------------------------------------------------
+
+class PositionDelta {
+public:
+    constexpr PositionDelta(int x, int y)
+        : x(x)
+        , y(y)
+    {}
+
+    constexpr int get_x() const { return x; }
+    constexpr int get_y() const { return y; }
+
+private:
+    int x;
+    int y;
+
+    friend auto operator<=>(PositionDelta const&, PositionDelta const&) = default;
+};
+
+constexpr Position operator+(Position const& position, PositionDelta const& delta) {
+    return { position.get_x() + delta.get_x(), position.get_y() + delta.get_y() };
+}
+
+constexpr Position operator-(Position const& position, PositionDelta const& delta) {
+    return { position.get_x() - delta.get_x(), position.get_y() - delta.get_y() };
+}
+
+}
@@ -0,0 +1,428 @@
+#include "pch.h"
+#include "PositionDatabase.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Evaluation.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr std::array<char, 4> log_magic{ 'B', 'K', 'P', 'L' };
+constexpr std::uint32_t log_version = 1;
+constexpr std::uint64_t log_header_size = 8;
+
+constexpr std::array<char, 4> index_magic{ 'B', 'K', 'P', 'I' };
+constexpr std::uint32_t index_version = 1;
+constexpr std::uint64_t minimum_capacity = 1 << 12;
+
+enum class RecordType : std::uint8_t {
+    Position = 1,
+    Statistics = 2,
+};
+
+constexpr std::size_t record_header_size = 9;
+constexpr std::size_t statistics_size = 8 + 8 * player_id_count;
+
+std::filesystem::path get_log_path(std::filesystem::path const& directory) {
+    return directory / "positions.log";
+}
+
+std::filesystem::path get_index_path(std::filesystem::path const& directory) {
+    return directory / "positions.idx";
+}
+
+void append64(std::vector<std::uint8_t>& output, std::uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        output.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+std::uint64_t read64(std::span<std::uint8_t const> input) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= std::uint64_t{ input[i] } << (8 * i);
+    }
+    return value;
+}
+
+void write_header(std::ostream& stream) {
+    std::array<char, 8> const header{ log_magic[0], log_magic[1], log_magic[2], log_magic[3],
+        static_cast<char>(log_version), 0, 0, 0 };
+    stream.write(header.data(), header.size());
+}
+
+// Calls the handlers for every complete record and returns the end of the last one,
+// a record cut by a crash ends the log there
+std::uint64_t read_log(
+    std::filesystem::path const& path,
+    std::function<void(std::uint64_t hash, std::uint64_t offset, std::span<std::uint8_t const> position)> const& on_position,
+    std::function<void(std::uint64_t hash, PositionStatistics const& statistics)> const& on_statistics)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::array<char, 8> header{};
+    if (!file.read(header.data(), header.size()) ||
+        !std::equal(log_magic.begin(), log_magic.end(), header.begin()) ||
+        static_cast<std::uint8_t>(header[4]) != log_version)
+    {
+        throw std::runtime_error("not a position log " + path.string());
+    }
+
+    std::uint64_t offset = log_header_size;
+    std::vector<std::uint8_t> record(record_header_size + CanonicalPosition::encoded_size);
+    while (file.read(reinterpret_cast<char*>(record.data()), record_header_size)) {
+        auto const type = static_cast<RecordType>(record[0]);
+        auto const hash = read64(std::span(record).subspan(1));
+        auto const payload = std::span(record).subspan(record_header_size);
+
+        if (type == RecordType::Position) {
+            if (!file.read(reinterpret_cast<char*>(payload.data()), CanonicalPosition::encoded_size)) {
+                break;
+            }
+            on_position(hash, offset + record_header_size, payload.first(CanonicalPosition::encoded_size));
+            offset += record_header_size + CanonicalPosition::encoded_size;
+        }
+        else if (type == RecordType::Statistics) {
+            if (!file.read(reinterpret_cast<char*>(payload.data()), statistics_size)) {
+                break;
+            }
+            PositionStatistics statistics;
+            statistics.visits = read64(payload);
+            for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+                statistics.reward_sums[seat] = std::bit_cast<double>(read64(payload.subspan(8 + 8 * seat)));
+            }
+            on_statistics(hash, statistics);
+            offset += record_header_size + statistics_size;
+        }
+        else {
+            throw std::runtime_error("corrupted position log " + path.string());
+        }
+    }
+    return offset;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+PositionStatistics& PositionStatistics::operator+=(PositionStatistics const& other) {
+    visits += other.visits;
+    for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+        reward_sums[seat] += other.reward_sums[seat];
+    }
+    return *this;
+}
+
+// ----------------------------------------------------------------------------
+
+void PositionBatch::add_game(GameRecord const& record, std::size_t max_ply) {
+    struct Decision {
+        CanonicalPosition position;
+        PlayerId mover;
+    };
+    std::vector<Decision> decisions;
+
+    auto game = Game::CreateNew(record.players);
+    for (auto const move : record.moves) {
+        if (game.get_ply() < max_ply) {
+            decisions.push_back({ CanonicalPosition::from_game(game), game.get_current_player() });
+        }
+        game.apply(move);
+    }
+
+    auto const rewards = get_rewards(game);
+    auto const players = game.get_players();
+    for (auto const& decision : decisions) {
+        PositionStatistics statistics{ .visits = 1, .reward_sums = {} };
+        for (std::size_t i = 0; i < players.size(); ++i) {
+            statistics.reward_sums[get_seat(players[i], decision.mover)] = rewards[i];
+        }
+        add(decision.position, statistics);
+    }
+}
+
+void PositionBatch::add(CanonicalPosition const& position, PositionStatistics const& statistics) {
+    auto const [it, inserted] = entries.try_emplace(position.get_hash(), Entry{ position, {} });
+    it->second.statistics += statistics;
+}
+
+// ----------------------------------------------------------------------------
+
+PositionDatabase::PositionDatabase(std::filesystem::path directory)
+    : directory(std::move(directory))
+{
+    // The index is read in place, its layout must not depend on the compiler
+    static_assert(sizeof(IndexHeader) == 40);
+    static_assert(sizeof(IndexEntry) == 56);
+
+    std::filesystem::create_directories(this->directory);
+
+    auto const log_path = get_log_path(this->directory);
+    if (!std::filesystem::exists(log_path) || std::filesystem::file_size(log_path) < log_header_size) {
+        std::ofstream file(log_path, std::ios::binary | std::ios::trunc);
+        write_header(file);
+        if (!file) {
+            throw std::runtime_error("cannot create position log " + log_path.string());
+        }
+    }
+    log_size = std::filesystem::file_size(log_path);
+
+    index = MappedFile(get_index_path(this->directory), sizeof(IndexHeader) + minimum_capacity * sizeof(IndexEntry));
+    auto const& header = get_header();
+    auto const valid =
+        header.magic == index_magic && header.version == index_version &&
+        std::has_single_bit(header.capacity) &&
+        sizeof(IndexHeader) + header.capacity * sizeof(IndexEntry) <= index.get_size() &&
+        header.clean != 0 && header.log_size == log_size;
+    if (!valid) {
+        rebuild_index();
+    }
+
+    log.open(log_path, std::ios::binary | std::ios::app);
+    if (!log) {
+        throw std::runtime_error("cannot open position log " + log_path.string());
+    }
+}
+
+PositionDatabase::~PositionDatabase() {
+    try {
+        flush();
+    }
+    catch (...) {
+        // The index stays marked as dirty
+    }
+}
+
+PositionDatabase::IndexHeader& PositionDatabase::get_header() const {
+    return *reinterpret_cast<IndexHeader*>(index.get_data());
+}
+
+PositionDatabase::IndexEntry* PositionDatabase::get_entries() const {
+    return reinterpret_cast<IndexEntry*>(index.get_data() + sizeof(IndexHeader));
+}
+
+void PositionDatabase::rebuild_index() {
+    reset_index(minimum_capacity);
+
+    auto const log_path = get_log_path(directory);
+    auto const end = read_log(log_path,
+        [this](std::uint64_t hash, std::uint64_t offset, std::span<std::uint8_t const>) {
+            reserve(get_header().count + 1);
+            insert_position(hash, offset);
+        },
+        [this](std::uint64_t hash, PositionStatistics const& statistics) {
+            add_statistics(hash, statistics);
+        });
+
+    if (end < log_size) {
+        std::filesystem::resize_file(log_path, end);
+        log_size = end;
+    }
+    get_header().log_size = log_size;
+}
+
+void PositionDatabase::reset_index(std::uint64_t capacity) {
+    auto const size = sizeof(IndexHeader) + capacity * sizeof(IndexEntry);
+    // Never shrinks, the file can't be cut while mapped on Windows
+    if (size > index.get_size()) {
+        index.resize(size);
+    }
+    std::memset(index.get_data(), 0, size);
+
+    auto& header = get_header();
+    header.magic = index_magic;
+    header.version = index_version;
+    header.capacity = capacity;
+    header.log_size = log_size;
+}
+
+void PositionDatabase::mark_dirty() {
+    auto& header = get_header();
+    if (header.clean != 0) {
+        header.clean = 0;
+        index.flush();
+    }
+}
+
+PositionDatabase::IndexEntry& PositionDatabase::find_slot(std::uint64_t hash) const {
+    auto const entries = get_entries();
+    auto const mask = get_header().capacity - 1;
+    auto slot = hash & mask;
+    while (entries[slot].hash != 0 && entries[slot].hash != hash) {
+        slot = (slot + 1) & mask;
+    }
+    return entries[slot];
+}
+
+PositionDatabase::IndexEntry const* PositionDatabase::find_entry(std::uint64_t hash) const {
+    auto const& entry = find_slot(hash);
+    return entry.hash == hash ? &entry : nullptr;
+}
+
+void PositionDatabase::reserve(std::uint64_t count) {
+    auto capacity = get_header().capacity;
+    // At most 70% full to keep the probes short
+    if (count * 10 <= capacity * 7) {
+        return;
+    }
+    while (count * 10 > capacity * 7) {
+        capacity *= 2;
+    }
+
+    std::vector<IndexEntry> live;
+    live.reserve(get_header().count);
+    auto const entries = get_entries();
+    for (std::uint64_t i = 0; i < get_header().capacity; ++i) {
+        if (entries[i].hash != 0) {
+            live.push_back(entries[i]);
+        }
+    }
+
+    reset_index(capacity);
+    for (auto const& entry : live) {
+        find_slot(entry.hash) = entry;
+    }
+    get_header().count = live.size();
+}
+
+void PositionDatabase::insert_position(std::uint64_t hash, std::uint64_t content_offset) {
+    auto& entry = find_slot(hash);
+    if (entry.hash == 0) {
+        entry = { .hash = hash, .visits = 0, .reward_sums = {}, .content_offset = content_offset };
+        ++get_header().count;
+    }
+}
+
+void PositionDatabase::add_statistics(std::uint64_t hash, PositionStatistics const& statistics) {
+    auto& entry = find_slot(hash);
+    if (entry.hash == 0) {
+        return;
+    }
+    entry.visits += statistics.visits;
+    for (std::size_t seat = 0; seat < player_id_count; ++seat) {
+        entry.reward_sums[seat] += statistics.reward_sums[seat];
+    }
+}
+
+void PositionDatabase::add(std::uint64_t hash, CanonicalPosition const* position, PositionStatistics const& statistics) {
+    std::vector<std::uint8_t> record;
+    reserve(get_header().count + 1);
+
+    if (find_slot(hash).hash == 0) {
+        if (position == nullptr) {
+            return;
+        }
+        record.push_back(static_cast<std::uint8_t>(RecordType::Position));
+        append64(record, hash);
+        position->encode(record);
+        insert_position(hash, log_size + record_header_size);
+    }
+
+    if (statistics.visits != 0) {
+        record.push_back(static_cast<std::uint8_t>(RecordType::Statistics));
+        append64(record, hash);
+        append64(record, statistics.visits);
+        for (auto const sum : statistics.reward_sums) {
+            append64(record, std::bit_cast<std::uint64_t>(sum));
+        }
+        add_statistics(hash, statistics);
+    }
+
+    log.write(reinterpret_cast<char const*>(record.data()), static_cast<std::streamsize>(record.size()));
+    log_size += record.size();
+}
+
+void PositionDatabase::merge(PositionBatch const& batch) {
+    std::lock_guard lock(mutex);
+    mark_dirty();
+    reserve(get_header().count + batch.get_position_count());
+    for (auto const& [hash, entry] : batch.get_entries()) {
+        add(hash, &entry.position, entry.statistics);
+    }
+    if (!log) {
+        throw std::runtime_error("cannot write position log " + get_log_path(directory).string());
+    }
+}
+
+void PositionDatabase::merge_from(std::filesystem::path const& other) {
+    // Gathered first so that each position gets a single counter record
+    PositionBatch batch;
+    std::unordered_map<std::uint64_t, PositionStatistics> statistics;
+    read_log(get_log_path(other),
+        [&batch](std::uint64_t, std::uint64_t, std::span<std::uint8_t const> encoded) {
+            auto const position = CanonicalPosition::decode(encoded);
+            if (!position) {
+                throw std::runtime_error("corrupted position in log");
+            }
+            batch.add(*position, {});
+        },
+        [&statistics](std::uint64_t hash, PositionStatistics const& added) {
+            statistics[hash] += added;
+        });
+
+    PositionBatch merged;
+    for (auto const& [hash, entry] : batch.get_entries()) {
+        merged.add(entry.position, statistics[hash]);
+    }
+    merge(merged);
+}
+
+std::optional<PositionStatistics> PositionDatabase::find(std::uint64_t hash) const {
+    std::lock_guard lock(mutex);
+    auto const entry = find_entry(hash);
+    if (entry == nullptr) {
+        return std::nullopt;
+    }
+    return PositionStatistics{ entry->visits, entry->reward_sums };
+}
+
+std::optional<CanonicalPosition> PositionDatabase::load_position(std::uint64_t hash) {
+    std::lock_guard lock(mutex);
+    auto const entry = find_entry(hash);
+    if (entry == nullptr) {
+        return std::nullopt;
+    }
+
+    log.flush();
+    std::ifstream file(get_log_path(directory), std::ios::binary);
+    std::array<std::uint8_t, CanonicalPosition::encoded_size> encoded{};
+    file.seekg(static_cast<std::streamoff>(entry->content_offset));
+    if (!file.read(reinterpret_cast<char*>(encoded.data()), encoded.size())) {
+        throw std::runtime_error("cannot read position log " + get_log_path(directory).string());
+    }
+    return CanonicalPosition::decode(encoded);
+}
+
+std::size_t PositionDatabase::get_position_count() const {
+    std::lock_guard lock(mutex);
+    return static_cast<std::size_t>(get_header().count);
+}
+
+std::uint64_t PositionDatabase::get_log_size() const {
+    std::lock_guard lock(mutex);
+    return log_size;
+}
+
+void PositionDatabase::flush() {
+    std::lock_guard lock(mutex);
+    log.flush();
+    if (!log) {
+        throw std::runtime_error("cannot write position log " + get_log_path(directory).string());
+    }
+
+    auto& header = get_header();
+    header.log_size = log_size;
+    index.flush();
+    header.clean = 1;
+    index.flush();
+}
+
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "CanonicalPosition.h"
+#include "Game.h"
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Counters of a position, rewards are indexed by seat like CanonicalPosition
+struct PositionStatistics {
+    std::uint64_t visits{ 0 };
+    std::array<double, player_id_count> reward_sums{};
+
+    double get_mean_reward(std::size_t seat) const {
+        return visits == 0 ? 0.0 : reward_sums[seat] / static_cast<double>(visits);
+    }
+
+    PositionStatistics& operator+=(PositionStatistics const& other);
+
+    friend bool operator==(PositionStatistics const&, PositionStatistics const&) = default;
+};
+
+// ----------------------------------------------------------------------------
+
+// Positions collected by one worker without any locking, merged into the database in one go
+class PositionBatch {
+public:
+    struct Entry {
+        CanonicalPosition position;
+        PositionStatistics statistics;
+    };
+
+    // Counts every position where a move was chosen, up to the ply, with the final rewards of the game
+    void add_game(GameRecord const& record, std::size_t max_ply = std::numeric_limits<std::size_t>::max());
+    void add(CanonicalPosition const& position, PositionStatistics const& statistics);
+
+    std::size_t get_position_count() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    void clear() { entries.clear(); }
+
+    std::unordered_map<std::uint64_t, Entry> const& get_entries() const { return entries; }
+
+private:
+    std::unordered_map<std::uint64_t, Entry> entries;
+};
+
+// ----------------------------------------------------------------------------
+
+// Position store keyed by the hash of the canonical position, each position is kept once.
+// The directory holds two files:
+//  positions.log: "BKPL", 4 bytes version, then records of 1 byte type and 8 bytes hash followed by
+//                 the encoded position (type 1, written once per position) or
+//                 8 bytes visits and 4 doubles of reward sums (type 2, added to the counters)
+//  positions.idx: open addressing table mapped in memory, the hash, counters and log offset of the
+//                 encoded position of each entry
+// The log is the reference, the index is rebuilt from it when it was not flushed after its last change.
+// Distinct positions sharing a 64 bit hash are merged, which is rare enough to ignore for statistics.
+// All members are safe to call from several threads. I/O failures throw std::runtime_error.
+class PositionDatabase {
+public:
+    explicit PositionDatabase(std::filesystem::path directory);
+    // Flushes, a failure leaves the index to be rebuilt on the next open
+    ~PositionDatabase();
+
+    PositionDatabase(PositionDatabase const&) = delete;
+    PositionDatabase& operator=(PositionDatabase const&) = delete;
+
+    void merge(PositionBatch const& batch);
+    // Adds the positions and counters of the database in the other directory, which must not be open
+    void merge_from(std::filesystem::path const& directory);
+
+    std::optional<PositionStatistics> find(std::uint64_t hash) const;
+    std::optional<PositionStatistics> find(CanonicalPosition const& position) const { return find(position.get_hash()); }
+    std::optional<PositionStatistics> find(Game const& game) const { return find(CanonicalPosition::from_game(game)); }
+
+    // Reads the position back from the log
+    std::optional<CanonicalPosition> load_position(std::uint64_t hash);
+
+    // Calls f(hash, statistics) for every position, in no particular order
+    template<class F>
+    void for_each(F&& f) const;
+
+    std::size_t get_position_count() const;
+    std::uint64_t get_log_size() const;
+
+    // Makes everything merged so far durable and marks the index as matching the log
+    void flush();
+
+private:
+    struct IndexHeader;
+    struct IndexEntry;
+
+    IndexHeader& get_header() const;
+    IndexEntry* get_entries() const;
+
+    void open_log();
+    void rebuild_index();
+    void reset_index(std::uint64_t capacity);
+    void mark_dirty();
+
+    // Finds the entry of the hash, or the empty slot where it belongs
+    IndexEntry& find_slot(std::uint64_t hash) const;
+    IndexEntry const* find_entry(std::uint64_t hash) const;
+    // Grows the index ahead of the insertion
+    void reserve(std::uint64_t count);
+
+    // Logs the position if it's new, in both cases it gets the counters
+    void add(std::uint64_t hash, CanonicalPosition const* position, PositionStatistics const& statistics);
+    void insert_position(std::uint64_t hash, std::uint64_t content_offset);
+    void add_statistics(std::uint64_t hash, PositionStatistics const& statistics);
+
+    std::filesystem::path directory;
+    mutable std::mutex mutex;
+    std::ofstream log;
+    std::uint64_t log_size{ 0 };
+    MappedFile index;
+};
+
+// ----------------------------------------------------------------------------
+
+struct PositionDatabase::IndexHeader {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    std::uint64_t capacity;
+    std::uint64_t count;
+    std::uint64_t clean;
+    std::uint64_t log_size;
+};
+
+// Empty slots have a zero hash, CanonicalPosition hashes are never zero
+struct PositionDatabase::IndexEntry {
+    std::uint64_t hash;
+    std::uint64_t visits;
+    std::array<double, player_id_count> reward_sums;
+    // Offset of the encoded position in the log
+    std::uint64_t content_offset;
+};
+
+template<class F>
+void PositionDatabase::for_each(F&& f) const {
+    std::lock_guard lock(mutex);
+    auto const entries = get_entries();
+    for (std::uint64_t i = 0; i < get_header().capacity; ++i) {
+        if (entries[i].hash != 0) {
+            f(entries[i].hash, PositionStatistics{ entries[i].visits, entries[i].reward_sums });
+        }
+    }
+}
+
+}
@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "Protocol.h"
+
+#include <charconv>
+
+#include "Game.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr std::string_view player_letters = "rgby";
+
+}
+
+std::string_view next_token(std::string_view& text) {
+    auto const start = text.find_first_not_of(' ');
+    if (start == std::string_view::npos) {
+        text = {};
+        return {};
+    }
+    text.remove_prefix(start);
+    auto const end = text.find(' ');
+    auto const token = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end);
+    return token;
+}
+
+std::optional<Command> parse_command(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    Command command;
+    auto const name = next_token(line);
+
+    auto const read_game_id = [&line, &command] {
+        auto const id = parse_number<std::uint32_t>(next_token(line));
+        command.game_id = id.value_or(0);
+        return id.has_value();
+    };
+
+    if (name == "ping") {
+        command.type = CommandType::Ping;
+    }
+    else if (name == "new") {
+        command.type = CommandType::New;
+        auto players = parse_players(next_token(line));
+        if (!players) {
+            return std::nullopt;
+        }
+        command.players = std::move(*players);
+    }
+    else if (name == "play") {
+        command.type = CommandType::Play;
+        if (!read_game_id()) {
+            return std::nullopt;
+        }
+        auto const move = parse_move(next_token(line));
+        if (!move) {
+            return std::nullopt;
+        }
+        command.move = *move;
+    }
+    else if (name == "moves" || name == "close") {
+        command.type = name == "moves" ? CommandType::Moves : CommandType::Close;
+        if (!read_game_id()) {
+            return std::nullopt;
+        }
+    }
+    else if (name == "bot") {
+        command.type = CommandType::Bot;
+        if (!read_game_id()) {
+            return std::nullopt;
+        }
+        auto const iterations = parse_number<std::uint32_t>(next_token(line));
+        if (!iterations || *iterations == 0) {
+            return std::nullopt;
+        }
+        command.iterations = *iterations;
+        auto milliseconds = next_token(line);
+        if (milliseconds == "clock") {
+            command.clock = true;
+            milliseconds = next_token(line);
+            if (!parse_number(next_token(line), command.increment)) {
+                return std::nullopt;
+            }
+        }
+        if (!milliseconds.empty() || command.clock) {
+            if (!parse_number(milliseconds, command.milliseconds)) {
+                return std::nullopt;
+            }
+        }
+    }
+    else {
+        return std::nullopt;
+    }
+
+    // Trailing garbage is as suspicious as a missing argument
+    if (!next_token(line).empty()) {
+        return std::nullopt;
+    }
+    return command;
+}
+
+std::string format_players(std::vector<PlayerId> const& players) {
+    std::string text;
+    for (auto const player : players) {
+        text += player_letters[to_index(player)];
+    }
+    return text;
+}
+
+std::optional<std::vector<PlayerId>> parse_players(std::string_view text) {
+    if (text.empty() || text.size() > Game::max_player_count) {
+        return std::nullopt;
+    }
+
+    std::vector<PlayerId> players;
+    unsigned seen = 0;
+    for (auto const letter : text) {
+        auto const index = player_letters.find(letter);
+        if (index == std::string_view::npos || (seen >> index) & 1) {
+            return std::nullopt;
+        }
+        seen |= 1u << index;
+        players.push_back(static_cast<PlayerId>(index));
+    }
+    return players;
+}
+
+void append_move(std::string& line, Move move) {
+    char buffer[8];
+    auto const result = std::to_chars(buffer, buffer + sizeof(buffer), move.get_value());
+    line.append(buffer, result.ptr);
+}
+
+std::optional<Move> parse_move(std::string_view text) {
+    auto const value = parse_number<std::uint16_t>(text);
+    if (!value) {
+        return std::nullopt;
+    }
+    return Move::from_value(*value);
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Move.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Line protocol of the game server, one request per line and one reply line per request, in order.
+// Moves are written as their 16 bit value in decimal, players as the letters r, g, b and y.
+//
+//  ping                                 -> pong
+//  new <players>                        -> game <id>
+//  play <id> <move>                     -> ok
+//  moves <id>                           -> moves <count> <move>...
+//  bot <id> <iterations> [<milliseconds>] -> move <move>
+//  bot <id> <iterations> clock <remaining> <increment>
+//                                       -> move <move>
+//  close <id>                           -> ok
+//
+// With a clock, the milliseconds left on the clock of the player to move and its increment per move,
+// the server budgets the search of the move from them.
+// Any failure replies "error <reason>" and the session goes on.
+enum class CommandType { Ping, New, Play, Moves, Bot, Close };
+
+struct Command {
+    CommandType type{ CommandType::Ping };
+    std::uint32_t game_id{ 0 };
+    std::vector<PlayerId> players;
+    Move move{ Move::pass() };
+    std::uint32_t iterations{ 0 };
+    // Zero when the bot request has no time limit
+    std::uint32_t milliseconds{ 0 };
+    // The milliseconds are the time left on the clock, the increment comes with them
+    bool clock{ false };
+    std::uint32_t increment{ 0 };
+};
+
+// Nothing when the line is not a well formed command
+std::optional<Command> parse_command(std::string_view line);
+
+std::string format_players(std::vector<PlayerId> const& players);
+std::optional<std::vector<PlayerId>> parse_players(std::string_view text);
+
+void append_move(std::string& line, Move move);
+std::optional<Move> parse_move(std::string_view text);
+
+// Splits off the first space separated token of the text
+std::string_view next_token(std::string_view& text);
+
+// Nothing unless the whole text is a decimal number of the type
+template<class T>
+std::optional<T> parse_number(std::string_view text) {
+    T value{};
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size() || text.empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Stores the number and returns true when the whole text is one, leaves the value unchanged otherwise
+template<class T>
+bool parse_number(std::string_view text, T& value) {
+    auto const number = parse_number<T>(text);
+    if (number) {
+        value = *number;
+    }
+    return number.has_value();
+}
+
+}
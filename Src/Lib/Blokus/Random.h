@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// xoshiro256**, small and fast enough to be called for every playout move
+class Random {
+public:
+    explicit Random(std::uint64_t seed = 0) {
+        // splitmix64 to spread the seed over the whole state
+        for (auto& word : state) {
+            seed += 0x9E3779B97F4A7C15ull;
+            auto z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t next() {
+        auto const result = rotate_left(state[1] * 5, 7) * 9;
+        auto const t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate_left(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound), bound must not be 0
+    std::uint32_t uniform(std::uint32_t bound) {
+        return static_cast<std::uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double uniform_real() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    static std::uint64_t rotate_left(std::uint64_t value, int count) {
+        return (value << count) | (value >> (64 - count));
+    }
+
+    std::uint64_t state[4];
+};
+
+}
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "RecordValidation.h"
+
+#include "MoveGeneration.h"
+
+namespace blokus {
+
+std::string_view get_status_name(RecordStatus status) {
+    switch (status) {
+    case RecordStatus::Valid:           return "valid";
+    case RecordStatus::InvalidPlayers:  return "invalid players";
+    case RecordStatus::IllegalMove:     return "illegal move";
+    case RecordStatus::MoveAfterEnd:    return "move after end";
+    case RecordStatus::Unfinished:      return "unfinished";
+    case RecordStatus::ScoreMismatch:   return "score mismatch";
+    }
+    return "unknown";
+}
+
+RecordCheck validate_record(GameRecord const& record) {
+    if (record.players.empty() || record.players.size() > Game::max_player_count) {
+        return { RecordStatus::InvalidPlayers, 0, Move::pass() };
+    }
+    std::uint8_t seated = 0;
+    for (auto const player : record.players) {
+        auto const bit = static_cast<std::uint8_t>(1 << to_index(player));
+        if ((seated & bit) != 0) {
+            return { RecordStatus::InvalidPlayers, 0, Move::pass() };
+        }
+        seated |= bit;
+    }
+
+    auto game = Game::CreateNew(record.players);
+    for (std::size_t ply = 0; ply < record.moves.size(); ++ply) {
+        auto const move = record.moves[ply];
+        if (game.is_over()) {
+            return { RecordStatus::MoveAfterEnd, ply, move };
+        }
+        if (!is_legal(game, move)) {
+            return { RecordStatus::IllegalMove, ply, move };
+        }
+        game.apply(move);
+    }
+    if (!game.is_over()) {
+        return { RecordStatus::Unfinished, record.moves.size(), Move::pass() };
+    }
+
+    if (record.scores.size() != record.players.size()) {
+        return { RecordStatus::ScoreMismatch, record.moves.size(), Move::pass() };
+    }
+    for (std::size_t i = 0; i < record.players.size(); ++i) {
+        if (record.scores[i] != game.get_score(record.players[i])) {
+            return { RecordStatus::ScoreMismatch, record.moves.size(), Move::pass() };
+        }
+    }
+    return {};
+}
+
+}
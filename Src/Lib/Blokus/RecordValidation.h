@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "GameRecord.h"
+#include "Move.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+enum class RecordStatus {
+    Valid,
+    InvalidPlayers,     // no player, or a color seated twice
+    IllegalMove,        // a move the rules don't allow, passing included while a piece still fits
+    MoveAfterEnd,       // moves past the end of the game
+    Unfinished,         // the moves stop before the end of the game
+    ScoreMismatch,      // the stored scores aren't the ones of the replayed game
+};
+
+constexpr std::size_t record_status_count = 6;
+
+std::string_view get_status_name(RecordStatus status);
+
+// First problem found while replaying a record
+struct RecordCheck {
+    RecordStatus status{ RecordStatus::Valid };
+    // Ply of the offending move, the move count when the problem is at the end of the game
+    std::size_t ply{ 0 };
+    Move move{ Move::pass() };
+};
+
+// Replays the record through the legality checks, then compares the stored scores with the ones of
+// the replayed game
+RecordCheck validate_record(GameRecord const& record);
+
+}
@@ -0,0 +1,304 @@
+#include "pch.h"
+#include "SearchGraph.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Evaluation.h"
+#include "MoveGeneration.h"
+#include "MoveList.h"
+
+namespace blokus {
+
+namespace {
+
+std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+// Value for the player to move plus the exploration bonus, unvisited edges first
+GraphEdge* select_edge(GraphNode& node, std::size_t player_index, float exploration) {
+    assert(node.edge_count > 0);
+
+    auto const log_visits = std::log(static_cast<float>(std::max(node.visits.load(std::memory_order_relaxed), 1u)));
+    GraphEdge* best = nullptr;
+    auto best_value = -std::numeric_limits<float>::infinity();
+
+    for (std::uint16_t i = 0; i < node.edge_count; ++i) {
+        auto& edge = node.edges[i];
+        auto const edge_visits = edge.visits.load(std::memory_order_relaxed);
+        if (edge_visits == 0) {
+            return &edge;
+        }
+        auto const* target = edge.target.load(std::memory_order_acquire);
+        auto const visits = static_cast<float>(edge_visits);
+        auto const value = (target != nullptr ? target->get_value(player_index) : 0.0f) + exploration * std::sqrt(log_visits / visits);
+        if (value > best_value) {
+            best_value = value;
+            best = &edge;
+        }
+    }
+    return best;
+}
+
+void simulate(Game& game, Random& random) {
+    MoveList moves;
+    while (!game.is_over()) {
+        generate_moves(game, moves);
+        game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+    }
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+std::uint64_t get_position_hash(Game const& game) {
+    std::uint64_t hash = 0x9E3779B97F4A7C15ull;
+    std::uint64_t finished = 0;
+    for (auto const player : game.get_players()) {
+        auto const& occupancy = game.get_occupancy(player);
+        for (int word = 0; word < Bitboard::word_count; ++word) {
+            hash = mix(hash ^ occupancy.get_word(word)) + to_index(player);
+        }
+        hash = mix(hash ^ game.get_remaining_pieces(player).get_bits());
+        finished = finished << 1 | (game.is_finished(player) ? 1 : 0);
+    }
+    hash = mix(hash ^ (finished << 8 | game.get_current_player_index()));
+    return hash == 0 ? 1 : hash;
+}
+
+// ----------------------------------------------------------------------------
+
+SearchGraph::SearchGraph(SearchGraphConfig config)
+    : config(config)
+{
+    auto const size = std::bit_ceil(std::max<std::size_t>(config.table_size, 2));
+    partition_count = std::min(std::bit_ceil(std::max<std::size_t>(config.partition_count, 1)), size / 2);
+    // The slots are only allocated by clear_partition, on the thread that is going to use them
+    partitions = std::make_unique<Partition[]>(partition_count);
+    slot_mask = size / partition_count - 1;
+}
+
+void SearchGraph::clear_partition(std::size_t partition_index) {
+    assert(partition_index < partition_count);
+    auto& partition = partitions[partition_index];
+    if (partition.cleared.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    if (!partition.slots) {
+        partition.slots = std::make_unique<Slot[]>(slot_mask + 1);
+    }
+    else if (partition.node_count.load(std::memory_order_relaxed) > 0) {
+        for (std::size_t i = 0; i <= slot_mask; ++i) {
+            partition.slots[i].hash.store(0, std::memory_order_relaxed);
+            partition.slots[i].node.store(nullptr, std::memory_order_relaxed);
+        }
+        partition.node_count = 0;
+    }
+}
+
+void SearchGraph::reset(Game const& game, std::size_t worker_count) {
+    assert(worker_count > 0);
+
+    for (std::size_t i = 0; i < partition_count; ++i) {
+        clear_partition(i);
+        partitions[i].cleared.store(false, std::memory_order_relaxed);
+    }
+
+    // The arenas keep their blocks for the next search
+    for (auto& worker : workers) {
+        worker.arena.reset();
+        worker.spare = nullptr;
+        worker.transposition_count = 0;
+        worker.failed_insertion_count = 0;
+    }
+    while (workers.size() < worker_count) {
+        workers.push_back({ Arena(config.arena) });
+    }
+    workers.erase(workers.begin() + static_cast<std::ptrdiff_t>(worker_count), workers.end());
+
+    root_game = game;
+    bool created = false;
+    root = find_or_insert(workers[0], get_position_hash(game), created);
+    assert(root != nullptr && "The table and arena must at least hold the root");
+}
+
+GraphNode* SearchGraph::find_or_insert(Worker& worker, std::uint64_t hash, bool& created) {
+    created = false;
+    // The high bits pick the part, the low ones the slot
+    auto& partition = partitions[static_cast<std::size_t>(hash >> 32) & (partition_count - 1)];
+    auto const full = partition.node_count.load(std::memory_order_relaxed) >= (slot_mask + 1) / 4 * 3;
+
+    for (auto index = static_cast<std::size_t>(hash) & slot_mask;; index = (index + 1) & slot_mask) {
+        auto& slot = partition.slots[index];
+        auto slot_hash = slot.hash.load(std::memory_order_acquire);
+
+        if (slot_hash == 0) {
+            if (full) {
+                return nullptr;
+            }
+            // Created before claiming the slot, so that a claimed slot always gets its node
+            if (worker.spare == nullptr) {
+                worker.spare = worker.arena.create<GraphNode>();
+                if (worker.spare == nullptr) {
+                    return nullptr;
+                }
+            }
+            if (slot.hash.compare_exchange_strong(slot_hash, hash, std::memory_order_acq_rel)) {
+                auto* node = std::exchange(worker.spare, nullptr);
+                node->hash = hash;
+                slot.node.store(node, std::memory_order_release);
+                partition.node_count.fetch_add(1, std::memory_order_relaxed);
+                created = true;
+                return node;
+            }
+            // Another thread claimed the slot first, slot_hash now holds its hash
+        }
+
+        if (slot_hash == hash) {
+            // The claiming thread stores the node right after the hash
+            auto* node = slot.node.load(std::memory_order_acquire);
+            while (node == nullptr) {
+                node = slot.node.load(std::memory_order_acquire);
+            }
+            return node;
+        }
+    }
+}
+
+bool SearchGraph::expand(Worker& worker, GraphNode& node, Game const& game) {
+    auto expected = GraphNode::State::Leaf;
+    if (!node.state.compare_exchange_strong(expected, GraphNode::State::Expanding, std::memory_order_acquire)) {
+        // Another thread is expanding it, or just did
+        return expected == GraphNode::State::Expanded;
+    }
+
+    MoveList moves;
+    generate_moves(game, moves);
+    auto const edges = worker.arena.create_array<GraphEdge>(moves.size());
+    if (edges.empty()) {
+        node.state.store(GraphNode::State::Leaf, std::memory_order_release);
+        return false;
+    }
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        edges[i].move = moves[i];
+    }
+    node.edge_count = static_cast<std::uint16_t>(moves.size());
+    node.edges = edges.data();
+    node.state.store(GraphNode::State::Expanded, std::memory_order_release);
+    return true;
+}
+
+bool SearchGraph::run_iteration(std::size_t worker_index, Random& random, float exploration) {
+    assert(has_root() && worker_index < workers.size());
+    auto& worker = workers[worker_index];
+
+    auto game = *root_game;
+    // A position can't come back once left, the path never holds a node twice
+    std::array<GraphNode*, Game::max_ply_count + 1> path;
+    std::size_t depth = 0;
+
+    auto* node = root;
+    node->visits.fetch_add(1, std::memory_order_relaxed);
+    path[depth++] = node;
+
+    auto inserted = true;
+    while (!game.is_over()) {
+        if (node->state.load(std::memory_order_acquire) != GraphNode::State::Expanded && !expand(worker, *node, game)) {
+            // Being expanded by another thread, or out of memory: the playout starts here
+            break;
+        }
+
+        auto& edge = *select_edge(*node, game.get_current_player_index(), exploration);
+        edge.visits.fetch_add(1, std::memory_order_relaxed);
+        game.apply(edge.move);
+
+        auto* next = edge.target.load(std::memory_order_acquire);
+        auto created = false;
+        if (next == nullptr) {
+            next = find_or_insert(worker, get_position_hash(game), created);
+            if (next == nullptr) {
+                ++worker.failed_insertion_count;
+                inserted = false;
+                break;
+            }
+            if (!created) {
+                ++worker.transposition_count;
+            }
+            edge.target.store(next, std::memory_order_release);
+        }
+
+        next->visits.fetch_add(1, std::memory_order_relaxed);
+        path[depth++] = next;
+        node = next;
+        if (created) {
+            break;
+        }
+    }
+
+    simulate(game, random);
+    auto const rewards = get_rewards(game);
+
+    for (std::size_t i = 0; i < depth; ++i) {
+        for (std::size_t player = 0; player < game.get_players().size(); ++player) {
+            path[i]->reward_sums[player].fetch_add(rewards[player], std::memory_order_relaxed);
+        }
+    }
+    return inserted;
+}
+
+Move SearchGraph::get_best_move() const {
+    assert(has_root());
+
+    if (root->state.load(std::memory_order_acquire) != GraphNode::State::Expanded) {
+        MoveList moves;
+        generate_moves(*root_game, moves);
+        return moves.empty() ? Move::pass() : moves[0];
+    }
+
+    auto const* best = &root->edges[0];
+    for (std::uint16_t i = 1; i < root->edge_count; ++i) {
+        if (root->edges[i].visits.load(std::memory_order_relaxed) > best->visits.load(std::memory_order_relaxed)) {
+            best = &root->edges[i];
+        }
+    }
+    return best->move;
+}
+
+SearchGraphStatistics SearchGraph::get_statistics() const {
+    SearchGraphStatistics result;
+    for (std::size_t i = 0; i < partition_count; ++i) {
+        result.node_count += partitions[i].node_count.load(std::memory_order_relaxed);
+    }
+    for (auto const& worker : workers) {
+        result.transposition_count += worker.transposition_count;
+        result.failed_insertion_count += worker.failed_insertion_count;
+    }
+    return result;
+}
+
+ArenaStatistics SearchGraph::get_arena_statistics() const {
+    ArenaStatistics result;
+    for (auto const& worker : workers) {
+        auto const statistics = worker.arena.get_statistics();
+        result.used_size += statistics.used_size;
+        result.reserved_size += statistics.reserved_size;
+        result.high_water_mark += statistics.high_water_mark;
+        result.block_count += statistics.block_count;
+        result.failed_allocation_count += statistics.failed_allocation_count;
+    }
+    return result;
+}
+
+}
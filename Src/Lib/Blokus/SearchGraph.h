@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Arena.h"
+#include "Game.h"
+#include "Move.h"
+#include "Random.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Hash of what the rest of the game depends on: the pieces of each player on the board and in hand,
+// the finished players and the player to move. Move orders reaching the same board share it.
+// The monomino bonus is left out, the playouts score it from their own history. Never zero.
+std::uint64_t get_position_hash(Game const& game);
+
+// ----------------------------------------------------------------------------
+
+struct GraphNode;
+
+// Move out of a position, its visits only count the iterations that went through this move
+struct GraphEdge {
+    Move move{ Move::pass() };
+    std::atomic<std::uint32_t> visits{ 0 };
+    // Resolved on the first visit, possibly to a node another path already created
+    std::atomic<GraphNode*> target{ nullptr };
+};
+
+// One node per position however it was reached, the edges leading to it share its statistics.
+// Nodes and edge arrays live in the arena of the thread that created them.
+struct GraphNode {
+    enum class State : std::uint8_t { Leaf, Expanding, Expanded };
+
+    std::uint64_t hash{ 0 };
+    // Counted when an iteration goes through, before its playout: the pending visits lower the
+    // values seen by the other threads and spread them over the graph (virtual loss)
+    std::atomic<std::uint32_t> visits{ 0 };
+    // Indexed by the player position in Game::get_players()
+    std::array<std::atomic<float>, Game::max_player_count> reward_sums{};
+    // The edges may only be read once the state is Expanded
+    std::atomic<State> state{ State::Leaf };
+    std::uint16_t edge_count{ 0 };
+    GraphEdge* edges{ nullptr };
+
+    float get_value(std::size_t player_index) const {
+        auto const count = visits.load(std::memory_order_relaxed);
+        return count == 0 ? 0.0f : reward_sums[player_index].load(std::memory_order_relaxed) / static_cast<float>(count);
+    }
+};
+
+struct SearchGraphConfig {
+    // Slots of the position table, rounded up to a power of two. New positions stop being added
+    // once it is three quarters full, the iterations then end at the last known node.
+    std::size_t table_size{ std::size_t{ 1 } << 18 };
+    // The table split in that many parts, rounded up to a power of two, the hash of a position picks
+    // its part. Each part counts its own nodes, and is allocated and cleared by whichever thread calls
+    // clear_partition: with a part per NUMA node, cleared from a thread of that node, the table is
+    // spread over the nodes instead of all landing on the one that created it.
+    std::size_t partition_count{ 1 };
+    // Per thread, its memory lands on the node of the thread that first touches it
+    ArenaConfig arena{};
+};
+
+struct SearchGraphStatistics {
+    std::size_t node_count{ 0 };
+    // Edges resolved to a node that already existed, reached through another move order
+    std::size_t transposition_count{ 0 };
+    // Iterations that couldn't add their node, the table or an arena being full
+    std::size_t failed_insertion_count{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Monte Carlo search over the graph of positions: a hash table maps each position to its node, so
+// transposed move orders share their visits and values instead of growing separate subtrees.
+// Several threads can run iterations at once, each with its own worker index. Nodes are inserted
+// without locks: a slot is claimed by swapping its hash in and the node pointer follows, and an
+// edge is expanded by the single thread that moved its node to the Expanding state.
+class SearchGraph {
+public:
+    explicit SearchGraph(SearchGraphConfig config = {});
+
+    // Drops the whole graph and restarts from the game position, with an arena per worker.
+    // Clears the parts of the table no clear_partition call cleared since the last reset.
+    void reset(Game const& game, std::size_t worker_count);
+
+    // Clears the part of the table ahead of the next reset, allocating it on the first call.
+    // Thread safe, the first call for a part does the work and the others return at once.
+    void clear_partition(std::size_t partition);
+    std::size_t get_partition_count() const { return partition_count; }
+
+    bool has_root() const { return root != nullptr; }
+    Game const& get_root_game() const { return *root_game; }
+    GraphNode const& get_root() const { return *root; }
+
+    // One selection, expansion, simulation and backpropagation pass. Thread safe as long as each
+    // thread uses its own worker index and the graph isn't reset meanwhile.
+    // Returns false when the new position couldn't be added, the statistics are still updated.
+    bool run_iteration(std::size_t worker, Random& random, float exploration);
+
+    // Most visited root move, the first legal move when the root was never expanded
+    Move get_best_move() const;
+
+    SearchGraphStatistics get_statistics() const;
+
+    // Every worker arena together
+    ArenaStatistics get_arena_statistics() const;
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> hash{ 0 };
+        std::atomic<GraphNode*> node{ nullptr };
+    };
+
+    struct Partition {
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::size_t> node_count{ 0 };
+        std::atomic<bool> cleared{ false };
+        // Keeps the counters of the parts on their own cache lines, see BoundedQueue
+        char padding[64]{};
+    };
+
+    struct Worker {
+        Arena arena;
+        // Created for an insertion another thread won, kept for the next one
+        GraphNode* spare{ nullptr };
+        std::size_t transposition_count{ 0 };
+        std::size_t failed_insertion_count{ 0 };
+    };
+
+    // The node of the position, created when missing. Sets created when this call added it.
+    GraphNode* find_or_insert(Worker& worker, std::uint64_t hash, bool& created);
+    bool expand(Worker& worker, GraphNode& node, Game const& game);
+
+    SearchGraphConfig config;
+    std::unique_ptr<Partition[]> partitions;
+    std::size_t partition_count{ 1 };
+    // Slots of each part
+    std::size_t slot_mask{ 0 };
+    std::vector<Worker> workers;
+    std::optional<Game> root_game;
+    GraphNode* root{ nullptr };
+};
+
+}
@@ -0,0 +1,264 @@
+#include "pch.h"
+#include "SearchTree.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Evaluation.h"
+#include "LinearModel.h"
+#include "MoveGeneration.h"
+#include "MoveList.h"
+
+namespace blokus {
+
+namespace {
+
+// An unvisited move counts as a draw against the prior weighted exploration term
+Node* select_child_by_prior(Node& node, float exploration) {
+    assert(node.is_expanded() && node.child_count > 0);
+
+    auto const scale = exploration * std::sqrt(static_cast<float>(node.visits)) / 65535.0f;
+    Node* best = nullptr;
+    auto best_value = -std::numeric_limits<float>::infinity();
+
+    for (std::uint16_t i = 0; i < node.child_count; ++i) {
+        auto& child = node.children[i];
+        auto const visits = static_cast<float>(child.visits);
+        auto const mean = child.visits == 0 ? 0.5f : child.value_sum / visits;
+        auto const value = mean + scale * static_cast<float>(child.prior) / (1.0f + visits);
+        if (value > best_value) {
+            best_value = value;
+            best = &child;
+        }
+    }
+    return best;
+}
+
+Node* select_child(Node& node, float exploration) {
+    assert(node.is_expanded() && node.child_count > 0);
+
+    auto const log_visits = std::log(static_cast<float>(node.visits));
+    Node* best = nullptr;
+    auto best_value = -std::numeric_limits<float>::infinity();
+
+    for (std::uint16_t i = 0; i < node.child_count; ++i) {
+        auto& child = node.children[i];
+        if (child.visits == 0) {
+            return &child;
+        }
+        auto const visits = static_cast<float>(child.visits);
+        auto const value = child.value_sum / visits + exploration * std::sqrt(log_visits / visits);
+        if (value > best_value) {
+            best_value = value;
+            best = &child;
+        }
+    }
+    return best;
+}
+
+void simulate(Game& game, Random& random) {
+    MoveList moves;
+    while (!game.is_over()) {
+        generate_moves(game, moves);
+        game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+    }
+}
+
+// Each arena of the tree holds at most half of the configured memory, a compaction copies at most
+// the whole active arena into the spare one
+ArenaConfig get_half_config(ArenaConfig config) {
+    if (config.max_reserved_size != 0) {
+        config.max_reserved_size = std::max<std::size_t>(config.max_reserved_size / 2, 1);
+        config.block_size = std::min(config.block_size, config.max_reserved_size);
+    }
+    return config;
+}
+
+}
+
+SearchTree::SearchTree(ArenaConfig arena_config, LinearModel const* model)
+    : model(model)
+    , arena(get_half_config(arena_config))
+    , spare_arena(get_half_config(arena_config))
+{}
+
+void SearchTree::reset(Game const& game) {
+    arena.reset();
+    root_game = game;
+    root = arena.create<Node>();
+    assert(root != nullptr && "The arena must at least hold the root");
+}
+
+Node* SearchTree::find_node(Game const& game) const {
+    auto const& root_position = *root_game;
+    if (game.get_ply() < root_position.get_ply() ||
+        !std::ranges::equal(game.get_players(), root_position.get_players())) {
+        return nullptr;
+    }
+    for (std::size_t ply = 0; ply < root_position.get_ply(); ++ply) {
+        if (game.get_move(ply) != root_position.get_move(ply)) {
+            return nullptr;
+        }
+    }
+
+    auto* node = root;
+    for (auto ply = root_position.get_ply(); ply < game.get_ply(); ++ply) {
+        auto const move = game.get_move(ply);
+        auto const children = std::span{ node->children, node->child_count };
+        auto const child = std::ranges::find(children, move, &Node::move);
+        if (child == children.end()) {
+            return nullptr;
+        }
+        node = &*child;
+    }
+    return node;
+}
+
+bool SearchTree::advance(Game const& game) {
+    if (!has_root()) {
+        return false;
+    }
+
+    auto const* source_root = find_node(game);
+    if (source_root == nullptr) {
+        return false;
+    }
+
+    // Breadth first copy, a child array that doesn't fit anymore is dropped with its subtree
+    spare_arena.reset();
+    auto* new_root = spare_arena.create<Node>(*source_root);
+    assert(new_root != nullptr && "The arena must at least hold the root");
+
+    std::vector<Node*> pending{ new_root };
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        auto& node = *pending[i];
+        if (!node.is_expanded()) {
+            continue;
+        }
+        auto const children = spare_arena.create_array<Node>(node.child_count);
+        if (children.empty()) {
+            node.children = nullptr;
+            node.child_count = 0;
+            continue;
+        }
+        std::ranges::copy(std::span{ node.children, node.child_count }, children.begin());
+        node.children = children.data();
+        for (auto& child : children) {
+            pending.push_back(&child);
+        }
+    }
+
+    advance_high_water_mark = std::max(advance_high_water_mark, arena.get_statistics().used_size + spare_arena.get_statistics().used_size);
+    std::swap(arena, spare_arena);
+    spare_arena.reset();
+    root_game = game;
+    root = new_root;
+    return true;
+}
+
+bool SearchTree::expand(Node& node, Game const& game) {
+    MoveList moves;
+    generate_moves(game, moves);
+
+    auto const children = arena.create_array<Node>(moves.size());
+    if (children.empty()) {
+        return false;
+    }
+
+    auto const player_index = static_cast<std::uint8_t>(game.get_current_player_index());
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        children[i].move = moves[i];
+        children[i].player_index = player_index;
+    }
+    if (model != nullptr) {
+        std::array<float, MoveList::capacity> priors;
+        model->get_priors(game, moves, std::span{ priors.data(), moves.size() });
+        for (std::size_t i = 0; i < moves.size(); ++i) {
+            children[i].prior = static_cast<std::uint16_t>(std::lround(priors[i] * 65535.0f));
+        }
+    }
+    node.child_count = static_cast<std::uint16_t>(moves.size());
+    node.children = children.data();
+    return true;
+}
+
+bool SearchTree::run_iteration(Random& random, float exploration) {
+    assert(has_root());
+
+    auto game = *root_game;
+    std::array<Node*, Game::max_ply_count + 1> path;
+    std::size_t depth = 0;
+
+    auto const select = model != nullptr ? select_child_by_prior : select_child;
+    auto* node = root;
+    path[depth++] = node;
+    while (node->is_expanded()) {
+        node = select(*node, exploration);
+        game.apply(node->move);
+        path[depth++] = node;
+    }
+
+    bool expanded = true;
+    if (!game.is_over()) {
+        expanded = expand(*node, game);
+        if (expanded) {
+            node = select(*node, exploration);
+            game.apply(node->move);
+            path[depth++] = node;
+        }
+    }
+
+    Rewards rewards;
+    if (model != nullptr && !game.is_over()) {
+        rewards = model->evaluate(game);
+    }
+    else {
+        simulate(game, random);
+        rewards = get_rewards(game);
+    }
+
+    root->visits++;
+    for (std::size_t i = 1; i < depth; ++i) {
+        path[i]->visits++;
+        path[i]->value_sum += rewards[path[i]->player_index];
+    }
+    return expanded;
+}
+
+Move SearchTree::get_best_move() const {
+    assert(has_root());
+
+    if (!root->is_expanded()) {
+        MoveList moves;
+        generate_moves(*root_game, moves);
+        return moves.empty() ? Move::pass() : moves[0];
+    }
+
+    auto const* best = &root->children[0];
+    for (std::uint16_t i = 1; i < root->child_count; ++i) {
+        if (root->children[i].visits > best->visits) {
+            best = &root->children[i];
+        }
+    }
+    return best->move;
+}
+
+ArenaStatistics SearchTree::get_arena_statistics() const {
+    auto const active = arena.get_statistics();
+    auto const spare = spare_arena.get_statistics();
+    return {
+        .used_size = active.used_size + spare.used_size,
+        .reserved_size = active.reserved_size + spare.reserved_size,
+        .high_water_mark = std::max({ active.high_water_mark, spare.high_water_mark, advance_high_water_mark }),
+        .block_count = active.block_count + spare.block_count,
+        .failed_allocation_count = active.failed_allocation_count + spare.failed_allocation_count,
+    };
+}
+
+}
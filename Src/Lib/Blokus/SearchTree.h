@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "Arena.h"
+#include "Game.h"
+#include "Move.h"
+#include "Random.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+class LinearModel;
+
+// Tree nodes and children arrays live in the tree arena
+struct Node {
+    Move move{ Move::pass() };
+    // Position in Game::get_players() of the player who played the move
+    std::uint8_t player_index{ 0 };
+    std::uint16_t child_count{ 0 };
+    // Probability of the move given by the model, in 1/65535 units to fit the padding
+    std::uint16_t prior{ 0 };
+    std::uint32_t visits{ 0 };
+    // Sum of the rewards of the player who played the move
+    float value_sum{ 0.0f };
+    Node* children{ nullptr };
+
+    bool is_expanded() const { return children != nullptr; }
+};
+
+// ----------------------------------------------------------------------------
+
+// Monte Carlo search tree of a single game position.
+// Without a model the selection is UCT and the leaves are scored by random playouts. With a model
+// the selection follows the priors of the moves (PUCT) and the model scores the leaves instead.
+class SearchTree {
+public:
+    // The model, when given, must outlive the tree. A maximum reserved size in the arena
+    // configuration bounds the tree as a whole, each of its two arenas gets half of it.
+    explicit SearchTree(ArenaConfig arena_config = {}, LinearModel const* model = nullptr);
+
+    // Drops the whole tree and restarts from the game position
+    void reset(Game const& game);
+
+    // Promotes the subtree reached by the moves played since the root to the new root.
+    // The subtree is compacted into the spare arena so that its statistics carry over.
+    // Returns false, leaving the tree untouched, when the game doesn't continue the root
+    // position or the played moves leave the explored tree.
+    bool advance(Game const& game);
+
+    bool has_root() const { return root != nullptr; }
+    Game const& get_root_game() const { return *root_game; }
+    Node const& get_root() const { return *root; }
+
+    // One selection, expansion, simulation and backpropagation pass.
+    // Returns false when the arena is full, the tree then stops growing but the statistics are still updated.
+    bool run_iteration(Random& random, float exploration);
+
+    // Most visited root child, the first legal move when the root was never expanded
+    Move get_best_move() const;
+
+    // Both arenas together, the spare one is only used while advancing. The high water mark
+    // includes the peak of advance(), when both arenas hold a copy of the subtree.
+    ArenaStatistics get_arena_statistics() const;
+
+private:
+    bool expand(Node& node, Game const& game);
+    Node* find_node(Game const& game) const;
+
+    LinearModel const* model;
+    Arena arena;
+    // Target of the compaction done by advance(), swapped with arena afterwards
+    Arena spare_arena;
+    // Used size of both arenas at the end of the largest compaction
+    std::size_t advance_high_water_mark{ 0 };
+    std::optional<Game> root_game;
+    Node* root{ nullptr };
+};
+
+}
@@ -0,0 +1,373 @@
+#include "pch.h"
+#include "SelfPlayCoordinator.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "RecordValidation.h"
+
+namespace blokus {
+
+SelfPlayCoordinator::SelfPlayCoordinator(SelfPlayCoordinatorConfig config, BatchCallback on_batch)
+    : config(std::move(config))
+    , on_batch(std::move(on_batch))
+    , listener(Socket::listen_tcp(this->config.host, this->config.port))
+    , port(listener.get_local_port())
+{
+    listener.set_non_blocking(true);
+    poller.add(listener.get_handle(), listener_key);
+
+    std::tie(wake_reader, wake_writer) = Socket::make_pair();
+    wake_reader.set_non_blocking(true);
+    wake_writer.set_non_blocking(true);
+    poller.add(wake_reader.get_handle(), wake_key);
+}
+
+void SelfPlayCoordinator::run() {
+    std::vector<PollEvent> events;
+    std::optional<Clock::time_point> finished_at;
+    while (!stopping.load()) {
+        // The timeout also paces the lease checks
+        poller.wait(events, std::chrono::milliseconds(100));
+        for (auto const& event : events) {
+            if (event.key == listener_key) {
+                accept_sessions();
+                continue;
+            }
+            if (event.key == wake_key) {
+                std::array<char, 256> buffer;
+                while (wake_reader.receive(buffer).status == IoStatus::Done) {
+                }
+                continue;
+            }
+
+            auto const found = sessions.find(event.key);
+            if (found == sessions.end()) {
+                continue;
+            }
+            auto& session = *found->second;
+            if (event.readable || event.closed) {
+                read(event.key, session);
+            }
+            if (event.writable && sessions.contains(event.key)) {
+                flush(event.key, session);
+            }
+        }
+
+        expire_leases();
+        if (is_finished()) {
+            auto const now = Clock::now();
+            finished_at = finished_at.value_or(now);
+            if (sessions.empty() || now - *finished_at >= config.linger) {
+                return;
+            }
+        }
+    }
+}
+
+void SelfPlayCoordinator::stop() {
+    stopping.store(true);
+    wake();
+}
+
+void SelfPlayCoordinator::wake() {
+    char const byte = 0;
+    wake_writer.send({ &byte, 1 });
+}
+
+void SelfPlayCoordinator::set_model(std::string bytes) {
+    std::string line;
+    append_hex(line, bytes);
+    std::scoped_lock lock(model_mutex);
+    model = std::make_shared<std::string const>(std::move(line));
+    ++model_generation;
+}
+
+SelfPlayCoordinatorStatistics SelfPlayCoordinator::get_statistics() const {
+    std::scoped_lock lock(statistics_mutex);
+    return statistics;
+}
+
+bool SelfPlayCoordinator::is_finished() const {
+    return config.games != 0 && planned_games >= config.games && open_batches.empty();
+}
+
+// ----------------------------------------------------------------------------
+
+void SelfPlayCoordinator::accept_sessions() {
+    while (true) {
+        auto socket = listener.accept();
+        if (!socket.is_valid()) {
+            return;
+        }
+        if (sessions.size() >= config.max_workers) {
+            continue;
+        }
+
+        socket.set_non_blocking(true);
+        socket.set_no_delay(true);
+        auto const key = next_session_key++;
+        poller.add(socket.get_handle(), key);
+        auto session = std::make_unique<Session>();
+        session->socket = std::move(socket);
+        sessions.emplace(key, std::move(session));
+        std::scoped_lock lock(statistics_mutex);
+        ++statistics.worker_count;
+    }
+}
+
+void SelfPlayCoordinator::read(std::uint64_t key, Session& session) {
+    std::array<char, 4096> buffer;
+    while (true) {
+        auto const result = session.socket.receive(buffer);
+        if (result.status == IoStatus::WouldBlock) {
+            break;
+        }
+        if (result.status != IoStatus::Done) {
+            close_session(key);
+            return;
+        }
+        session.input.append(buffer.data(), result.size);
+        if (result.size < buffer.size()) {
+            break;
+        }
+    }
+
+    std::size_t consumed = 0;
+    while (true) {
+        auto const end = session.input.find('\n', consumed);
+        if (end == std::string::npos) {
+            break;
+        }
+        auto const line = std::string_view(session.input).substr(consumed, end - consumed);
+        consumed = end + 1;
+
+        if (auto const request = parse_worker_request(line)) {
+            handle_request(key, session, *request);
+        }
+        else {
+            session.output += "error malformed request\n";
+        }
+        // Each model request adds a whole model, a worker must not pile them up without reading
+        if (session.output.size() > config.max_pending_output) {
+            close_session(key);
+            return;
+        }
+    }
+    session.input.erase(0, consumed);
+
+    if (session.input.size() > config.max_line_size) {
+        close_session(key);
+        return;
+    }
+    flush(key, session);
+}
+
+void SelfPlayCoordinator::handle_request(std::uint64_t key, Session& session, WorkerRequest const& request) {
+    auto& output = session.output;
+
+    if (request.type == WorkerRequestType::Hello) {
+        if (request.version != self_play_protocol_version) {
+            output += "error protocol version " + std::to_string(self_play_protocol_version) + '\n';
+            return;
+        }
+        session.greeted = true;
+        output += "welcome\n";
+        return;
+    }
+    if (!session.greeted) {
+        output += "error hello first\n";
+        return;
+    }
+
+    switch (request.type) {
+    case WorkerRequestType::Batch:
+        hand_out(key, session);
+        return;
+
+    case WorkerRequestType::Result:
+        receive_result(session, request);
+        return;
+
+    case WorkerRequestType::Model: {
+        std::shared_ptr<std::string const> bytes;
+        std::uint32_t generation = 0;
+        {
+            std::scoped_lock lock(model_mutex);
+            bytes = model;
+            generation = model_generation;
+        }
+        output += "model " + std::to_string(generation);
+        if (bytes) {
+            output += ' ';
+            output += *bytes;
+        }
+        output += '\n';
+        return;
+    }
+
+    default:
+        return;
+    }
+}
+
+void SelfPlayCoordinator::hand_out(std::uint64_t key, Session& session) {
+    // Batches can complete while queued, from the results of the worker that gave them up
+    while (!queued_batches.empty() && !open_batches.contains(queued_batches.front())) {
+        queued_batches.pop_front();
+    }
+
+    Batch* batch = nullptr;
+    auto reassigned = false;
+    if (!queued_batches.empty()) {
+        batch = &open_batches.at(queued_batches.front());
+        queued_batches.pop_front();
+        reassigned = true;
+    }
+    else if (config.games == 0 || planned_games < config.games) {
+        auto const game_count = config.games == 0
+            ? config.batch_games
+            : static_cast<std::uint32_t>(std::min<std::uint64_t>(config.batch_games, config.games - planned_games));
+        auto const id = next_batch_id++;
+        batch = &open_batches[id];
+        batch->assignment = {
+            .id = id,
+            .seed = config.seed + id * config.batch_games,
+            .game_count = game_count,
+            .iterations = config.iterations,
+            .random_plies = config.random_plies,
+        };
+        batch->records.resize(game_count);
+        planned_games += game_count;
+    }
+    else {
+        session.output += open_batches.empty() ? std::string("done\n") : "wait " + std::to_string(config.retry_delay.count()) + '\n';
+        return;
+    }
+
+    {
+        std::scoped_lock lock(model_mutex);
+        batch->assignment.model_generation = model_generation;
+    }
+    batch->session_key = key;
+    batch->lease_end = Clock::now() + config.lease;
+    session.output += format_batch(batch->assignment) + '\n';
+
+    std::scoped_lock lock(statistics_mutex);
+    ++statistics.handed_out;
+    if (reassigned) {
+        ++statistics.reassigned;
+    }
+}
+
+void SelfPlayCoordinator::receive_result(Session& session, WorkerRequest const& request) {
+    auto& output = session.output;
+    auto const found = open_batches.find(request.batch_id);
+    if (found == open_batches.end()) {
+        if (request.batch_id >= next_batch_id) {
+            output += "error unknown batch\n";
+            return;
+        }
+        // Completed from the results of another worker
+        std::scoped_lock lock(statistics_mutex);
+        ++statistics.duplicates;
+        output += "ok\n";
+        return;
+    }
+
+    auto& batch = found->second;
+    if (request.game_index >= batch.records.size()) {
+        output += "error unknown game\n";
+        return;
+    }
+    if (batch.records[request.game_index]) {
+        std::scoped_lock lock(statistics_mutex);
+        ++statistics.duplicates;
+        output += "ok\n";
+        return;
+    }
+    // Workers are trusted with the search, not with the rules
+    if (validate_record(request.record).status != RecordStatus::Valid) {
+        std::scoped_lock lock(statistics_mutex);
+        ++statistics.rejected;
+        output += "error invalid game\n";
+        return;
+    }
+
+    batch.records[request.game_index] = request.record;
+    output += "ok\n";
+    if (++batch.received < batch.records.size()) {
+        // The batch is making progress, its worker gets more time
+        batch.lease_end = Clock::now() + config.lease;
+        return;
+    }
+
+    CompletedBatch completed;
+    completed.id = batch.assignment.id;
+    completed.records.reserve(batch.records.size());
+    for (auto& record : batch.records) {
+        completed.records.push_back(std::move(*record));
+    }
+    open_batches.erase(found);
+    {
+        std::scoped_lock lock(statistics_mutex);
+        ++statistics.completed;
+    }
+    on_batch(std::move(completed));
+}
+
+void SelfPlayCoordinator::flush(std::uint64_t key, Session& session) {
+    while (!session.output.empty()) {
+        auto const result = session.socket.send(session.output);
+        if (result.status == IoStatus::WouldBlock) {
+            break;
+        }
+        if (result.status != IoStatus::Done) {
+            close_session(key);
+            return;
+        }
+        session.output.erase(0, result.size);
+    }
+    if (session.output.size() > config.max_pending_output) {
+        close_session(key);
+        return;
+    }
+
+    auto const watch_writes = !session.output.empty();
+    if (watch_writes != session.watching_writes) {
+        session.watching_writes = watch_writes;
+        poller.modify(session.socket.get_handle(), key, watch_writes);
+    }
+}
+
+void SelfPlayCoordinator::close_session(std::uint64_t key) {
+    for (auto& [id, batch] : open_batches) {
+        if (batch.session_key == key) {
+            requeue(batch);
+        }
+    }
+
+    auto const found = sessions.find(key);
+    poller.remove(found->second->socket.get_handle());
+    sessions.erase(found);
+    std::scoped_lock lock(statistics_mutex);
+    --statistics.worker_count;
+}
+
+// Handed out again before any new batch, the games already received stay
+void SelfPlayCoordinator::requeue(Batch& batch) {
+    batch.session_key = 0;
+    queued_batches.push_front(batch.assignment.id);
+}
+
+void SelfPlayCoordinator::expire_leases() {
+    auto const now = Clock::now();
+    for (auto& [id, batch] : open_batches) {
+        if (batch.session_key != 0 && now >= batch.lease_end) {
+            requeue(batch);
+        }
+    }
+}
+
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "GameRecord.h"
+#include "Poller.h"
+#include "SelfPlayProtocol.h"
+#include "Socket.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct SelfPlayCoordinatorConfig {
+    std::string host{ "127.0.0.1" };
+    // Zero picks any free port, see SelfPlayCoordinator::get_port
+    std::uint16_t port{ 0 };
+    // Zero hands out batches until stopped
+    std::uint64_t games{ 0 };
+    std::uint32_t batch_games{ 16 };
+    // Batch i seeds its games from seed + i * batch_games
+    std::uint64_t seed{ 0 };
+    std::uint32_t iterations{ 1000 };
+    std::uint32_t random_plies{ 4 };
+    // A batch without any game back for that long goes to the next worker asking, its worker may have hung
+    std::chrono::milliseconds lease{ std::chrono::minutes(10) };
+    // How long idle workers are told to wait while the last batches may still come back
+    std::chrono::milliseconds retry_delay{ 1000 };
+    // Once every game is played, how long run goes on telling the workers still connected
+    std::chrono::milliseconds linger{ 5000 };
+    std::size_t max_workers{ 1024 };
+    // Result lines hold a whole game
+    std::size_t max_line_size{ 4096 };
+    // Replies not yet taken by a worker that doesn't read, more than this closes the session. Model
+    // replies hold a whole model in hex, some 600 KB for the linear one.
+    std::size_t max_pending_output{ 4 * 1024 * 1024 };
+};
+
+// Games of a batch in order, once every one of them came back
+struct CompletedBatch {
+    std::uint64_t id{ 0 };
+    std::vector<GameRecord> records;
+};
+
+using BatchCallback = std::function<void(CompletedBatch&&)>;
+
+struct SelfPlayCoordinatorStatistics {
+    std::size_t worker_count{ 0 };
+    std::uint64_t handed_out{ 0 };
+    std::uint64_t completed{ 0 };
+    // Batches handed out again after their worker left or its lease ran out
+    std::uint64_t reassigned{ 0 };
+    // Results of games already received, from a batch handed out twice
+    std::uint64_t duplicates{ 0 };
+    std::uint64_t rejected{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Hands out batches of self-play games to worker processes over the protocol of SelfPlayProtocol.h
+// and gathers their games, from a single event loop thread like the game server.
+// Workers come and go: the batches of a worker that disconnects, or stays silent past its lease, go
+// back to the queue, and the games already received for them are kept. A game is accepted once,
+// whichever worker sends it, and only after replaying as a valid record.
+class SelfPlayCoordinator {
+public:
+    // The callback runs on the event loop thread, in the order the batches complete
+    SelfPlayCoordinator(SelfPlayCoordinatorConfig config, BatchCallback on_batch);
+
+    SelfPlayCoordinator(SelfPlayCoordinator const&) = delete;
+    SelfPlayCoordinator& operator=(SelfPlayCoordinator const&) = delete;
+
+    std::uint16_t get_port() const { return port; }
+
+    // Runs the event loop until stop is called, or every game was played and the workers were told
+    void run();
+
+    // Can be called from any thread, or a signal handler
+    void stop();
+
+    // The model of the batches handed out from now on, in the layout of LinearModel::save. Workers
+    // fetch it when a batch names a generation they don't have. Can be called from any thread.
+    void set_model(std::string bytes);
+
+    SelfPlayCoordinatorStatistics get_statistics() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Session {
+        Socket socket;
+        std::string input;
+        std::string output;
+        bool greeted{ false };
+        bool watching_writes{ false };
+    };
+
+    struct Batch {
+        SelfPlayBatch assignment;
+        std::vector<std::optional<GameRecord>> records;
+        std::uint32_t received{ 0 };
+        // Zero while waiting in the queue
+        std::uint64_t session_key{ 0 };
+        Clock::time_point lease_end{};
+    };
+
+    void accept_sessions();
+    void read(std::uint64_t key, Session& session);
+    void handle_request(std::uint64_t key, Session& session, WorkerRequest const& request);
+    void hand_out(std::uint64_t key, Session& session);
+    void receive_result(Session& session, WorkerRequest const& request);
+    void flush(std::uint64_t key, Session& session);
+    void close_session(std::uint64_t key);
+    void requeue(Batch& batch);
+    void expire_leases();
+    bool is_finished() const;
+    void wake();
+
+    SelfPlayCoordinatorConfig config;
+    BatchCallback on_batch;
+    Socket listener;
+    std::uint16_t port{ 0 };
+    Poller poller;
+    Socket wake_reader;
+    Socket wake_writer;
+    std::unordered_map<std::uint64_t, std::unique_ptr<Session>> sessions;
+    std::uint64_t next_session_key{ first_session_key };
+    std::atomic<bool> stopping{ false };
+
+    // Batches handed out or queued, until all their games came back
+    std::map<std::uint64_t, Batch> open_batches;
+    std::deque<std::uint64_t> queued_batches;
+    std::uint64_t next_batch_id{ 0 };
+    std::uint64_t planned_games{ 0 };
+
+    mutable std::mutex model_mutex;
+    std::shared_ptr<std::string const> model;
+    std::uint32_t model_generation{ 0 };
+
+    mutable std::mutex statistics_mutex;
+    SelfPlayCoordinatorStatistics statistics;
+
+    static constexpr std::uint64_t listener_key = 0;
+    static constexpr std::uint64_t wake_key = 1;
+    static constexpr std::uint64_t first_session_key = 2;
+};
+
+}
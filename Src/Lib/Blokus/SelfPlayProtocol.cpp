@@ -0,0 +1,158 @@
+#include "pch.h"
+#include "SelfPlayProtocol.h"
+
+#include "Protocol.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr std::string_view hex_digits = "0123456789abcdef";
+
+std::optional<std::vector<int>> parse_scores(std::string_view text, std::size_t player_count) {
+    std::vector<int> scores;
+    while (true) {
+        auto const comma = text.find(',');
+        auto score = 0;
+        if (scores.size() == player_count || !parse_number(text.substr(0, comma), score)) {
+            return std::nullopt;
+        }
+        scores.push_back(score);
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        text.remove_prefix(comma + 1);
+    }
+    if (scores.size() != player_count) {
+        return std::nullopt;
+    }
+    return scores;
+}
+
+}
+
+std::optional<WorkerRequest> parse_worker_request(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    WorkerRequest request;
+    auto const name = next_token(line);
+
+    if (name == "hello") {
+        request.type = WorkerRequestType::Hello;
+        auto const version = parse_number<std::uint32_t>(next_token(line));
+        auto const worker = next_token(line);
+        if (!version || worker.empty()) {
+            return std::nullopt;
+        }
+        request.version = *version;
+        request.name = worker;
+    }
+    else if (name == "batch" || name == "model") {
+        request.type = name == "batch" ? WorkerRequestType::Batch : WorkerRequestType::Model;
+    }
+    else if (name == "result") {
+        request.type = WorkerRequestType::Result;
+        auto const batch_id = parse_number<std::uint64_t>(next_token(line));
+        auto const game_index = parse_number<std::uint32_t>(next_token(line));
+        auto players = parse_players(next_token(line));
+        if (!batch_id || !game_index || !players) {
+            return std::nullopt;
+        }
+        auto scores = parse_scores(next_token(line), players->size());
+        if (!scores) {
+            return std::nullopt;
+        }
+        request.batch_id = *batch_id;
+        request.game_index = *game_index;
+        request.record.players = std::move(*players);
+        request.record.scores = std::move(*scores);
+        // The moves run to the end of the line
+        for (auto token = next_token(line); !token.empty(); token = next_token(line)) {
+            auto const move = parse_move(token);
+            if (!move || request.record.moves.size() >= Game::max_ply_count) {
+                return std::nullopt;
+            }
+            request.record.moves.push_back(*move);
+        }
+    }
+    else {
+        return std::nullopt;
+    }
+
+    if (!next_token(line).empty()) {
+        return std::nullopt;
+    }
+    return request;
+}
+
+std::string format_result(std::uint64_t batch_id, std::uint32_t game_index, GameRecord const& record) {
+    auto line = "result " + std::to_string(batch_id) + ' ' + std::to_string(game_index) + ' ' + format_players(record.players);
+    for (std::size_t i = 0; i < record.scores.size(); ++i) {
+        line += i == 0 ? ' ' : ',';
+        line += std::to_string(record.scores[i]);
+    }
+    for (auto const move : record.moves) {
+        line += ' ';
+        append_move(line, move);
+    }
+    return line;
+}
+
+// ----------------------------------------------------------------------------
+
+std::string format_batch(SelfPlayBatch const& batch) {
+    return "batch " + std::to_string(batch.id) + ' ' + std::to_string(batch.seed) + ' ' + std::to_string(batch.game_count) + ' ' +
+        std::to_string(batch.iterations) + ' ' + std::to_string(batch.random_plies) + ' ' + std::to_string(batch.model_generation);
+}
+
+std::optional<SelfPlayBatch> parse_batch(std::string_view arguments) {
+    auto const id = parse_number<std::uint64_t>(next_token(arguments));
+    auto const seed = parse_number<std::uint64_t>(next_token(arguments));
+    auto const game_count = parse_number<std::uint32_t>(next_token(arguments));
+    auto const iterations = parse_number<std::uint32_t>(next_token(arguments));
+    auto const random_plies = parse_number<std::uint32_t>(next_token(arguments));
+    auto const model_generation = parse_number<std::uint32_t>(next_token(arguments));
+    if (!id || !seed || !game_count || !iterations || !random_plies || !model_generation || !next_token(arguments).empty()) {
+        return std::nullopt;
+    }
+    return SelfPlayBatch{
+        .id = *id,
+        .seed = *seed,
+        .game_count = *game_count,
+        .iterations = *iterations,
+        .random_plies = *random_plies,
+        .model_generation = *model_generation,
+    };
+}
+
+// ----------------------------------------------------------------------------
+
+void append_hex(std::string& line, std::span<char const> bytes) {
+    line.reserve(line.size() + bytes.size() * 2);
+    for (auto const byte : bytes) {
+        auto const value = static_cast<unsigned char>(byte);
+        line += hex_digits[value >> 4];
+        line += hex_digits[value & 15];
+    }
+}
+
+std::optional<std::string> parse_hex(std::string_view text) {
+    if (text.size() % 2 != 0) {
+        return std::nullopt;
+    }
+    std::string bytes;
+    bytes.reserve(text.size() / 2);
+    for (std::size_t i = 0; i < text.size(); i += 2) {
+        auto const high = hex_digits.find(text[i]);
+        auto const low = hex_digits.find(text[i + 1]);
+        if (high == std::string_view::npos || low == std::string_view::npos) {
+            return std::nullopt;
+        }
+        bytes += static_cast<char>(high << 4 | low);
+    }
+    return bytes;
+}
+
+}
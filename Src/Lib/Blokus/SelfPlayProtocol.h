@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "GameRecord.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Line protocol between the self-play coordinator and its workers, one reply line per request, in
+// order, written like the game server protocol (see Protocol.h).
+//
+//  hello <version> <name>                          -> welcome                 the name only helps reading traces
+//  batch                                           -> batch <id> <seed> <games> <iterations> <random plies> <model generation>
+//                                                  -> wait <milliseconds>     every game is handed out, some may come back
+//                                                  -> done                    every game was played
+//  result <batch id> <game> <players> <scores> <move>...
+//                                                  -> ok                      scores in seating order, comma separated
+//  model                                           -> model <generation> [<model file in hex>]
+//
+// Game i of a batch is played with the seed of the batch plus i. Model generation 0 is plain Mcts
+// without a model, the later ones count the models the coordinator was given.
+// Any failure replies "error <reason>" and the session goes on.
+constexpr std::uint32_t self_play_protocol_version = 2;
+
+enum class WorkerRequestType { Hello, Batch, Result, Model };
+
+struct WorkerRequest {
+    WorkerRequestType type{ WorkerRequestType::Batch };
+    std::uint32_t version{ 0 };
+    std::string name;
+    std::uint64_t batch_id{ 0 };
+    std::uint32_t game_index{ 0 };
+    GameRecord record;
+};
+
+// Nothing when the line is not a well formed request
+std::optional<WorkerRequest> parse_worker_request(std::string_view line);
+
+std::string format_result(std::uint64_t batch_id, std::uint32_t game_index, GameRecord const& record);
+
+// ----------------------------------------------------------------------------
+
+// Games handed out to a worker, with the settings to play them
+struct SelfPlayBatch {
+    std::uint64_t id{ 0 };
+    std::uint64_t seed{ 0 };
+    std::uint32_t game_count{ 0 };
+    std::uint32_t iterations{ 0 };
+    std::uint32_t random_plies{ 0 };
+    std::uint32_t model_generation{ 0 };
+};
+
+// The reply line to a batch request, without its new line
+std::string format_batch(SelfPlayBatch const& batch);
+// The arguments of a batch reply, after the reply name
+std::optional<SelfPlayBatch> parse_batch(std::string_view arguments);
+
+// ----------------------------------------------------------------------------
+
+// Two lower case hexadecimal digits per byte
+void append_hex(std::string& line, std::span<char const> bytes);
+std::optional<std::string> parse_hex(std::string_view text);
+
+}
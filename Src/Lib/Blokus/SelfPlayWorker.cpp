@@ -0,0 +1,166 @@
+#include "pch.h"
+#include "SelfPlayWorker.h"
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "MoveGeneration.h"
+#include "MoveList.h"
+#include "Protocol.h"
+
+namespace blokus {
+
+GameRecord play_self_play_game(Mcts& mcts, Random& random, std::size_t random_plies, std::stop_token stop) {
+    auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+    MoveList moves;
+    while (!game.is_over() && !stop.stop_requested()) {
+        if (game.get_ply() < random_plies) {
+            generate_moves(game, moves);
+            game.apply(moves[random.uniform(static_cast<std::uint32_t>(moves.size()))]);
+        }
+        else {
+            game.apply(mcts.search(game).best_move);
+        }
+    }
+    return GameRecord::from_game(game);
+}
+
+// ----------------------------------------------------------------------------
+
+SelfPlayWorker::SelfPlayWorker(SelfPlayWorkerConfig config, ThreadPool& pool)
+    : config(std::move(config))
+    , pool(pool)
+{}
+
+SelfPlayWorkerStatistics SelfPlayWorker::run(std::stop_token stop) {
+    last_contact = Clock::now();
+    std::string last_error;
+    while (!stop.stop_requested()) {
+        try {
+            GameClient connection(config.host, config.port);
+            if (run_session(connection, stop)) {
+                break;
+            }
+        }
+        catch (std::runtime_error const& error) {
+            last_error = error.what();
+        }
+        if (stop.stop_requested()) {
+            break;
+        }
+        if (Clock::now() - last_contact > config.reconnect) {
+            throw std::runtime_error("coordinator out of reach: " + last_error);
+        }
+        ++statistics.reconnects;
+        pause(config.reconnect_delay, stop);
+    }
+    return statistics;
+}
+
+bool SelfPlayWorker::run_session(GameClient& connection, std::stop_token stop) {
+    auto const welcome = connection.request("hello " + std::to_string(self_play_protocol_version) + ' ' + config.name);
+    if (welcome != "welcome") {
+        throw std::runtime_error("coordinator: " + welcome);
+    }
+    last_contact = Clock::now();
+    model_generation.reset();
+
+    while (!stop.stop_requested()) {
+        auto const reply = connection.request("batch");
+        last_contact = Clock::now();
+        std::string_view arguments = reply;
+        auto const name = next_token(arguments);
+        if (name == "done") {
+            return true;
+        }
+        if (name == "wait") {
+            pause(std::chrono::milliseconds(parse_number<std::uint32_t>(next_token(arguments)).value_or(1000)), stop);
+            continue;
+        }
+        auto const batch = name == "batch" ? parse_batch(arguments) : std::nullopt;
+        if (!batch) {
+            throw std::runtime_error("coordinator: " + reply);
+        }
+        if (batch->model_generation != model_generation) {
+            update_model(connection);
+        }
+        play_batch(connection, *batch, stop);
+    }
+    return false;
+}
+
+void SelfPlayWorker::play_batch(GameClient& connection, SelfPlayBatch const& batch, std::stop_token stop) {
+    std::vector<std::future<GameRecord>> games;
+    // Also on an exception, the games must not outlive the batch
+    struct WaitGuard {
+        std::vector<std::future<GameRecord>>& games;
+        ~WaitGuard() {
+            for (auto& game : games) {
+                if (game.valid()) {
+                    game.wait();
+                }
+            }
+        }
+    } const wait_guard{ games };
+
+    for (std::uint32_t i = 0; i < batch.game_count; ++i) {
+        auto const seed = batch.seed + i;
+        games.push_back(pool.submit([this, &batch, seed, stop] {
+            Mcts mcts({ .iterations = batch.iterations, .seed = seed, .model = model });
+            Random random(seed);
+            return play_self_play_game(mcts, random, batch.random_plies, stop);
+        }));
+    }
+
+    // Sent in order as they finish, the replies are only read at the end
+    for (std::uint32_t i = 0; i < batch.game_count; ++i) {
+        auto const record = games[i].get();
+        if (stop.stop_requested()) {
+            // Unfinished games, the coordinator hands the batch out again
+            return;
+        }
+        connection.send(format_result(batch.id, i, record));
+    }
+    for (std::uint32_t i = 0; i < batch.game_count; ++i) {
+        connection.receive();
+    }
+    last_contact = Clock::now();
+    ++statistics.batches;
+    statistics.games += batch.game_count;
+}
+
+void SelfPlayWorker::update_model(GameClient& connection) {
+    auto const reply = connection.request("model");
+    std::string_view arguments = reply;
+    auto const generation = next_token(arguments) == "model" ? parse_number<std::uint32_t>(next_token(arguments)) : std::nullopt;
+    if (!generation) {
+        throw std::runtime_error("coordinator: " + reply.substr(0, 256));
+    }
+
+    auto const hex = next_token(arguments);
+    if (hex.empty()) {
+        model = nullptr;
+    }
+    else {
+        auto const bytes = parse_hex(hex);
+        if (!bytes) {
+            throw std::runtime_error("coordinator: malformed model");
+        }
+        std::istringstream stream(*bytes);
+        model = std::make_shared<LinearModel const>(LinearModel::load(stream));
+    }
+    model_generation = *generation;
+}
+
+void SelfPlayWorker::pause(std::chrono::milliseconds duration, std::stop_token stop) const {
+    auto const end = Clock::now() + duration;
+    while (!stop.stop_requested() && Clock::now() < end) {
+        std::this_thread::sleep_for(std::min<Clock::duration>(end - Clock::now(), std::chrono::milliseconds(50)));
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <string>
+
+#include "GameClient.h"
+#include "GameRecord.h"
+#include "LinearModel.h"
+#include "Mcts.h"
+#include "Random.h"
+#include "SelfPlayProtocol.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// One self-play game from the four corners: the first plies at random so that the games differ, then
+// the best move of the search. Stops between two moves once the stop is requested, the record is then
+// unfinished.
+GameRecord play_self_play_game(Mcts& mcts, Random& random, std::size_t random_plies, std::stop_token stop = {});
+
+// ----------------------------------------------------------------------------
+
+struct SelfPlayWorkerConfig {
+    std::string host{ "127.0.0.1" };
+    std::uint16_t port{ 0 };
+    std::string name{ "worker" };
+    // The coordinator may restart, it is called again until it stays out of reach this long
+    std::chrono::milliseconds reconnect{ std::chrono::minutes(1) };
+    std::chrono::milliseconds reconnect_delay{ 500 };
+};
+
+struct SelfPlayWorkerStatistics {
+    std::uint64_t batches{ 0 };
+    std::uint64_t games{ 0 };
+    std::uint64_t reconnects{ 0 };
+};
+
+// Plays the batches of a coordinator, see SelfPlayProtocol.h, each game on a thread of the pool.
+// A lost connection drops the batch being played, the coordinator hands it out again.
+class SelfPlayWorker {
+public:
+    SelfPlayWorker(SelfPlayWorkerConfig config, ThreadPool& pool);
+
+    // Until the coordinator has no more games or the stop is requested. Throws std::runtime_error
+    // once the coordinator can't be reached for longer than the reconnect delay.
+    SelfPlayWorkerStatistics run(std::stop_token stop = {});
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // True once the coordinator is done, throws std::runtime_error when the connection is lost
+    bool run_session(GameClient& connection, std::stop_token stop);
+    void play_batch(GameClient& connection, SelfPlayBatch const& batch, std::stop_token stop);
+    void update_model(GameClient& connection);
+    void pause(std::chrono::milliseconds duration, std::stop_token stop) const;
+
+    SelfPlayWorkerConfig config;
+    ThreadPool& pool;
+    std::shared_ptr<LinearModel const> model;
+    // Only known within the session that fetched the model, a restarted coordinator counts its
+    // models from 1 again
+    std::optional<std::uint32_t> model_generation;
+    Clock::time_point last_contact;
+    SelfPlayWorkerStatistics statistics;
+};
+
+}
@@ -0,0 +1,161 @@
+#include "pch.h"
+#include "Shard.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#include "Compression.h"
+
+namespace blokus {
+
+namespace {
+
+constexpr std::array<char, 4> shard_magic{ 'B', 'K', 'S', 'H' };
+constexpr std::uint32_t shard_version = 2;
+constexpr std::uint64_t shard_header_size = 8;
+constexpr std::uint64_t block_header_size = 12;
+
+void write32(std::ostream& stream, std::uint32_t value) {
+    std::array<char, 4> const bytes{
+        static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24),
+    };
+    stream.write(bytes.data(), bytes.size());
+}
+
+bool read32(std::istream& stream, std::uint32_t& value) {
+    std::array<unsigned char, 4> bytes;
+    if (!stream.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+        return false;
+    }
+    value = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<std::uint32_t>(bytes[3]) << 24;
+    return true;
+}
+
+}
+
+std::filesystem::path get_shard_path(ShardConfig const& config, std::uint32_t shard_index) {
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "-%06u.bin", shard_index);
+    return config.directory / (config.prefix + suffix);
+}
+
+std::vector<std::filesystem::path> list_shards(std::vector<std::filesystem::path> const& inputs) {
+    std::vector<std::filesystem::path> shards;
+    for (auto const& input : inputs) {
+        if (!std::filesystem::is_directory(input)) {
+            shards.push_back(input);
+            continue;
+        }
+        std::vector<std::filesystem::path> found;
+        for (auto const& entry : std::filesystem::directory_iterator(input)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".bin") {
+                found.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(found);
+        shards.insert(shards.end(), found.begin(), found.end());
+    }
+    return shards;
+}
+
+// ----------------------------------------------------------------------------
+
+ShardWriter::ShardWriter(ShardConfig config, ShardPosition resume)
+    : config(std::move(config))
+    , position(resume)
+{
+    std::filesystem::create_directories(this->config.directory);
+    open();
+}
+
+void ShardWriter::open() {
+    auto const path = get_shard_path(config, position.shard_index);
+
+    if (position.shard_size > 0) {
+        // Drops whatever was written after the last checkpoint
+        std::filesystem::resize_file(path, position.shard_size);
+        file.open(path, std::ios::binary | std::ios::app);
+    }
+    else {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        file.write(shard_magic.data(), shard_magic.size());
+        write32(file, shard_version);
+        position.shard_size = shard_header_size;
+    }
+
+    if (!file) {
+        throw std::runtime_error("cannot open shard " + path.string());
+    }
+}
+
+void ShardWriter::write_block(std::span<std::uint8_t const> block, std::uint32_t record_count) {
+    assert(block.size() <= max_shard_block_size);
+    auto const compressed = lz_compress(block);
+
+    write32(file, record_count);
+    write32(file, static_cast<std::uint32_t>(block.size()));
+    write32(file, static_cast<std::uint32_t>(compressed.size()));
+    file.write(reinterpret_cast<char const*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("cannot write shard " + get_shard_path(config, position.shard_index).string());
+    }
+
+    position.shard_size += block_header_size + compressed.size();
+    if (position.shard_size >= config.max_shard_size) {
+        file.close();
+        position = { position.shard_index + 1, 0 };
+        open();
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+ShardReader::ShardReader(std::filesystem::path const& path)
+    : path(path)
+    , file(path, std::ios::binary)
+{
+    std::array<char, 4> magic{};
+    std::uint32_t version = 0;
+    if (!file.read(magic.data(), magic.size()) || magic != shard_magic || !read32(file, version) || version != shard_version) {
+        throw std::runtime_error("not a shard file " + path.string());
+    }
+    std::error_code error;
+    file_size = std::filesystem::file_size(path, error);
+}
+
+bool ShardReader::read_block(std::vector<std::uint8_t>& block, std::uint32_t& record_count) {
+    std::uint32_t raw_size = 0;
+    std::uint32_t compressed_size = 0;
+    if (!read32(file, record_count)) {
+        return false;
+    }
+    if (!read32(file, raw_size) || !read32(file, compressed_size)) {
+        throw std::runtime_error("truncated block in " + path.string());
+    }
+    // Checked before allocating, a corrupted header must not ask for gigabytes
+    auto const remaining = file_size - static_cast<std::uint64_t>(file.tellg());
+    if (compressed_size > remaining) {
+        throw std::runtime_error("truncated block in " + path.string());
+    }
+    if (raw_size > max_shard_block_size || compressed_size > lz_compress_bound(raw_size)) {
+        throw std::runtime_error("corrupted block in " + path.string());
+    }
+
+    std::vector<std::uint8_t> compressed(compressed_size);
+    if (!file.read(reinterpret_cast<char*>(compressed.data()), compressed_size)) {
+        throw std::runtime_error("truncated block in " + path.string());
+    }
+    auto decompressed = lz_decompress(compressed, raw_size);
+    if (!decompressed) {
+        throw std::runtime_error("corrupted block in " + path.string());
+    }
+    block = std::move(*decompressed);
+    return true;
+}
+
+}
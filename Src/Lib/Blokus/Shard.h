@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Shard files hold compressed blocks of records:
+//  header: "BKSH", 4 bytes version
+//  block:  4 bytes record count, 4 bytes raw size, 4 bytes compressed size, compressed bytes (see lz_compress)
+// Numbers are little endian. Blocks are written whole, so a shard cut at a block boundary is valid.
+// A block holds at most max_shard_block_size bytes before compression.
+constexpr std::size_t max_shard_block_size = std::size_t{ 64 } << 20;
+
+struct ShardConfig {
+    std::filesystem::path directory{ "." };
+    std::string prefix{ "shard" };
+    // A new shard starts once the current one reaches this size
+    std::uint64_t max_shard_size{ std::uint64_t{ 256 } << 20 };
+};
+
+// End of the last complete block, a writer resumes from there
+struct ShardPosition {
+    std::uint32_t shard_index{ 0 };
+    std::uint64_t shard_size{ 0 };
+
+    friend auto operator<=>(ShardPosition const&, ShardPosition const&) = default;
+};
+
+std::filesystem::path get_shard_path(ShardConfig const& config, std::uint32_t shard_index);
+
+// The shard files of each input: a file as is, a directory for its .bin files in name order
+std::vector<std::filesystem::path> list_shards(std::vector<std::filesystem::path> const& inputs);
+
+// ----------------------------------------------------------------------------
+
+// Appends compressed blocks to rotating shard files. I/O failures throw std::runtime_error.
+class ShardWriter {
+public:
+    // Resuming truncates the shard to the position, dropping any block written after it
+    explicit ShardWriter(ShardConfig config, ShardPosition resume = {});
+
+    // Compresses the block and flushes it to the file
+    void write_block(std::span<std::uint8_t const> block, std::uint32_t record_count);
+
+    ShardPosition get_position() const { return position; }
+
+private:
+    void open();
+
+    ShardConfig config;
+    ShardPosition position;
+    std::ofstream file;
+};
+
+// ----------------------------------------------------------------------------
+
+// Reads back the blocks of a single shard file, throws std::runtime_error on corruption
+class ShardReader {
+public:
+    explicit ShardReader(std::filesystem::path const& path);
+
+    // False at the end of the shard
+    bool read_block(std::vector<std::uint8_t>& block, std::uint32_t& record_count);
+
+private:
+    std::filesystem::path path;
+    std::ifstream file;
+    std::uint64_t file_size{ 0 };
+};
+
+}
@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "Snapshot.h"
+
+namespace blokus {
+
+namespace {
+
+void append_varint(std::vector<std::uint8_t>& output, std::uint32_t value) {
+    while (value >= 0x80) {
+        output.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<std::uint8_t>(value));
+}
+
+class Reader {
+public:
+    explicit Reader(std::span<std::uint8_t const> input)
+        : input(input)
+    {}
+
+    bool at_end() const { return offset == input.size(); }
+
+    std::optional<std::uint8_t> read_byte() {
+        if (offset == input.size()) {
+            return std::nullopt;
+        }
+        return input[offset++];
+    }
+
+    std::optional<std::uint32_t> read_varint() {
+        std::uint32_t value = 0;
+        for (int shift = 0; shift < 32; shift += 7) {
+            if (offset == input.size()) {
+                return std::nullopt;
+            }
+            auto const byte = input[offset++];
+            value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::span<std::uint8_t const> input;
+    std::size_t offset{ 0 };
+};
+
+constexpr std::uint8_t seated_follows = 0x80;
+
+void encode_snapshot(Snapshot const& snapshot, Snapshot const& previous, std::vector<std::uint8_t>& output) {
+    std::array<Bitboard, player_id_count> changed_squares;
+    std::uint8_t changed = 0;
+    for (std::size_t color = 0; color < player_id_count; ++color) {
+        changed_squares[color] = snapshot.occupancy[color] ^ previous.occupancy[color];
+        if (changed_squares[color].any()) {
+            changed |= static_cast<std::uint8_t>(1 << color);
+        }
+        if (snapshot.remaining_pieces[color] != previous.remaining_pieces[color]) {
+            changed |= static_cast<std::uint8_t>(0x10 << color);
+        }
+    }
+    output.push_back(changed);
+
+    auto const seated_changed = snapshot.seated_players != previous.seated_players;
+    output.push_back(static_cast<std::uint8_t>(
+        to_index(snapshot.current_player) | snapshot.finished_players << 2 | (seated_changed ? seated_follows : 0)));
+    if (seated_changed) {
+        output.push_back(snapshot.seated_players);
+    }
+
+    for (std::size_t color = 0; color < player_id_count; ++color) {
+        if ((changed >> color & 1) == 0) {
+            continue;
+        }
+        append_varint(output, static_cast<std::uint32_t>(changed_squares[color].count()));
+        auto next = 0;
+        changed_squares[color].for_each([&output, &next](Square square) {
+            append_varint(output, static_cast<std::uint32_t>(square - next));
+            next = square + 1;
+        });
+    }
+    for (std::size_t color = 0; color < player_id_count; ++color) {
+        if ((changed >> (color + 4) & 1) != 0) {
+            append_varint(output, snapshot.remaining_pieces[color].get_bits() ^ previous.remaining_pieces[color].get_bits());
+        }
+    }
+}
+
+// The previous snapshot is updated in place into the decoded one
+bool decode_snapshot(Reader& reader, Snapshot& snapshot) {
+    auto const changed = reader.read_byte();
+    auto const state = reader.read_byte();
+    if (!changed || !state) {
+        return false;
+    }
+    snapshot.current_player = static_cast<PlayerId>(*state & 0x03);
+    snapshot.finished_players = static_cast<std::uint8_t>(*state >> 2 & 0x0F);
+    if ((*state & seated_follows) != 0) {
+        auto const seated = reader.read_byte();
+        if (!seated) {
+            return false;
+        }
+        snapshot.seated_players = *seated;
+    }
+
+    for (std::size_t color = 0; color < player_id_count; ++color) {
+        if ((*changed >> color & 1) == 0) {
+            continue;
+        }
+        auto const count = reader.read_varint();
+        if (!count || *count > static_cast<std::uint32_t>(square_count)) {
+            return false;
+        }
+        std::uint32_t next = 0;
+        for (std::uint32_t i = 0; i < *count; ++i) {
+            auto const gap = reader.read_varint();
+            if (!gap || *gap >= static_cast<std::uint32_t>(square_count) - next) {
+                return false;
+            }
+            auto const square = static_cast<Square>(next + *gap);
+            auto& occupancy = snapshot.occupancy[color];
+            if (occupancy.test(square)) {
+                occupancy.reset(square);
+            }
+            else {
+                occupancy.set(square);
+            }
+            next = square + 1u;
+        }
+    }
+    for (std::size_t color = 0; color < player_id_count; ++color) {
+        if ((*changed >> (color + 4) & 1) == 0) {
+            continue;
+        }
+        auto const bits = reader.read_varint();
+        auto const remaining = snapshot.remaining_pieces[color].get_bits() ^ bits.value_or(0);
+        if (!bits || (remaining & ~PieceSet::all().get_bits()) != 0) {
+            return false;
+        }
+        snapshot.remaining_pieces[color] = PieceSet::from_bits(remaining);
+    }
+    return true;
+}
+
+}
+
+Snapshot Snapshot::from_game(Game const& game) {
+    Snapshot snapshot;
+    for (auto const player : game.get_players()) {
+        auto const color = to_index(player);
+        snapshot.occupancy[color] = game.get_occupancy(player);
+        snapshot.remaining_pieces[color] = game.get_remaining_pieces(player);
+        snapshot.seated_players |= static_cast<std::uint8_t>(1 << color);
+        if (game.is_finished(player)) {
+            snapshot.finished_players |= static_cast<std::uint8_t>(1 << color);
+        }
+    }
+    snapshot.current_player = game.get_current_player();
+    return snapshot;
+}
+
+void encode_snapshots(std::span<Snapshot const> snapshots, std::vector<std::uint8_t>& output) {
+    append_varint(output, static_cast<std::uint32_t>(snapshots.size()));
+    Snapshot const empty;
+    auto previous = &empty;
+    for (auto const& snapshot : snapshots) {
+        encode_snapshot(snapshot, *previous, output);
+        previous = &snapshot;
+    }
+}
+
+std::optional<std::vector<Snapshot>> decode_snapshots(std::span<std::uint8_t const> input) {
+    Reader reader(input);
+    auto const count = reader.read_varint();
+    // Every snapshot takes at least two bytes
+    if (!count || *count > input.size() / 2) {
+        return std::nullopt;
+    }
+
+    std::vector<Snapshot> snapshots;
+    snapshots.reserve(*count);
+    Snapshot snapshot;
+    for (std::uint32_t i = 0; i < *count; ++i) {
+        if (!decode_snapshot(reader, snapshot)) {
+            return std::nullopt;
+        }
+        snapshots.push_back(snapshot);
+    }
+    if (!reader.at_end()) {
+        return std::nullopt;
+    }
+    return snapshots;
+}
+
+}
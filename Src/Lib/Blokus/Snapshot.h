@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Game.h"
+#include "Piece.h"
+#include "PlayerId.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Board state of a game without its history, indexed by color
+struct Snapshot {
+    std::array<Bitboard, player_id_count> occupancy{};
+    std::array<PieceSet, player_id_count> remaining_pieces{};
+    PlayerId current_player{ PlayerId::Red };
+    // One bit per color
+    std::uint8_t seated_players{ 0 };
+    std::uint8_t finished_players{ 0 };
+
+    static Snapshot from_game(Game const& game);
+
+    friend bool operator==(Snapshot const&, Snapshot const&) = default;
+};
+
+// Snapshots are stored as a chain of differences, each one against the previous snapshot of the batch
+// and the first one against an empty board, so consecutive states of a game take a few bytes each:
+//  batch:    varint snapshot count, snapshots
+//  snapshot: 1 byte of changed colors (occupancy in the low bits, remaining pieces in the high bits),
+//            1 byte current player | finished colors << 2 | 0x80 when a byte of seated colors follows,
+//            for each changed occupancy, varint count of changed squares then varint gaps between them,
+//            for each changed piece set, varint of the changed piece bits
+// Decoding a batch needs the whole of it, batches are independent of each other.
+void encode_snapshots(std::span<Snapshot const> snapshots, std::vector<std::uint8_t>& output);
+
+// Nothing when the bytes are malformed
+std::optional<std::vector<Snapshot>> decode_snapshots(std::span<std::uint8_t const> input);
+
+}
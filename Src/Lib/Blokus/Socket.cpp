@@ -0,0 +1,200 @@
+#include "pch.h"
+#include "Socket.h"
+
+#include <system_error>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace blokus {
+
+namespace {
+
+#ifdef _WIN32
+using socklen_t = int;
+
+int get_last_error() { return WSAGetLastError(); }
+bool is_would_block(int error) { return error == WSAEWOULDBLOCK; }
+bool is_reset(int error) { return error == WSAECONNRESET || error == WSAECONNABORTED; }
+
+void close_handle(SocketHandle handle) { closesocket(handle); }
+
+// Winsock has to be initialized once per process before any socket call
+void initialize_network() {
+    static auto const initialized = [] {
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    if (!initialized) {
+        throw std::system_error(get_last_error(), std::system_category(), "WSAStartup");
+    }
+}
+#else
+int get_last_error() { return errno; }
+bool is_would_block(int error) { return error == EAGAIN || error == EWOULDBLOCK; }
+bool is_reset(int error) { return error == ECONNRESET || error == EPIPE; }
+
+void close_handle(SocketHandle handle) { ::close(handle); }
+
+void initialize_network() {}
+#endif
+
+[[noreturn]] void throw_last_error(char const* what) {
+    throw std::system_error(get_last_error(), std::system_category(), what);
+}
+
+sockaddr_in make_address(std::string const& host, std::uint16_t port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        throw std::system_error(std::make_error_code(std::errc::invalid_argument), host);
+    }
+    return address;
+}
+
+Socket create_tcp_socket() {
+    initialize_network();
+    Socket socket{ ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP) };
+    if (!socket.is_valid()) {
+        throw_last_error("socket");
+    }
+    return socket;
+}
+
+IoResult to_io_result(long long transferred) {
+    if (transferred > 0) {
+        return { IoStatus::Done, static_cast<std::size_t>(transferred) };
+    }
+    if (transferred == 0) {
+        return { IoStatus::Closed, 0 };
+    }
+    auto const error = get_last_error();
+    if (is_would_block(error)) {
+        return { IoStatus::WouldBlock, 0 };
+    }
+    return { is_reset(error) ? IoStatus::Closed : IoStatus::Failed, 0 };
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle = std::exchange(other.handle, invalid_socket_handle);
+    }
+    return *this;
+}
+
+Socket Socket::listen_tcp(std::string const& host, std::uint16_t port, int backlog) {
+    auto socket = create_tcp_socket();
+
+    int const reuse = 1;
+    setsockopt(socket.handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<char const*>(&reuse), sizeof(reuse));
+
+    auto const address = make_address(host, port);
+    if (bind(socket.handle, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        throw_last_error("bind");
+    }
+    if (listen(socket.handle, backlog) != 0) {
+        throw_last_error("listen");
+    }
+    return socket;
+}
+
+Socket Socket::connect_tcp(std::string const& host, std::uint16_t port) {
+    auto socket = create_tcp_socket();
+    auto const address = make_address(host, port);
+    if (connect(socket.handle, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        throw_last_error("connect");
+    }
+    socket.set_no_delay(true);
+    return socket;
+}
+
+std::pair<Socket, Socket> Socket::make_pair() {
+    // No socketpair on Windows, a loopback connection works everywhere
+    auto const listener = listen_tcp("127.0.0.1", 0, 1);
+    auto writer = connect_tcp("127.0.0.1", listener.get_local_port());
+    auto reader = listener.accept();
+    if (!reader.is_valid()) {
+        throw_last_error("accept");
+    }
+    return { std::move(reader), std::move(writer) };
+}
+
+Socket Socket::accept() const {
+    Socket socket{ ::accept(handle, nullptr, nullptr) };
+    if (socket.is_valid()) {
+        socket.set_no_delay(true);
+    }
+    return socket;
+}
+
+void Socket::set_non_blocking(bool enabled) const {
+#ifdef _WIN32
+    u_long mode = enabled ? 1 : 0;
+    if (ioctlsocket(handle, FIONBIO, &mode) != 0) {
+        throw_last_error("ioctlsocket");
+    }
+#else
+    auto const flags = fcntl(handle, F_GETFL, 0);
+    if (flags < 0 || fcntl(handle, F_SETFL, enabled ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) < 0) {
+        throw_last_error("fcntl");
+    }
+#endif
+}
+
+void Socket::set_no_delay(bool enabled) const {
+    int const value = enabled ? 1 : 0;
+    setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char const*>(&value), sizeof(value));
+}
+
+std::uint16_t Socket::get_local_port() const {
+    sockaddr_in address{};
+    socklen_t size = sizeof(address);
+    if (getsockname(handle, reinterpret_cast<sockaddr*>(&address), &size) != 0) {
+        throw_last_error("getsockname");
+    }
+    return ntohs(address.sin_port);
+}
+
+IoResult Socket::send(std::span<char const> data) const {
+#ifdef _WIN32
+    auto const sent = ::send(handle, data.data(), static_cast<int>(data.size()), 0);
+#else
+    // A closed peer must not raise SIGPIPE
+    auto const sent = ::send(handle, data.data(), data.size(), MSG_NOSIGNAL);
+#endif
+    return to_io_result(sent);
+}
+
+IoResult Socket::receive(std::span<char> buffer) const {
+#ifdef _WIN32
+    auto const received = ::recv(handle, buffer.data(), static_cast<int>(buffer.size()), 0);
+#else
+    auto const received = ::recv(handle, buffer.data(), buffer.size(), 0);
+#endif
+    return to_io_result(received);
+}
+
+void Socket::close() {
+    if (is_valid()) {
+        close_handle(std::exchange(handle, invalid_socket_handle));
+    }
+}
+
+}
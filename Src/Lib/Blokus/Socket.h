@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+#ifdef _WIN32
+// SOCKET, without pulling winsock2.h in every header
+using SocketHandle = std::uintptr_t;
+constexpr SocketHandle invalid_socket_handle = ~SocketHandle{ 0 };
+#else
+using SocketHandle = int;
+constexpr SocketHandle invalid_socket_handle = -1;
+#endif
+
+enum class IoStatus { Done, WouldBlock, Closed, Failed };
+
+struct IoResult {
+    IoStatus status{ IoStatus::Done };
+    std::size_t size{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Owning TCP socket handle. Setup failures throw std::system_error, transfers report an IoStatus.
+class Socket {
+public:
+    Socket() = default;
+    explicit Socket(SocketHandle handle) : handle(handle) {}
+    ~Socket() { close(); }
+
+    Socket(Socket&& other) noexcept : handle(std::exchange(other.handle, invalid_socket_handle)) {}
+    Socket& operator=(Socket&& other) noexcept;
+
+    Socket(Socket const&) = delete;
+    Socket& operator=(Socket const&) = delete;
+
+    // Port 0 picks any free port, see get_local_port
+    static Socket listen_tcp(std::string const& host, std::uint16_t port, int backlog = 1024);
+    static Socket connect_tcp(std::string const& host, std::uint16_t port);
+
+    // Both ends of a loopback connection, used to wake a poller up from another thread
+    static std::pair<Socket, Socket> make_pair();
+
+    // An invalid socket when no connection is pending on a non blocking listener
+    Socket accept() const;
+
+    void set_non_blocking(bool enabled) const;
+    // Disables Nagle's algorithm, requests and replies are small
+    void set_no_delay(bool enabled) const;
+
+    std::uint16_t get_local_port() const;
+
+    IoResult send(std::span<char const> data) const;
+    IoResult receive(std::span<char> buffer) const;
+
+    bool is_valid() const { return handle != invalid_socket_handle; }
+    SocketHandle get_handle() const { return handle; }
+
+    void close();
+
+private:
+    SocketHandle handle{ invalid_socket_handle };
+};
+
+}
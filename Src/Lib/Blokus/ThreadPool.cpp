@@ -0,0 +1,104 @@
+#include "pch.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace blokus {
+
+namespace {
+
+// Set for the threads of a pool while they run
+thread_local ThreadPool const* current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+    : ThreadPool(ThreadPoolConfig{ .thread_count = thread_count })
+{}
+
+ThreadPool::ThreadPool(ThreadPoolConfig config) {
+    auto const thread_count = std::max<std::size_t>(config.thread_count, 1);
+
+    // Node by node, in the order the system lists the processors
+    std::vector<std::pair<std::size_t, LogicalProcessor>> processors;
+    if (config.pin_threads) {
+        auto const& topology = get_cpu_topology();
+        for (std::size_t node = 0; node < topology.nodes.size(); ++node) {
+            for (auto const processor : topology.nodes[node]) {
+                processors.emplace_back(node, processor);
+            }
+        }
+    }
+
+    worker_nodes.resize(thread_count, 0);
+    std::vector<std::optional<LogicalProcessor>> placements(thread_count);
+    if (!processors.empty()) {
+        node_count = 0;
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            auto const& [node, processor] = processors[i % processors.size()];
+            worker_nodes[i] = node;
+            placements[i] = processor;
+            node_count = std::max(node_count, node + 1);
+        }
+    }
+
+    threads.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([this, i, processor = placements[i]] { run(i, processor); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::push(TaskPriority priority, std::function<void()> function) {
+    {
+        std::scoped_lock lock(mutex);
+        tasks.push({ priority, next_sequence++, std::move(function) });
+    }
+    condition.notify_one();
+}
+
+std::optional<std::size_t> ThreadPool::get_current_worker() const {
+    if (current_pool != this) {
+        return std::nullopt;
+    }
+    return current_worker;
+}
+
+void ThreadPool::run(std::size_t worker, std::optional<LogicalProcessor> processor) {
+    // A thread the system refuses to pin still works, it is only free to move
+    if (processor) {
+        pin_current_thread(*processor);
+    }
+    current_pool = this;
+    current_worker = worker;
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+            // Pending tasks are still executed so that no future is left broken
+            if (tasks.empty()) {
+                return;
+            }
+            // top() is const, the task is popped right after being moved from
+            task = std::move(const_cast<Task&>(tasks.top()).function);
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+}
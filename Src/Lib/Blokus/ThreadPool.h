@@ -0,0 +1,99 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "CpuTopology.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+enum class TaskPriority { Low, Normal, High };
+
+struct ThreadPoolConfig {
+    std::size_t thread_count{ std::thread::hardware_concurrency() };
+    // Binds each thread to its own logical processor, filling a NUMA node before going to the next one,
+    // so that the threads stay on as few memory controllers as possible and the memory they touch
+    // first stays local to them. Threads beyond the processor count wrap around.
+    bool pin_threads{ false };
+};
+
+// ----------------------------------------------------------------------------
+
+// Fixed number of worker threads sharing a queue of tasks, by priority and then in submission order
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency());
+    explicit ThreadPool(ThreadPoolConfig config);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    template<class Function>
+    auto submit(Function&& function, TaskPriority priority = TaskPriority::Normal) -> std::future<std::invoke_result_t<Function>>;
+
+    std::size_t get_thread_count() const { return threads.size(); }
+
+    // Index of the calling thread among the threads of this pool, nothing when it isn't one of them
+    std::optional<std::size_t> get_current_worker() const;
+
+    // NUMA nodes the threads are spread over, 1 when they aren't pinned
+    std::size_t get_node_count() const { return node_count; }
+    std::size_t get_node(std::size_t worker) const { return worker_nodes[worker]; }
+
+private:
+    struct Task {
+        TaskPriority priority;
+        std::uint64_t sequence;
+        std::function<void()> function;
+
+        // std::priority_queue pops the largest task first
+        friend bool operator<(Task const& lhs, Task const& rhs) {
+            if (lhs.priority != rhs.priority) {
+                return lhs.priority < rhs.priority;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    void push(TaskPriority priority, std::function<void()> function);
+    void run(std::size_t worker, std::optional<LogicalProcessor> processor);
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::priority_queue<Task> tasks;
+    std::uint64_t next_sequence{ 0 };
+    bool stopping{ false };
+    std::size_t node_count{ 1 };
+    std::vector<std::size_t> worker_nodes;
+    std::vector<std::thread> threads;
+};
+
+// ----------------------------------------------------------------------------
+
+template<class Function>
+auto ThreadPool::submit(Function&& function, TaskPriority priority) -> std::future<std::invoke_result_t<Function>> {
+    using Result = std::invoke_result_t<Function>;
+
+    // std::function needs a copyable target
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+    auto future = task->get_future();
+    push(priority, [task] { (*task)(); });
+    return future;
+}
+
+}
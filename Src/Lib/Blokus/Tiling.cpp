@@ -0,0 +1,290 @@
+#include "pch.h"
+#include "Tiling.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace blokus {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The exact cover matrix as circular doubly linked lists of its ones, a header per column.
+// Everything lives in arrays of indices, so copying the links for another thread is a plain copy.
+class DancingLinks {
+public:
+    DancingLinks(std::size_t primary_count, std::size_t secondary_count, std::vector<std::vector<std::uint32_t>> const& rows);
+
+    // Takes the row as part of the solution
+    void select(std::uint32_t row);
+
+    // Depth first search from the current state. The visitor gets the rows chosen so far and whether
+    // they cover every column, at each solution and at each state with depth_limit rows chosen.
+    // False once the visitor or the stop flag ended the search.
+    template<class Visitor>
+    bool search(std::size_t depth_limit, std::atomic<bool> const& stop, Visitor&& visitor) {
+        return search_level(depth_limit, stop, visitor);
+    }
+
+    std::uint64_t get_visited() const { return visited; }
+
+private:
+    // Index 0 is the root, then a header per column, then the ones of the rows
+    struct Node {
+        std::uint32_t left;
+        std::uint32_t right;
+        std::uint32_t up;
+        std::uint32_t down;
+        std::uint32_t column;
+        std::uint32_t row;
+    };
+
+    void cover(std::uint32_t column);
+    void uncover(std::uint32_t column);
+
+    template<class Visitor>
+    bool search_level(std::size_t depth_limit, std::atomic<bool> const& stop, Visitor& visitor);
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> column_sizes;
+    std::vector<std::uint32_t> row_nodes;
+    std::vector<std::uint32_t> chosen;
+    std::uint64_t visited{ 0 };
+};
+
+DancingLinks::DancingLinks(std::size_t primary_count, std::size_t secondary_count, std::vector<std::vector<std::uint32_t>> const& rows) {
+    auto const column_count = static_cast<std::uint32_t>(primary_count + secondary_count);
+    nodes.push_back({ 0, 0, 0, 0, 0, 0 });
+    column_sizes.assign(column_count + 1, 0);
+
+    // Only the primary columns are linked to the root and must be covered, the secondary ones may be
+    for (std::uint32_t column = 1; column <= column_count; ++column) {
+        auto& header = nodes.emplace_back(Node{ column, column, column, column, column, 0 });
+        if (column <= primary_count) {
+            header.left = nodes[0].left;
+            header.right = 0;
+            nodes[nodes[0].left].right = column;
+            nodes[0].left = column;
+        }
+    }
+
+    for (std::uint32_t row = 0; row < rows.size(); ++row) {
+        auto const first = static_cast<std::uint32_t>(nodes.size());
+        row_nodes.push_back(first);
+        for (auto const index : rows[row]) {
+            auto const column = index + 1;
+            auto const node = static_cast<std::uint32_t>(nodes.size());
+            nodes.push_back({ node, node, nodes[column].up, column, column, row });
+            nodes[nodes[column].up].down = node;
+            nodes[column].up = node;
+            ++column_sizes[column];
+            if (node != first) {
+                nodes[node].left = nodes[first].left;
+                nodes[node].right = first;
+                nodes[nodes[first].left].right = node;
+                nodes[first].left = node;
+            }
+        }
+    }
+}
+
+void DancingLinks::select(std::uint32_t row) {
+    auto const first = row_nodes[row];
+    auto node = first;
+    do {
+        cover(nodes[node].column);
+        node = nodes[node].right;
+    } while (node != first);
+    chosen.push_back(row);
+}
+
+void DancingLinks::cover(std::uint32_t column) {
+    nodes[nodes[column].right].left = nodes[column].left;
+    nodes[nodes[column].left].right = nodes[column].right;
+    for (auto row = nodes[column].down; row != column; row = nodes[row].down) {
+        for (auto node = nodes[row].right; node != row; node = nodes[node].right) {
+            nodes[nodes[node].down].up = nodes[node].up;
+            nodes[nodes[node].up].down = nodes[node].down;
+            --column_sizes[nodes[node].column];
+        }
+    }
+}
+
+void DancingLinks::uncover(std::uint32_t column) {
+    for (auto row = nodes[column].up; row != column; row = nodes[row].up) {
+        for (auto node = nodes[row].left; node != row; node = nodes[node].left) {
+            ++column_sizes[nodes[node].column];
+            nodes[nodes[node].down].up = node;
+            nodes[nodes[node].up].down = node;
+        }
+    }
+    nodes[nodes[column].right].left = column;
+    nodes[nodes[column].left].right = column;
+}
+
+template<class Visitor>
+bool DancingLinks::search_level(std::size_t depth_limit, std::atomic<bool> const& stop, Visitor& visitor) {
+    if (nodes[0].right == 0) {
+        return visitor(std::span<std::uint32_t const>(chosen), true);
+    }
+    if (chosen.size() >= depth_limit) {
+        return visitor(std::span<std::uint32_t const>(chosen), false);
+    }
+    if (stop.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // The column with the fewest rows left keeps the tree narrow
+    auto column = nodes[0].right;
+    for (auto other = nodes[column].right; other != 0; other = nodes[other].right) {
+        if (column_sizes[other] < column_sizes[column]) {
+            column = other;
+        }
+    }
+    if (column_sizes[column] == 0) {
+        return true;
+    }
+
+    cover(column);
+    auto keep_going = true;
+    for (auto row = nodes[column].down; row != column && keep_going; row = nodes[row].down) {
+        ++visited;
+        chosen.push_back(nodes[row].row);
+        for (auto node = nodes[row].right; node != row; node = nodes[node].right) {
+            cover(nodes[node].column);
+        }
+        keep_going = search_level(depth_limit, stop, visitor);
+        for (auto node = nodes[row].left; node != row; node = nodes[node].left) {
+            uncover(nodes[node].column);
+        }
+        chosen.pop_back();
+    }
+    uncover(column);
+    return keep_going;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+TilingResult solve_tiling(TilingProblem const& problem, ThreadPool& pool, TilingCallback const& on_solution) {
+    auto const start = Clock::now();
+    TilingResult result;
+
+    // Columns: the squares of the region, then the pieces
+    std::array<std::uint32_t, square_count> square_columns{};
+    std::uint32_t square_column_count = 0;
+    problem.region.for_each([&](Square square) { square_columns[square] = square_column_count++; });
+
+    std::vector<std::vector<std::uint32_t>> rows;
+    std::vector<Move> row_moves;
+    std::uint32_t piece_column = square_column_count;
+    for (std::size_t piece = 0; piece < piece_count; ++piece) {
+        if (!problem.pieces.contains(static_cast<PieceId>(piece))) {
+            continue;
+        }
+        auto const range = get_orientation_range(static_cast<PieceId>(piece));
+        for (auto index = range.first; index < range.last; ++index) {
+            auto const& orientation = get_orientation(index);
+            for (int y = 0; y + orientation.height <= board_size; ++y) {
+                for (int x = 0; x + orientation.width <= board_size; ++x) {
+                    Move const move{ index, to_square({ x, y }) };
+                    auto const footprint = get_footprint(move);
+                    if ((footprint & ~problem.region).any()) {
+                        continue;
+                    }
+                    auto& row = rows.emplace_back();
+                    footprint.for_each([&](Square square) { row.push_back(square_columns[square]); });
+                    row.push_back(piece_column);
+                    row_moves.push_back(move);
+                }
+            }
+        }
+        ++piece_column;
+    }
+    auto const piece_column_count = piece_column - square_column_count;
+    DancingLinks const links(
+        problem.all_pieces ? piece_column : square_column_count,
+        problem.all_pieces ? 0 : piece_column_count,
+        rows);
+
+    std::mutex mutex;
+    std::atomic<bool> stop{ false };
+    // Counted without the lock when nobody looks at the tilings themselves
+    auto const report = [&](std::span<std::uint32_t const> chosen, std::uint64_t& solutions) {
+        ++solutions;
+        if (!on_solution) {
+            return true;
+        }
+        std::vector<Move> moves;
+        for (auto const row : chosen) {
+            moves.push_back(row_moves[row]);
+        }
+        std::lock_guard lock(mutex);
+        if (stop || !on_solution(moves)) {
+            stop = true;
+        }
+        return !stop;
+    };
+
+    // Expands the first levels until there are a few branches per thread. The solutions found on
+    // the way only count at the final depth, as the shallower expansions are thrown away.
+    std::vector<std::vector<std::uint32_t>> prefixes;
+    std::vector<std::vector<std::uint32_t>> shallow_solutions;
+    auto const wanted = pool.get_thread_count() * 8;
+    for (std::size_t depth = 1;; ++depth) {
+        auto expansion = links;
+        prefixes.clear();
+        shallow_solutions.clear();
+        expansion.search(depth, stop, [&](std::span<std::uint32_t const> chosen, bool complete) {
+            (complete ? shallow_solutions : prefixes).emplace_back(chosen.begin(), chosen.end());
+            return true;
+        });
+        result.nodes += expansion.get_visited();
+        if (prefixes.size() >= wanted || prefixes.empty() || depth >= 4) {
+            break;
+        }
+    }
+    for (auto const& solution : shallow_solutions) {
+        if (!report(solution, result.solutions)) {
+            break;
+        }
+    }
+
+    struct BranchResult {
+        std::uint64_t solutions{ 0 };
+        std::uint64_t nodes{ 0 };
+    };
+    std::vector<std::future<BranchResult>> branches;
+    for (auto const& prefix : prefixes) {
+        branches.push_back(pool.submit([&links, &prefix, &stop, &report] {
+            BranchResult branch;
+            auto copy = links;
+            for (auto const row : prefix) {
+                copy.select(row);
+            }
+            copy.search(std::numeric_limits<std::size_t>::max(), stop, [&](std::span<std::uint32_t const> chosen, bool) {
+                return report(chosen, branch.solutions);
+            });
+            branch.nodes = copy.get_visited();
+            return branch;
+        }));
+    }
+    for (auto& future : branches) {
+        auto const branch = future.get();
+        result.solutions += branch.solutions;
+        result.nodes += branch.nodes;
+    }
+
+    result.stopped = stop;
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+}
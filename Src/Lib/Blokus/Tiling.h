@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "Bitboard.h"
+#include "Move.h"
+#include "Piece.h"
+#include "ThreadPool.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Single player puzzle: cover every square of the region with pieces of the set, each piece at most
+// once and in any orientation, the game rules about corners and edges don't apply
+struct TilingProblem {
+    Bitboard region;
+    PieceSet pieces;
+    // Every piece of the set must be used, otherwise any subset covering the region exactly will do
+    bool all_pieces{ false };
+};
+
+struct TilingResult {
+    // Tilings that are rotations or reflections of each other count separately
+    std::uint64_t solutions{ 0 };
+    // Rows chosen during the search
+    std::uint64_t nodes{ 0 };
+    bool stopped{ false };
+    std::chrono::nanoseconds elapsed{ 0 };
+};
+
+// Receives the placements of each tiling, one call at a time even from several threads.
+// Returning false stops the search.
+using TilingCallback = std::function<bool(std::span<Move const>)>;
+
+// Exact cover with Knuth's dancing links: one column per square of the region and one per piece,
+// optional when the pieces don't all have to be used, one row per placement of an orientation inside
+// the region. The first few levels of the search are expanded up front and each branch is searched
+// by a task of the pool on its own copy of the links.
+TilingResult solve_tiling(TilingProblem const& problem, ThreadPool& pool, TilingCallback const& on_solution = {});
+
+}
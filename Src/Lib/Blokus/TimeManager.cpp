@@ -0,0 +1,80 @@
+#include "pch.h"
+#include "TimeManager.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace blokus {
+
+TimeManager::TimeManager(TimeManagerConfig config)
+    : config(config)
+{}
+
+double TimeManager::get_expected_moves_left(Game const& game) const {
+    auto const remaining = game.get_remaining_pieces(game.get_current_player()).count();
+    return std::max(config.min_moves_left, remaining * config.playable_pieces_fraction);
+}
+
+std::chrono::milliseconds TimeManager::allot(Game const& game, TimeControl const& time_control, std::size_t legal_move_count) const {
+    using namespace std::chrono;
+
+    auto const available = time_control.remaining - config.move_overhead;
+    if (available <= milliseconds::zero()) {
+        return milliseconds::zero();
+    }
+
+    // A forced move doesn't need any search
+    if (legal_move_count <= 1) {
+        return milliseconds::zero();
+    }
+
+    auto const complexity = std::clamp(
+        std::sqrt(static_cast<double>(legal_move_count) / config.typical_move_count),
+        config.min_complexity_factor,
+        config.max_complexity_factor);
+
+    auto const base = static_cast<double>(available.count()) / get_expected_moves_left(game);
+    auto const budget = base * complexity + static_cast<double>(time_control.increment.count());
+    auto const cap = static_cast<double>(available.count()) * config.max_remaining_fraction;
+
+    return milliseconds{ static_cast<milliseconds::rep>(std::min(budget, cap)) };
+}
+
+void TimeManager::record(std::chrono::nanoseconds budget, std::chrono::nanoseconds used) {
+    using namespace std::chrono;
+
+    ++statistics.move_count;
+    auto const overrun = duration_cast<microseconds>(used - budget);
+    if (overrun <= microseconds::zero()) {
+        ++overrun_buckets[0];
+        return;
+    }
+
+    ++statistics.overrun_count;
+    statistics.total_overrun += overrun;
+    statistics.max_overrun = std::max(statistics.max_overrun, overrun);
+
+    auto const bucket = std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(overrun.count())), bucket_count - 1);
+    ++overrun_buckets[bucket];
+}
+
+OverrunStatistics TimeManager::get_statistics() const {
+    auto result = statistics;
+    if (result.move_count == 0) {
+        return result;
+    }
+
+    auto const target = (result.move_count * 99 + 99) / 100;
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        count += overrun_buckets[i];
+        if (count >= target) {
+            result.p99_overrun = i == 0 ? std::chrono::microseconds::zero() : std::min(std::chrono::microseconds{ std::int64_t{ 1 } << i }, result.max_overrun);
+            break;
+        }
+    }
+    return result;
+}
+
+}
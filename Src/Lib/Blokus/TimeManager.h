@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "Deadline.h"
+#include "Game.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+struct TimeControl {
+    // Game clock left for the player to move
+    std::chrono::milliseconds remaining{ 0 };
+    std::chrono::milliseconds increment{ 0 };
+};
+
+struct TimeManagerConfig {
+    // Kept aside for the move transmission and the search wind down
+    std::chrono::milliseconds move_overhead{ 20 };
+    // Hard cap, as a fraction of the remaining clock, of a single move budget
+    double max_remaining_fraction{ 0.25 };
+    // Not every remaining piece will fit on the board
+    double playable_pieces_fraction{ 0.7 };
+    double min_moves_left{ 2.0 };
+    // Branching factor of an "average" position, positions with more moves get more time
+    double typical_move_count{ 300.0 };
+    double min_complexity_factor{ 0.5 };
+    double max_complexity_factor{ 2.0 };
+};
+
+struct OverrunStatistics {
+    std::size_t move_count{ 0 };
+    std::size_t overrun_count{ 0 };
+    std::chrono::microseconds max_overrun{ 0 };
+    std::chrono::microseconds total_overrun{ 0 };
+    // Upper bound of the bucket holding the 99th percentile of (used - budget), capped at max_overrun, zero when under budget
+    std::chrono::microseconds p99_overrun{ 0 };
+};
+
+// ----------------------------------------------------------------------------
+
+// Allots a per move budget from the clock, the expected moves left and the position complexity,
+// and keeps track of how far the searches went over their budget.
+class TimeManager {
+public:
+    explicit TimeManager(TimeManagerConfig config = {});
+
+    std::chrono::milliseconds allot(Game const& game, TimeControl const& time_control, std::size_t legal_move_count) const;
+
+    Deadline start(Game const& game, TimeControl const& time_control, std::size_t legal_move_count) const {
+        return Deadline::after(allot(game, time_control, legal_move_count));
+    }
+
+    double get_expected_moves_left(Game const& game) const;
+
+    void record(std::chrono::nanoseconds budget, std::chrono::nanoseconds used);
+
+    OverrunStatistics get_statistics() const;
+
+private:
+    // Bucket i holds the overruns in [2^(i-1), 2^i) microseconds, bucket 0 the ones under budget
+    static constexpr std::size_t bucket_count = 32;
+
+    TimeManagerConfig config;
+    std::array<std::uint64_t, bucket_count> overrun_buckets{};
+    OverrunStatistics statistics;
+};
+
+}
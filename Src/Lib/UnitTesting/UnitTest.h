@@ -1,6 +1,7 @@
 #pragma once
 
 #include <any>
+#include <string>
 #include <type_traits>
 #include <variant>
 
@@ -26,6 +27,12 @@ using TestPrintHelperData = nlohmann::json;
 template<class T>
 TestPrintHelperData test_print_helper(T const& t);
 
+template<class T>
+    requires std::is_arithmetic_v<T>
+std::string test_print_helper(T const& value) {
+    return std::to_string(value);
+}
+
 UNITTESTING_API std::string test_print_helper(std::string const& value);
 UNITTESTING_API std::string test_print_helper(std::string_view value);
 UNITTESTING_API std::string test_print_helper(char const* const value);
@@ -0,0 +1,69 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/AlphaBeta.h"
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/MoveOrdering.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite alpha_beta_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "KillerTable"_test = [] {
+
+        given("Given a killer table and three moves") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green });
+            MoveList moves;
+            generate_moves(game, moves);
+            KillerTable killers;
+
+            when("When adding the moves in turn at the same ply") = [&] {
+                killers.add(4, moves[0]);
+                killers.add(4, moves[1]);
+                killers.add(4, moves[2]);
+
+                then("Then the two most recent are the killers, newest first") = [&] {
+                    expect(that % killers.find(4, moves[2]) == 0u);
+                    expect(that % killers.find(4, moves[1]) == 1u);
+                    expect(that % killers.find(4, moves[0]) == KillerTable::slot_count);
+                    expect(that % killers.find(3, moves[2]) == KillerTable::slot_count);
+                };
+            };
+        };
+    };
+
+    "MoveOrdering"_test = [] {
+
+        given("Given positions in the middle of a game") = [] {
+            auto game = make_test_game(36);
+
+            when("When searching them with and without move ordering") = [&game] {
+                AlphaBetaConfig unordered_config;
+                unordered_config.depth = 2;
+                unordered_config.ordering.static_score = false;
+                unordered_config.ordering.killers = false;
+                unordered_config.ordering.history = false;
+                AlphaBetaConfig ordered_config;
+                ordered_config.depth = 2;
+
+                auto const unordered = AlphaBeta(unordered_config).search(game);
+                auto const ordered = AlphaBeta(ordered_config).search(game);
+
+                then("Then the value is the same and the ordered search visits fewer nodes") = [&] {
+                    expect(that % ordered.value == unordered.value);
+                    expect(that % ordered.depth == 2);
+                    expect(that % ordered.nodes < unordered.nodes);
+                    expect(that % is_legal(game, ordered.best_move) == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
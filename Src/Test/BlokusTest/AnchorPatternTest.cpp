@@ -0,0 +1,145 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <algorithm>
+
+#include "Blokus/AnchorPattern.h"
+#include "Blokus/MoveGeneration.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite anchor_pattern_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "AnchorPattern"_test = [] {
+
+        given("Given the keys of a closed in square and of an open one") = [] {
+            PatternKey const closed = 0;
+            PatternKey const open = (PatternKey{ 1 } << pattern_bit_count) - 1;
+
+            when("When looking up the pieces that fit") = [&] {
+                auto const in_closed = get_fitting_pieces(closed);
+                auto const in_open = get_fitting_pieces(open);
+
+                then("Then only the monomino fits the closed one and every piece the open one") = [&] {
+                    expect(that % in_closed.count() == 1);
+                    expect(that % in_closed.contains(PieceId::P1a) == true);
+                    expect(that % (in_open == PieceSet::all()) == true);
+                };
+            };
+        };
+
+        given("Given a corner of the board") = [] {
+            auto const key = get_pattern_key(Bitboard{}, to_square({ 0, 0 }));
+
+            when("When looking at its key") = [&key] {
+                then("Then only the squares on the board are free") = [&key] {
+                    expect(that % key == (PatternKey{ 1 } << get_pattern_bit(1, 0) | PatternKey{ 1 } << get_pattern_bit(2, 0) |
+                        PatternKey{ 1 } << get_pattern_bit(0, 1) | PatternKey{ 1 } << get_pattern_bit(1, 1) |
+                        PatternKey{ 1 } << get_pattern_bit(2, 1) | PatternKey{ 1 } << get_pattern_bit(0, 2) |
+                        PatternKey{ 1 } << get_pattern_bit(1, 2) | PatternKey{ 1 } << get_pattern_bit(2, 2)));
+                };
+            };
+        };
+    };
+
+    "PatternTracker"_test = [] {
+
+        given("Given a tracker following a game") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            PatternTracker patterns;
+            patterns.reset(game);
+
+            auto const matches = [&game, &patterns] {
+                for (auto const player : game.get_players()) {
+                    auto const forbidden = game.get_forbidden(player);
+                    for (Square square = 0; square < square_count; ++square) {
+                        if (patterns.get_key(player, square) != get_pattern_key(forbidden, square)) {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            };
+
+            when("When playing the game to the end and undoing it") = [&] {
+                auto played_match = true;
+                while (!game.is_over()) {
+                    patterns.apply(game, get_test_move(game));
+                    played_match = played_match && matches();
+                }
+                auto undone_match = true;
+                while (game.get_ply() > 0) {
+                    patterns.undo(game);
+                    undone_match = undone_match && matches();
+                }
+
+                then("Then every key is the one computed from the forbidden squares") = [&] {
+                    expect(that % played_match == true);
+                    expect(that % undone_match == true);
+                };
+            };
+
+            when("When resetting it on a game in progress") = [&] {
+                play_test_moves(game, 30);
+                patterns.reset(game);
+
+                then("Then every key is the one computed from the forbidden squares") = [&] {
+                    expect(that % matches() == true);
+                };
+            };
+        };
+    };
+
+    "PatternFiltering"_test = [] {
+
+        given("Given a game played to the end") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When generating the moves of every position, as a list, with tracked keys and from a source") = [&game] {
+                auto all_legal = true;
+                auto same_moves = true;
+                MoveList moves;
+                MoveList tracked_moves;
+                PatternTracker patterns;
+                patterns.reset(game);
+                while (!game.is_over()) {
+                    generate_moves(game, moves);
+                    generate_moves(game, patterns, tracked_moves);
+                    MoveSource source(game);
+                    std::size_t source_count = 0;
+                    while (source.next()) {
+                        ++source_count;
+                    }
+                    same_moves = same_moves && moves.size() == source_count &&
+                        std::equal(moves.begin(), moves.end(), tracked_moves.begin(), tracked_moves.end());
+
+                    // Every placement of the position, the pieces skipped must not hide one
+                    std::size_t legal_count = 0;
+                    for (OrientationIndex orientation = 0; orientation < orientation_count; ++orientation) {
+                        for (Square square = 0; square < square_count; ++square) {
+                            if (is_legal(game, { orientation, square })) {
+                                ++legal_count;
+                            }
+                        }
+                    }
+                    all_legal = all_legal && (legal_count == 0 ? moves[0].is_pass() : legal_count == moves.size());
+
+                    patterns.apply(game, get_test_move(game, 11));
+                }
+
+                then("Then the pieces that can't fit hide no legal move") = [&] {
+                    expect(that % all_legal == true);
+                    expect(that % same_moves == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <cstdint>
+
+#include "Blokus/Arena.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite arena_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Arena"_test = [] {
+
+        given("Given an arena") = [] {
+            Arena arena({ .block_size = 1024 });
+
+            when("When allocating objects of different alignments") = [&arena] {
+                auto const* byte = arena.create<std::uint8_t>(std::uint8_t{ 1 });
+                auto const* value = arena.create<std::uint64_t>(std::uint64_t{ 2 });
+                auto const result = reinterpret_cast<std::uintptr_t>(value) % alignof(std::uint64_t);
+
+                then("Then every object is aligned and keeps its value") = [&] {
+                    expect(that % result == 0u);
+                    expect(that % static_cast<int>(*byte) == 1);
+                    expect(that % *value == 2u);
+                };
+            };
+
+            when("When allocating more than a block and resetting") = [&arena] {
+                for (int i = 0; i < 1000; ++i) {
+                    arena.create<std::uint64_t>(std::uint64_t{ 0 });
+                }
+                auto const before = arena.get_statistics();
+                arena.reset();
+                auto const after = arena.get_statistics();
+
+                then("Then the blocks are kept, nothing is used and the high water mark remains") = [&] {
+                    expect(that % before.block_count > 1u);
+                    expect(that % after.block_count == before.block_count);
+                    expect(that % after.used_size == 0u);
+                    expect(that % after.high_water_mark == before.high_water_mark);
+                };
+            };
+        };
+
+        given("Given an arena with a maximum reserved size") = [] {
+            Arena arena({ .block_size = 256, .max_reserved_size = 512 });
+
+            when("When allocating past the maximum") = [&arena] {
+                auto const result = arena.create_array<std::uint64_t>(128);
+
+                then("Then the allocation fails and is reported") = [&] {
+                    expect(that % result.empty() == true);
+                    expect(that % arena.get_statistics().failed_allocation_count == 1u);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
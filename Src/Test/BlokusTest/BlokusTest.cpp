@@ -0,0 +1,2 @@
+// BlokusTest.cpp : This file contains the 'main' function. Program execution begins and ends there.
+//
@@ -0,0 +1,77 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <vector>
+
+#include "Blokus/BoardHistory.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite board_history_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "BoardHistory"_test = [] {
+
+        given("Given a history recording a whole game") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            BoardHistory history(game);
+
+            std::vector<Game> states{ game };
+            std::vector<BoardVersion> versions{ BoardHistory::root_version };
+            while (!game.is_over()) {
+                auto const move = get_test_move(game);
+                game.apply(move);
+                states.push_back(game);
+                versions.push_back(history.apply(versions.back(), move));
+            }
+
+            when("When reading back every version") = [&] {
+                auto mismatches = 0;
+                for (std::size_t i = 0; i < versions.size(); ++i) {
+                    auto const view = history.get_view(versions[i]);
+                    auto const& state = states[i];
+                    mismatches += view.get_current_player() != state.get_current_player() ? 1 : 0;
+                    mismatches += view.get_occupancy() != state.get_occupancy() ? 1 : 0;
+                    for (auto const player : state.get_players()) {
+                        mismatches += view.get_occupancy(player) != state.get_occupancy(player) ? 1 : 0;
+                        mismatches += view.get_remaining_pieces(player) != state.get_remaining_pieces(player) ? 1 : 0;
+                        mismatches += view.get_score(player) != state.get_score(player) ? 1 : 0;
+                    }
+                }
+
+                then("Then each one matches the game state after the same moves") = [&mismatches] {
+                    expect(that % mismatches == 0);
+                };
+            };
+
+            when("When branching from an earlier version") = [&] {
+                auto const middle = versions[versions.size() / 2];
+                auto branch_game = history.get_game(middle);
+                auto const move = get_test_move(branch_game, 0);
+                auto const branch = history.apply(middle, move);
+                branch_game.apply(move);
+
+                then("Then the branch and the original line both remain readable") = [&] {
+                    expect(that % (history.get_game(branch) == branch_game) == true);
+                    expect(that % (history.get_game(versions.back()) == states.back()) == true);
+                    expect(that % (history.get_parent(branch) == middle) == true);
+                };
+            };
+
+            when("When comparing its size with copies of every state") = [&] {
+                auto const copies = states.size() * sizeof(Game);
+
+                then("Then the shared chunks take a fraction of it") = [&] {
+                    expect(that % history.get_memory_usage() < copies / 3);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
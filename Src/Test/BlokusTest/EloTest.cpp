@@ -0,0 +1,78 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Elo.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite elo_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Elo"_test = [] {
+
+        given("Given a 75% score over 400 games") = [] {
+            MatchScore const score{ .wins = 250, .draws = 100, .losses = 50 };
+
+            when("When estimating the Elo difference") = [&score] {
+                auto const estimate = estimate_elo(score);
+                auto const width = estimate.upper - estimate.lower;
+
+                then("Then it is about 191 Elo, within a confidence interval around it") = [&] {
+                    expect(that % estimate.elo == 190.8_d);
+                    expect(that % estimate.lower < estimate.elo and that % estimate.elo < estimate.upper);
+                    expect(that % width < 100.0);
+                };
+            };
+        };
+
+        given("Given a balanced score") = [] {
+            MatchScore const score{ .wins = 40, .draws = 20, .losses = 40 };
+
+            when("When estimating the Elo difference") = [&score] {
+                auto const estimate = estimate_elo(score);
+                auto const asymmetry = estimate.lower + estimate.upper;
+
+                then("Then the interval is centered on zero") = [&] {
+                    expect(that % estimate.elo == 0.0_d);
+                    expect(that % asymmetry == 0.0_d);
+                };
+            };
+        };
+    };
+
+    "Sprt"_test = [] {
+
+        given("Given a test of 0 against 20 Elo") = [] {
+            SprtConfig const config{ .elo0 = 0.0, .elo1 = 20.0 };
+
+            when("When the engine clearly wins") = [&config] {
+                auto const result = run_sprt({ .wins = 300, .draws = 100, .losses = 200 }, config);
+
+                then("Then H1 is accepted") = [&result] {
+                    expect(that % (result.status == SprtStatus::AcceptH1) == true);
+                };
+            };
+
+            when("When the engine clearly loses") = [&config] {
+                auto const result = run_sprt({ .wins = 200, .draws = 100, .losses = 300 }, config);
+
+                then("Then H0 is accepted") = [&result] {
+                    expect(that % (result.status == SprtStatus::AcceptH0) == true);
+                };
+            };
+
+            when("When only a few games were played") = [&config] {
+                auto const result = run_sprt({ .wins = 3, .draws = 1, .losses = 2 }, config);
+
+                then("Then the test goes on") = [&result] {
+                    expect(that % (result.status == SprtStatus::Continue) == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Endgame.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite endgame_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Regions"_test = [] {
+
+        given("Given a new game") = [] {
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When finding the regions") = [&game] {
+                auto const regions = find_regions(game);
+
+                then("Then the whole board is a single region shared by every player") = [&regions] {
+                    expect(that % regions.size() == 1u);
+                    expect(that % regions[0].squares.count() == square_count);
+                    expect(that % regions[0].players == 0b1111);
+                };
+            };
+        };
+
+        given("Given a position late in a game") = [] {
+            auto game = make_test_game(56);
+
+            when("When finding the regions") = [&game] {
+                auto const regions = find_regions(game);
+
+                then("Then they split the territories of the players without overlapping") = [&] {
+                    Bitboard covered;
+                    auto overlap = false;
+                    for (auto const& region : regions) {
+                        overlap = overlap || (covered & region.squares).any();
+                        covered |= region.squares;
+                    }
+                    Bitboard territories;
+                    for (auto const player : game.get_players()) {
+                        if (!game.is_finished(player)) {
+                            territories |= get_reachable(player, game.get_occupancy(player), game.get_occupancy());
+                        }
+                    }
+                    expect(that % regions.size() > 1u);
+                    expect(that % overlap == false);
+                    expect((covered == territories) == true);
+                };
+            };
+
+            when("When solving it region by region and as a whole") = [&game] {
+                ThreadPool pool(2);
+                auto const by_region = solve_endgame(game, pool);
+                EndgameConfig whole_config;
+                whole_config.decompose = false;
+                auto const whole = solve_endgame(game, pool, whole_config);
+
+                then("Then both find the same squares for every player") = [&] {
+                    for (std::size_t i = 0; i < game.get_players().size(); ++i) {
+                        expect(that % by_region.exact[i] == whole.exact[i]);
+                        expect(that % by_region.max_squares[i] == whole.max_squares[i]);
+                        expect(that % by_region.max_squares[i] <= game.get_remaining_pieces(game.get_players()[i]).get_square_count());
+                    }
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "Blokus/Engine.h"
+#include "Blokus/MoveGeneration.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite engine_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+    using namespace std::chrono_literals;
+
+    "Engine"_test = [] {
+
+        given("Given an engine with two threads") = [] {
+            Engine engine({ .pool = { .thread_count = 2 }, .mcts = { .iterations = 50 } });
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When searching more games than threads") = [&] {
+                std::vector<SearchHandle> handles;
+                for (int i = 0; i < 8; ++i) {
+                    handles.push_back(engine.submit({ .game = game }));
+                }
+                std::vector<MctsResult> results;
+                for (auto& handle : handles) {
+                    results.push_back(handle.get());
+                }
+
+                then("Then every search completes with a legal move") = [&] {
+                    for (auto const& result : results) {
+                        expect(that % is_legal(game, result.best_move) == true);
+                        expect(that % result.iterations == 50u);
+                    }
+                    expect(that % engine.get_pending_count() == 0u);
+                };
+            };
+
+            when("When cancelling an unbounded search") = [&] {
+                auto handle = engine.submit({ .game = game, .iterations = 1000000000 });
+                std::this_thread::sleep_for(20ms);
+                handle.cancel();
+                auto const result = handle.get();
+
+                then("Then it returns its best move so far") = [&] {
+                    expect(that % result.cancelled == true);
+                    expect(that % is_legal(game, result.best_move) == true);
+                };
+            };
+
+            when("When searching with a completion callback") = [&] {
+                std::promise<MctsResult> promise;
+                engine.submit({ .game = game, .priority = TaskPriority::High }, {}, [&promise](MctsResult result) {
+                    promise.set_value(result);
+                });
+                auto const result = promise.get_future().get();
+
+                then("Then the callback receives the result") = [&] {
+                    expect(that % result.iterations == 50u);
+                };
+            };
+
+            when("When searching without an iteration limit against a clock") = [&] {
+                auto handle = engine.submit({ .game = game, .iterations = 1000000000, .time_control = TimeControl{ .remaining = 2s } });
+                auto const result = handle.get();
+                auto const statistics = engine.get_time_statistics();
+
+                then("Then the time manager's budget stops the search and the move is recorded") = [&] {
+                    expect(that % is_legal(game, result.best_move) == true);
+                    expect(that % (result.elapsed < 1s) == true);
+                    expect(that % statistics.move_count == 1u);
+                };
+            };
+        };
+
+        given("Given an engine with pinned threads") = [] {
+            Engine engine({ .pool = { .thread_count = 2, .pin_threads = true }, .mcts = { .iterations = 50 } });
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When searching more games than threads") = [&] {
+                std::vector<SearchHandle> handles;
+                for (int i = 0; i < 4; ++i) {
+                    handles.push_back(engine.submit({ .game = game }));
+                }
+                auto all_legal = true;
+                for (auto& handle : handles) {
+                    all_legal = all_legal && is_legal(game, handle.get().best_move);
+                }
+
+                then("Then each worker's search completes with a legal move") = [&] {
+                    expect(that % engine.get_thread_count() == 2u);
+                    expect(that % all_legal == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
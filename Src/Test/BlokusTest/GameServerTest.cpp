@@ -0,0 +1,163 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Blokus/GameClient.h"
+#include "Blokus/GameServer.h"
+#include "Blokus/Protocol.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite game_server_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Protocol"_test = [] {
+
+        given("Given request lines") = [] {
+
+            when("When parsing a well formed bot request") = [] {
+                auto const command = parse_command("bot 3 500 20\r");
+
+                then("Then every argument is read") = [&command] {
+                    expect(that % command.has_value() == true);
+                    expect(that % command->game_id == 3u);
+                    expect(that % command->iterations == 500u);
+                    expect(that % command->milliseconds == 20u);
+                };
+            };
+
+            when("When parsing a bot request with a clock") = [] {
+                auto const command = parse_command("bot 3 500 clock 60000 500");
+                auto const missing_increment = parse_command("bot 3 500 clock 60000").has_value();
+
+                then("Then the clock and the increment are read") = [&] {
+                    expect(that % command.has_value() == true);
+                    expect(that % command->clock == true);
+                    expect(that % command->milliseconds == 60000u);
+                    expect(that % command->increment == 500u);
+                    expect(that % missing_increment == false);
+                };
+            };
+
+            when("When parsing malformed requests") = [] {
+                auto const unknown = parse_command("jump 1").has_value();
+                auto const missing = parse_command("play 1").has_value();
+                auto const trailing = parse_command("moves 1 2").has_value();
+                auto const duplicate_player = parse_command("new rr").has_value();
+
+                then("Then they are rejected") = [&] {
+                    expect(that % unknown == false);
+                    expect(that % missing == false);
+                    expect(that % trailing == false);
+                    expect(that % duplicate_player == false);
+                };
+            };
+        };
+    };
+
+    "GameServer"_test = [] {
+
+        given("Given a game server on the loopback") = [] {
+            GameServer server({ .engine = { .pool = { .thread_count = 2 } } });
+            std::thread loop([&server] { server.run(); });
+
+            when("When a client plays a game") = [&server] {
+                GameClient client("127.0.0.1", server.get_port());
+                auto const pong = client.request("ping");
+                auto const id = client.create_game({ PlayerId::Red, PlayerId::Green });
+                auto const first_moves = client.get_moves(id);
+                client.play(id, first_moves.back());
+                auto const illegal = client.request("play " + std::to_string(id) + " 0");
+                auto const bot_move = client.get_bot_move(id, 50);
+                auto const second_moves = client.get_moves(id);
+                auto const unknown = client.request("moves 999");
+
+                then("Then the server applies the moves and answers every request") = [&] {
+                    expect(that % pong == std::string("pong"));
+                    expect(that % first_moves.size() == 58u);
+                    expect(that % illegal == std::string("error illegal move"));
+                    expect(that % std::ranges::count(second_moves, bot_move) == 1);
+                    expect(that % unknown == std::string("error unknown game"));
+                };
+            };
+
+            when("When many clients play at once") = [&server] {
+                std::vector<std::thread> clients;
+                std::vector<int> plies(32, 0);
+                for (std::size_t i = 0; i < plies.size(); ++i) {
+                    clients.emplace_back([&server, &ply_count = plies[i], i] {
+                        GameClient client("127.0.0.1", server.get_port());
+                        auto const id = client.create_game({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+                        for (int ply = 0; ply < 8; ++ply) {
+                            auto const moves = client.get_moves(id);
+                            client.play(id, moves[(i * 7 + ply) % moves.size()]);
+                            ++ply_count;
+                        }
+                    });
+                }
+                for (auto& client : clients) {
+                    client.join();
+                }
+
+                then("Then every session is served") = [&plies] {
+                    for (auto const ply_count : plies) {
+                        expect(that % ply_count == 8);
+                    }
+                };
+            };
+
+            server.stop();
+            loop.join();
+        };
+
+        given("Given a game server with small limits") = [] {
+            GameServer server({ .max_pending_input = 4096, .max_bot_time = std::chrono::milliseconds(2000), .engine = { .pool = { .thread_count = 2 } } });
+            std::thread loop([&server] { server.run(); });
+
+            when("When a client asks for an endless search, and another floods requests during its own") = [&server] {
+                GameClient patient("127.0.0.1", server.get_port());
+                auto const patient_game = patient.create_game({ PlayerId::Red, PlayerId::Green });
+                auto const start = std::chrono::steady_clock::now();
+                auto const bot_reply = patient.request("bot " + std::to_string(patient_game) + " 4000000000");
+                auto const elapsed = std::chrono::steady_clock::now() - start;
+
+                GameClient flooding("127.0.0.1", server.get_port());
+                auto const flooding_game = flooding.create_game({ PlayerId::Red, PlayerId::Green });
+                auto closed = false;
+                try {
+                    flooding.send("bot " + std::to_string(flooding_game) + " 4000000000");
+                    for (int i = 0; i < 2000; ++i) {
+                        flooding.send("ping");
+                    }
+                    // Only a closed session ends this
+                    while (true) {
+                        flooding.receive();
+                    }
+                }
+                catch (std::runtime_error const&) {
+                    closed = true;
+                }
+
+                then("Then the search stops at the time limit and the flooding session is closed") = [&] {
+                    expect(that % bot_reply.starts_with("move ") == true);
+                    expect(that % (elapsed < std::chrono::seconds(10)) == true);
+                    expect(that % closed == true);
+                };
+            };
+
+            server.stop();
+            loop.join();
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
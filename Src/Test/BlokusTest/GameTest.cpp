@@ -0,0 +1,164 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Game.h"
+#include "Blokus/MoveGeneration.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+std::string test_print_helper(PlayerId const& value) {
+    return std::to_string(to_index(value));
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite game_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "BoardState"_test = [] {
+
+        given("Given a new game and players") = [] {
+            auto const first_player = PlayerId::Yellow;
+            auto const game = Game::CreateNew({ first_player, PlayerId::Red, PlayerId::Green, PlayerId::Blue });
+
+            when("When getting the board state") = [&game] {
+                auto const result = game.get_pieces_on_board().size();
+
+                then("Then there is no pieces on the board") = [&result] {
+                    expect(that % result == 0u);
+                };
+            };
+
+            when("When getting the current player") = [&game, &first_player] {
+                auto const result = game.get_current_player();
+
+                then("Then the current player is the first player") = [&result, &first_player] {
+                    expect(that % result == first_player);
+                };
+            };
+
+            when("When generating the first moves") = [&game] {
+                MoveList moves;
+                generate_moves(game, moves);
+                auto const result = moves.size();
+
+                then("Then every placement covering the starting corner is generated") = [&result] {
+                    expect(that % result == 58u);
+                };
+            };
+        };
+    };
+
+    "ApplyUndo"_test = [] {
+
+        given("Given a new game") = [] {
+            auto const reference = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When playing the first generated move of every ply and undoing all of them") = [&reference] {
+                auto game = reference;
+                MoveList moves;
+                bool all_legal = true;
+                while (!game.is_over()) {
+                    generate_moves(game, moves);
+                    all_legal = all_legal && is_legal(game, moves[0]);
+                    game.apply(moves[0]);
+                }
+                while (game.get_ply() > 0) {
+                    game.undo();
+                }
+                auto const result = game == reference;
+
+                then("Then every move is legal and the game is back to its initial state") = [&] {
+                    expect(that % all_legal == true);
+                    expect(that % result == true);
+                };
+            };
+        };
+    };
+
+    "MoveSource"_test = [] {
+
+        given("Given every position of a game") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When drawing the moves one at a time") = [&game] {
+                auto same_moves = true;
+                auto same_has_legal_move = true;
+                MoveList moves;
+                while (true) {
+                    generate_moves(game, moves);
+                    MoveSource source(game);
+                    std::size_t count = 0;
+                    while (auto const move = source.next()) {
+                        same_moves = same_moves && count < moves.size() && moves[count] == *move;
+                        ++count;
+                    }
+                    same_moves = same_moves && count == moves.size();
+                    auto const can_place = !moves.empty() && !moves[0].is_pass();
+                    same_has_legal_move = same_has_legal_move && has_legal_move(game) == can_place;
+                    if (game.is_over()) {
+                        break;
+                    }
+                    game.apply(moves[(game.get_ply() * 7) % moves.size()]);
+                }
+
+                then("Then they are the generated moves in the same order") = [&] {
+                    expect(that % same_moves == true);
+                    expect(that % same_has_legal_move == true);
+                };
+            };
+        };
+    };
+
+    "Reachability"_test = [] {
+
+        given("Given a game tracking the territories") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            game.track_reachable();
+
+            when("When playing it to the end, taking back a ply now and then, and undoing it all") = [&game] {
+                auto const matches = [](Game const& game) {
+                    for (auto const player : game.get_players()) {
+                        auto const flooded = get_reachable(player, game.get_occupancy(player), game.get_occupancy());
+                        if (!(game.get_reachable(player) == flooded)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+                auto const full_board = game.get_reachable(PlayerId::Red).count();
+                auto all_match = true;
+                while (!game.is_over()) {
+                    game.apply(get_test_move(game));
+                    all_match = all_match && matches(game);
+                    if (game.get_ply() % 5 == 0) {
+                        game.undo();
+                        all_match = all_match && matches(game);
+                        game.apply(get_test_move(game, 0));
+                        all_match = all_match && matches(game);
+                    }
+                }
+                while (game.get_ply() > 0) {
+                    game.undo();
+                    all_match = all_match && matches(game);
+                }
+
+                then("Then the kept territories are the flooded ones, the whole board at the start") = [&] {
+                    expect(that % all_match == true);
+                    expect(that % full_board == square_count);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
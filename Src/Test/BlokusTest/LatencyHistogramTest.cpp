@@ -0,0 +1,71 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <chrono>
+
+#include "Blokus/LatencyHistogram.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite latency_histogram_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+    using namespace std::chrono_literals;
+
+    "LatencyHistogram"_test = [] {
+
+        given("Given a histogram of the values from 1 to 100000 microseconds") = [] {
+            LatencyHistogram histogram;
+            for (int i = 1; i <= 100000; ++i) {
+                histogram.record(std::chrono::microseconds(i));
+            }
+
+            when("When reading its percentiles") = [&histogram] {
+                auto const p50 = histogram.get_percentile(50.0).count();
+                auto const p99 = histogram.get_percentile(99.0).count();
+                auto const p999 = histogram.get_percentile(99.9).count();
+
+                then("Then they are within the bucket precision") = [&] {
+                    // 7 precision bits, a bucket spans less than 1/64 of its values
+                    expect(that % p50 >= 50000000 and that % p50 <= 50000000 + 50000000 / 64);
+                    expect(that % p99 >= 99000000 and that % p99 <= 99000000 + 99000000 / 64);
+                    expect(that % p999 >= 99900000 and that % p999 <= 100000000);
+                    expect(that % histogram.get_max().count() == 100000000);
+                    expect(that % histogram.get_count() == 100000u);
+                };
+            };
+
+            when("When merging it with a histogram of slow values") = [&histogram] {
+                LatencyHistogram slow;
+                for (int i = 0; i < 100000; ++i) {
+                    slow.record(1s);
+                }
+                histogram.merge(slow);
+
+                then("Then the upper half of the merged values is slow") = [&histogram] {
+                    expect(that % histogram.get_count() == 200000u);
+                    expect(that % histogram.get_percentile(50.0).count() < 1000000000);
+                    expect(that % histogram.get_percentile(50.1).count() == 1000000000);
+                };
+            };
+        };
+
+        given("Given small values") = [] {
+            LatencyHistogram histogram;
+            histogram.record(3ns);
+            histogram.record(100ns);
+
+            when("When reading the extremes") = [&histogram] {
+                then("Then they are exact") = [&histogram] {
+                    expect(that % histogram.get_percentile(0.0).count() == 3);
+                    expect(that % histogram.get_percentile(100.0).count() == 100);
+                    expect(that % histogram.get_mean().count() == 52);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
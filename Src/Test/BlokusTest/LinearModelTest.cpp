@@ -0,0 +1,165 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "Blokus/Mcts.h"
+#include "Blokus/ModelTraining.h"
+#include "Blokus/MoveGeneration.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite linear_model_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "LinearModel"_test = [] {
+
+        given("Given a new model") = [] {
+            LinearModel const model;
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            MoveList moves;
+            generate_moves(game, moves);
+
+            when("When scoring the first position") = [&] {
+                std::vector<float> priors(moves.size());
+                model.get_priors(game, moves, priors);
+                auto const rewards = model.evaluate(game);
+
+                then("Then the priors are uniform and the values even") = [&] {
+                    auto uniform = true;
+                    for (auto const prior : priors) {
+                        uniform = uniform && std::abs(prior - 1.0f / static_cast<float>(moves.size())) < 1e-6f;
+                    }
+                    expect(that % uniform == true);
+                    expect(that % rewards[0] == 0.5f);
+                    expect(that % rewards[3] == 0.5f);
+                };
+            };
+
+            when("When saving it and loading it back") = [&model] {
+                auto const path = std::filesystem::temp_directory_path() / "BlokusLinearModelTest.bin";
+                auto saved = model;
+                saved.get_policy_weights()[7] = 0.25f;
+                saved.get_value_weights()[3] = -1.5f;
+                saved.save(path);
+                auto const loaded = LinearModel::load(path);
+                std::filesystem::remove(path);
+
+                then("Then the weights are the same") = [&] {
+                    expect(that % loaded.get_policy_weights()[7] == 0.25f);
+                    expect(that % loaded.get_value_weights()[3] == -1.5f);
+                };
+            };
+
+            when("When loading a file that isn't a model") = [] {
+                auto const path = std::filesystem::temp_directory_path() / "BlokusLinearModelTest.txt";
+                std::ofstream(path) << "not a model";
+                auto thrown = false;
+                try {
+                    LinearModel::load(path);
+                }
+                catch (std::runtime_error const&) {
+                    thrown = true;
+                }
+                std::filesystem::remove(path);
+
+                then("Then loading fails") = [&thrown] {
+                    expect(that % thrown == true);
+                };
+            };
+        };
+    };
+
+    "Training"_test = [] {
+
+        given("Given games where every player places its largest piece first") = [] {
+            Random random(1);
+            MoveList moves;
+            std::vector<GameRecord> records;
+            for (int i = 0; i < 40; ++i) {
+                auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+                while (!game.is_over()) {
+                    generate_moves(game, moves);
+                    auto largest = 0;
+                    for (auto const move : moves) {
+                        largest = move.is_pass() ? largest : std::max(largest, get_piece_size(get_piece(move)));
+                    }
+                    std::vector<Move> candidates;
+                    for (auto const move : moves) {
+                        if (move.is_pass() ? largest == 0 : get_piece_size(get_piece(move)) == largest) {
+                            candidates.push_back(move);
+                        }
+                    }
+                    game.apply(candidates[random.uniform(static_cast<std::uint32_t>(candidates.size()))]);
+                }
+                records.push_back(GameRecord::from_game(game));
+            }
+
+            when("When training a model on them") = [&] {
+                LinearModel model;
+                ThreadPool pool(2);
+                TrainingConfig config;
+                config.epochs = 2;
+                std::vector<EpochStatistics> epochs;
+                train_linear_model(model, records, pool, config, [&epochs](EpochStatistics const& statistics) {
+                    epochs.push_back(statistics);
+                });
+
+                auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+                generate_moves(game, moves);
+                std::vector<float> priors(moves.size());
+                model.get_priors(game, moves, priors);
+                float pentominoes = 0.0f;
+                for (std::size_t i = 0; i < moves.size(); ++i) {
+                    pentominoes += get_piece_size(get_piece(moves[i])) == 5 ? priors[i] : 0.0f;
+                }
+
+                then("Then the loss goes down and the priors favor the largest pieces") = [&] {
+                    expect(that % epochs.size() == 2u);
+                    expect(that % epochs[1].policy_loss < epochs[0].policy_loss);
+                    expect(that % pentominoes > 0.5f);
+                };
+
+                then("Then a search guided by the model plays legal moves") = [&] {
+                    Mcts mcts({ .iterations = 100, .model = std::make_shared<LinearModel const>(model) });
+                    auto const result = mcts.search(game);
+                    expect(that % is_legal(game, result.best_move) == true);
+                };
+            };
+
+            when("When training a model on them and a record that doesn't replay") = [&] {
+                GameRecord corrupted;
+                corrupted.players = { PlayerId::Red, PlayerId::Red };
+                corrupted.moves = { Move::from_value(0xfe00 | 399) };
+                auto with_corrupted = records;
+                with_corrupted.push_back(corrupted);
+
+                LinearModel model;
+                ThreadPool pool(2);
+                TrainingConfig config;
+                config.epochs = 1;
+                std::vector<EpochStatistics> epochs;
+                train_linear_model(model, with_corrupted, pool, config, [&epochs](EpochStatistics const& statistics) {
+                    epochs.push_back(statistics);
+                });
+
+                then("Then the record is skipped and counted") = [&] {
+                    expect(that % epochs.size() == 1u);
+                    expect(that % epochs[0].skipped_games == 1u);
+                    expect(that % epochs[0].positions > 0u);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
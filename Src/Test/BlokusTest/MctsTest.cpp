@@ -0,0 +1,114 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Mcts.h"
+#include "Blokus/MoveGeneration.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite mcts_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Mcts"_test = [] {
+
+        given("Given a new game") = [] {
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When searching a few iterations") = [&game] {
+                Mcts mcts({ .iterations = 200 });
+                auto const result = mcts.search(game);
+
+                then("Then the best move is legal and the tree was allocated in the arena") = [&] {
+                    expect(that % is_legal(game, result.best_move) == true);
+                    expect(that % result.iterations == 200u);
+                    expect(that % result.arena.high_water_mark > 0u);
+                };
+            };
+
+            when("When searching twice with the same engine") = [&game] {
+                Mcts mcts({ .iterations = 200 });
+                auto const first = mcts.search(game);
+                auto const second = mcts.search(game);
+
+                then("Then the high water mark covers both searches") = [&] {
+                    expect(that % second.arena.high_water_mark >= first.arena.high_water_mark);
+                    expect(that % second.arena.high_water_mark >= second.arena.used_size);
+                };
+            };
+
+            when("When searching again after the best move was played") = [&game] {
+                Mcts mcts({ .iterations = 200 });
+                auto next_game = game;
+                next_game.apply(mcts.search(game).best_move);
+                auto const result = mcts.search(next_game);
+
+                then("Then the statistics of the played subtree are reused") = [&] {
+                    expect(that % result.reused_visits > 0u);
+                    expect(that % is_legal(next_game, result.best_move) == true);
+                };
+            };
+        };
+    };
+
+    "SearchTree"_test = [] {
+
+        given("Given a search tree of a new game") = [] {
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            SearchTree tree;
+            tree.reset(game);
+            Random random;
+            for (int i = 0; i < 100; ++i) {
+                tree.run_iteration(random, 0.7f);
+            }
+
+            when("When advancing to an unrelated game") = [&tree] {
+                auto const other = Game::CreateNew({ PlayerId::Blue, PlayerId::Yellow });
+                auto const result = tree.advance(other);
+
+                then("Then the tree is kept as is") = [&] {
+                    expect(that % result == false);
+                    expect(that % tree.get_root().visits == 100u);
+                };
+            };
+
+            when("When advancing to the same game") = [&tree, &game] {
+                auto const used_before = tree.get_arena_statistics().used_size;
+                auto const result = tree.advance(game);
+                auto const statistics = tree.get_arena_statistics();
+
+                then("Then the whole tree is compacted with its statistics, both copies counting at the peak") = [&] {
+                    expect(that % result == true);
+                    expect(that % tree.get_root().visits == 100u);
+                    expect(that % statistics.high_water_mark >= used_before + statistics.used_size);
+                };
+            };
+        };
+
+        given("Given a search tree with a memory limit") = [] {
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            SearchTree tree({ .block_size = 16 * 1024, .max_reserved_size = 64 * 1024 });
+            tree.reset(game);
+
+            when("When searching and advancing past what the limit holds") = [&] {
+                Random random;
+                auto all_grew = true;
+                for (int i = 0; i < 2000; ++i) {
+                    all_grew = tree.run_iteration(random, 0.7f) && all_grew;
+                }
+                auto const advanced = tree.advance(game);
+                auto const statistics = tree.get_arena_statistics();
+
+                then("Then both arenas together stay within the limit") = [&] {
+                    expect(that % all_grew == false);
+                    expect(that % advanced == true);
+                    expect(that % statistics.reserved_size <= 64u * 1024u);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "Blokus/MoveQuery.h"
+#include "Blokus/MoveTable.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite move_table_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Condition"_test = [] {
+
+        given("Given conditions written as text") = [] {
+            when("When parsing them") = [] {
+                auto const piece = parse_condition("piece=5l");
+                auto const turn = parse_condition("turn<=3");
+                auto const unknown = parse_condition("colour=1");
+
+                then("Then pieces are read by name and two character operators are recognized") = [&] {
+                    expect(that % piece.has_value() == true);
+                    expect(that % piece.value_or(Condition{}).value == 20);
+                    expect(that % (turn.value_or(Condition{}).comparison == Comparison::LessEqual) == true);
+                    expect(that % turn.value_or(Condition{}).value == 3);
+                    expect(that % unknown.has_value() == false);
+                };
+            };
+        };
+    };
+
+    "MoveTable"_test = [] {
+
+        given("Given a table of two games") = [] {
+            std::vector<GameRecord> records{ make_test_record(Game::max_ply_count, 13, 1), make_test_record(Game::max_ply_count, 13, 2) };
+            MoveTable first;
+            MoveTable second;
+            first.add_game(records[0]);
+            second.add_game(records[1]);
+            MoveTable table;
+            table.append(first);
+            table.append(second);
+
+            std::size_t placed = 0;
+            for (auto const& record : records) {
+                for (auto const move : record.moves) {
+                    placed += move.is_pass() ? 0 : 1;
+                }
+            }
+
+            when("When counting the moves of each game and the first moves of each player") = [&] {
+                ThreadPool pool(2);
+                MoveQuery query;
+                query.group_by = MoveColumn::Game;
+                auto const by_game = run_query(table, query, pool);
+
+                query.group_by.reset();
+                query.conditions = { { MoveColumn::Turn, Comparison::Equal, 0 } };
+                auto const first_moves = run_query(table, query, pool);
+
+                // Beyond the range of the column, every row matches
+                query.conditions = { { MoveColumn::Score, Comparison::Less, 1000 } };
+                auto const all = run_query(table, query, pool);
+
+                then("Then the counts match the records") = [&] {
+                    expect(that % table.get_game_count() == 2u);
+                    expect(that % table.get_row_count() == placed);
+                    expect(that % by_game.size() == 2u);
+                    expect(that % (by_game[0].count + by_game[1].count) == placed);
+                    expect(that % first_moves[0].count == 8u);
+                    expect(that % all[0].count == placed);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Move.h"
+#include "Blokus/MoveList.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+unit_testing::TestPrintHelperData test_print_helper(Position const& value) {
+    using namespace std::string_literals;
+    return { { "x"s, value.get_x() }, { "y"s, value.get_y() } };
+}
+
+std::string test_print_helper(PieceId const& value) {
+    return std::to_string(to_index(value));
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite move_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Orientations"_test = [] {
+
+        given("Given the orientation table") = [] {
+            auto const orientations = get_orientations();
+
+            when("When counting the orientations of every piece") = [&orientations] {
+                auto const result = orientations.size();
+
+                then("Then there is 91 distinct orientations") = [&result] {
+                    expect(that % result == 91u);
+                };
+            };
+
+            when("When getting the range of the 5l piece") = [] {
+                auto const range = get_orientation_range(PieceId::P5l);
+                auto const result = static_cast<int>(range.last);
+
+                then("Then it is the last range of the table") = [&result] {
+                    expect(that % result == 91);
+                };
+            };
+        };
+    };
+
+    "Move"_test = [] {
+
+        given("Given a move") = [] {
+            auto const orientation = get_orientation_range(PieceId::P3b).first;
+            auto const position = Position{ 17, 2 };
+            auto const move = Move{ orientation, to_square(position) };
+
+            when("When decoding the move") = [&move, &orientation, &position] {
+                auto const result_orientation = static_cast<int>(move.get_orientation());
+                auto const result_position = get_position(move);
+
+                then("Then the orientation and the position are the encoded ones") = [&] {
+                    expect(that % result_orientation == static_cast<int>(orientation));
+                    expect(that % result_position == position);
+                    expect(that % get_piece(move) == PieceId::P3b);
+                };
+            };
+
+            when("When getting the move footprint") = [&move] {
+                auto const result = get_footprint(move).count();
+
+                then("Then it covers as many squares as the piece") = [&result] {
+                    expect(that % result == 3);
+                };
+            };
+        };
+
+        given("Given the pass move") = [] {
+            auto const move = Move::pass();
+
+            when("When checking if it is a pass") = [&move] {
+                auto const result = move.is_pass();
+
+                then("Then it is a pass") = [&result] {
+                    expect(that % result == true);
+                };
+            };
+        };
+
+        given("Given the last orientation on the last square") = [] {
+            auto const move = Move{ static_cast<OrientationIndex>(orientation_count - 1), static_cast<Square>(square_count - 1) };
+
+            when("When comparing it to the pass move") = [&move] {
+                auto const result = move == Move::pass();
+
+                then("Then the encodings don't collide") = [&result] {
+                    expect(that % result == false);
+                };
+            };
+        };
+    };
+
+    "MoveList"_test = [] {
+
+        given("Given a move list") = [] {
+            MoveList moves;
+
+            when("When adding moves") = [&moves] {
+                moves.push_back(Move::pass());
+                moves.push_back(Move{ 0, 0 });
+                auto const result = moves.size();
+
+                then("Then the moves are kept in order") = [&result, &moves] {
+                    expect(that % result == 2u);
+                    expect(that % moves[0].is_pass() == true);
+                };
+            };
+
+            when("When adding more moves than it holds") = [&moves] {
+                moves.clear();
+                for (std::size_t i = 0; i <= MoveList::capacity; ++i) {
+                    moves.push_back(Move{ 0, static_cast<Square>(i % static_cast<std::size_t>(square_count)) });
+                }
+
+                then("Then the extra moves are dropped") = [&moves] {
+                    expect(that % moves.size() == MoveList::capacity);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,117 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/Ponderer.h"
+#include "Blokus/ThreadPool.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite ponderer_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "ThreadPool"_test = [] {
+
+        given("Given a thread pool") = [] {
+            ThreadPool pool(2);
+
+            when("When submitting a task") = [&pool] {
+                auto const result = pool.submit([] { return 42; }).get();
+
+                then("Then its future holds the task result") = [&result] {
+                    expect(that % result == 42);
+                };
+            };
+
+            when("When queueing tasks of different priorities behind a busy thread") = [&pool] {
+                std::promise<void> gate;
+                auto const opened = gate.get_future().share();
+                auto blockers = std::vector{
+                    pool.submit([opened] { opened.wait(); }),
+                    pool.submit([opened] { opened.wait(); }),
+                };
+
+                std::mutex mutex;
+                std::vector<int> order;
+                auto const record = [&mutex, &order](int value) {
+                    return [&mutex, &order, value] {
+                        std::scoped_lock lock(mutex);
+                        order.push_back(value);
+                    };
+                };
+                auto low = pool.submit(record(1), TaskPriority::Low);
+                auto high = pool.submit(record(2), TaskPriority::High);
+                gate.set_value();
+                low.get();
+                high.get();
+
+                then("Then the high priority task runs first") = [&order] {
+                    expect(that % order.front() == 2);
+                };
+            };
+        };
+    };
+
+    "Ponderer"_test = [] {
+
+        given("Given a ponderer on a new game") = [] {
+            ThreadPool pool(2);
+            Ponderer ponderer(pool, { .worker_count = 2 });
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When searching our move") = [&ponderer, &game] {
+                auto const result = ponderer.search(game, 100);
+
+                then("Then the merged best move is legal") = [&] {
+                    expect(that % is_legal(game, result.best_move) == true);
+                    expect(that % result.iterations >= 100u);
+                };
+            };
+
+            when("When searching a finished game") = [&ponderer] {
+                auto finished = Game::CreateNew({ PlayerId::Red, PlayerId::Green });
+                play_test_moves(finished, Game::max_ply_count, 0);
+                auto const result = ponderer.search(finished, 10);
+
+                then("Then the best move is the pass") = [&result] {
+                    expect(that % result.best_move.is_pass() == true);
+                };
+            };
+
+            when("When pondering while an opponent plays") = [&ponderer, &game] {
+                MoveList moves;
+                generate_moves(game, moves);
+                game.apply(moves[0]);
+
+                ponderer.start(game);
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                auto const running = ponderer.is_running();
+
+                generate_moves(game, moves);
+                game.apply(moves[0]);
+                ponderer.update(game);
+                auto const still_running = ponderer.is_running();
+                ponderer.stop();
+
+                then("Then the search keeps running after the re-root until stopped") = [&] {
+                    expect(that % running == true);
+                    expect(that % still_running == true);
+                    expect(that % ponderer.is_running() == false);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/PositionDatabase.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Quarter turn clockwise, the red corner goes to the green one
+blokus::Bitboard rotate(blokus::Bitboard const& bitboard) {
+    using namespace blokus;
+
+    Bitboard rotated;
+    bitboard.for_each([&rotated](Square square) {
+        auto const x = square % board_size;
+        auto const y = square / board_size;
+        rotated.set(static_cast<Square>(x * board_size + board_size - 1 - y));
+    });
+    return rotated;
+}
+
+// Plays the move covering the footprint, or a pass
+void apply_footprint(blokus::Game& game, blokus::Bitboard const& footprint) {
+    using namespace blokus;
+
+    MoveList moves;
+    generate_moves(game, moves);
+    for (auto const move : moves) {
+        if (move.is_pass() ? footprint.none() : get_footprint(move) == footprint) {
+            game.apply(move);
+            return;
+        }
+    }
+}
+
+std::vector<blokus::GameRecord> make_records(std::size_t count) {
+    using namespace blokus;
+
+    std::vector<GameRecord> records;
+    for (std::size_t i = 0; i < count; ++i) {
+        // Every game shares the first two plies
+        auto game = make_test_game(2, 0);
+        play_test_moves(game, Game::max_ply_count, 1, i);
+        records.push_back(GameRecord::from_game(game));
+    }
+    return records;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite position_database_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "CanonicalPosition"_test = [] {
+
+        given("Given a game and the same game rotated a quarter turn with the colors shifted") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            auto rotated = Game::CreateNew({ PlayerId::Green, PlayerId::Blue, PlayerId::Yellow, PlayerId::Red });
+
+            when("When playing the same moves in both") = [&] {
+                for (std::size_t ply = 0; ply < 12; ++ply) {
+                    auto const move = get_test_move(game);
+                    apply_footprint(rotated, move.is_pass() ? Bitboard{} : rotate(get_footprint(move)));
+                    game.apply(move);
+                }
+                auto const position = CanonicalPosition::from_game(game);
+                auto const rotated_position = CanonicalPosition::from_game(rotated);
+
+                std::vector<std::uint8_t> encoded;
+                position.encode(encoded);
+                auto const decoded = CanonicalPosition::decode(encoded);
+
+                then("Then both have the same canonical position, which encodes losslessly") = [&] {
+                    expect(that % (position == rotated_position) == true);
+                    expect(that % position.get_hash() == rotated_position.get_hash());
+                    expect(that % encoded.size() == CanonicalPosition::encoded_size);
+                    expect(that % (decoded == position) == true);
+                };
+            };
+        };
+    };
+
+    "PositionDatabase"_test = [] {
+
+        given("Given games sharing their opening and a database in a temporary directory") = [] {
+            auto const directory = std::filesystem::temp_directory_path() / "BlokusPositionDatabaseTest";
+            std::filesystem::remove_all(directory);
+            auto const records = make_records(6);
+            auto const root = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When merging the games from two batches and reopening the database") = [&] {
+                std::size_t position_count = 0;
+                std::size_t unique_count = 0;
+                {
+                    PositionDatabase database(directory);
+                    PositionBatch first;
+                    PositionBatch second;
+                    for (std::size_t i = 0; i < records.size(); ++i) {
+                        (i % 2 == 0 ? first : second).add_game(records[i]);
+                        position_count += records[i].moves.size();
+                    }
+                    database.merge(first);
+                    database.merge(second);
+                    unique_count = database.get_position_count();
+                }
+                PositionDatabase database(directory);
+                auto const statistics = database.find(root);
+                auto const loaded = database.load_position(CanonicalPosition::from_game(root).get_hash());
+
+                then("Then each position is stored once with the visits of every game") = [&] {
+                    expect(that % unique_count < position_count);
+                    expect(that % database.get_position_count() == unique_count);
+                    expect(that % statistics.has_value() == true);
+                    expect(that % statistics.value_or(PositionStatistics{}).visits == 6u);
+                    expect(that % (loaded == CanonicalPosition::from_game(root)) == true);
+                };
+            };
+
+            when("When merging the database into another one twice") = [&] {
+                auto const other = directory.parent_path() / "BlokusPositionDatabaseTestMerged";
+                std::filesystem::remove_all(other);
+                std::size_t position_count = 0;
+                std::size_t merged_count = 0;
+                PositionStatistics statistics;
+                {
+                    PositionDatabase database(directory);
+                    position_count = database.get_position_count();
+                    PositionDatabase merged(other);
+                    merged.merge_from(directory);
+                    merged.merge_from(directory);
+                    merged_count = merged.get_position_count();
+                    statistics = merged.find(root).value_or(PositionStatistics{});
+                }
+                std::filesystem::remove_all(other);
+
+                then("Then the positions are the same and the visits add up") = [&] {
+                    expect(that % merged_count == position_count);
+                    expect(that % statistics.visits == 12u);
+                };
+            };
+
+            std::filesystem::remove_all(directory);
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,59 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/RecordValidation.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite record_validation_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "RecordValidation"_test = [] {
+
+        given("Given a complete game record") = [] {
+            auto const record = make_test_record(Game::max_ply_count, 13);
+
+            when("When validating it and damaged copies of it") = [&record] {
+                auto const valid = validate_record(record);
+
+                auto illegal = record;
+                illegal.moves[5] = illegal.moves[3];
+                auto const illegal_check = validate_record(illegal);
+
+                auto unfinished = record;
+                unfinished.moves.pop_back();
+                auto const unfinished_check = validate_record(unfinished);
+
+                auto extended = record;
+                extended.moves.push_back(Move::pass());
+                auto const extended_check = validate_record(extended);
+
+                auto seated_twice = record;
+                seated_twice.players[1] = PlayerId::Red;
+                auto const seated_twice_check = validate_record(seated_twice);
+
+                auto tampered = record;
+                tampered.scores[2] += 1;
+                auto const tampered_check = validate_record(tampered);
+
+                then("Then the first problem of each copy is found") = [&] {
+                    expect(that % (valid.status == RecordStatus::Valid) == true);
+                    expect(that % (illegal_check.status == RecordStatus::IllegalMove) == true);
+                    expect(that % illegal_check.ply == 5u);
+                    expect(that % (unfinished_check.status == RecordStatus::Unfinished) == true);
+                    expect(that % (extended_check.status == RecordStatus::MoveAfterEnd) == true);
+                    expect(that % extended_check.ply == record.moves.size());
+                    expect(that % (seated_twice_check.status == RecordStatus::InvalidPlayers) == true);
+                    expect(that % (tampered_check.status == RecordStatus::ScoreMismatch) == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <algorithm>
+
+#include "Blokus/DagMcts.h"
+#include "Blokus/MoveGeneration.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite search_graph_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "PositionHash"_test = [] {
+
+        given("Given a game in progress") = [] {
+            auto game = make_test_game(12);
+            auto const hash = get_position_hash(game);
+
+            when("When playing a move and taking it back") = [&] {
+                MoveList moves;
+                generate_moves(game, moves);
+                game.apply(moves[0]);
+                auto const played_hash = get_position_hash(game);
+                game.undo();
+
+                then("Then the hash changes and comes back") = [&] {
+                    expect(that % hash != 0u);
+                    expect(that % played_hash != hash);
+                    expect(that % get_position_hash(game) == hash);
+                };
+            };
+        };
+    };
+
+    "Search"_test = [] {
+
+        given("Given a position late enough for the moves of each player to commute") = [] {
+            auto const game = make_test_game(48);
+            MoveList moves;
+            generate_moves(game, moves);
+
+            when("When searching it on several threads") = [&] {
+                ThreadPool pool(2);
+                DagMcts search({ .iterations = 2000, .exploration = 0.7f, .seed = 0, .graph = {} });
+                auto const result = search.search(game, pool);
+
+                then("Then transposed move orders share their nodes and the best move is legal") = [&] {
+                    expect(that % result.iterations == 2000u);
+                    expect(that % result.graph.transposition_count > 0u);
+                    expect(that % result.graph.node_count <= 2001u);
+                    expect(that % result.graph.failed_insertion_count == 0u);
+                    expect((std::ranges::find(moves, result.best_move) != moves.end()) == true);
+                };
+            };
+
+            when("When searching twice on pinned threads with the table split in parts") = [&] {
+                ThreadPool pool({ .thread_count = 2, .pin_threads = true });
+                SearchGraphConfig graph;
+                graph.partition_count = 4;
+                DagMcts search({ .iterations = 2000, .exploration = 0.7f, .seed = 0, .graph = graph });
+                search.search(game, pool);
+                auto const result = search.search(game, pool);
+                auto const worker = pool.submit([&pool] { return pool.get_current_worker(); }).get();
+
+                then("Then every part is cleared between the searches and the threads know their index") = [&] {
+                    expect(that % result.iterations == 2000u);
+                    expect(that % result.graph.transposition_count > 0u);
+                    expect(that % result.graph.node_count <= 2001u);
+                    expect(that % result.graph.failed_insertion_count == 0u);
+                    expect((std::ranges::find(moves, result.best_move) != moves.end()) == true);
+                    expect(that % worker.has_value() == true);
+                    expect(that % *worker < 2u);
+                    expect(that % pool.get_current_worker().has_value() == false);
+                };
+            };
+
+            when("When the position table is too small for the search") = [&] {
+                ThreadPool pool(2);
+                SearchGraphConfig graph;
+                graph.table_size = 64;
+                DagMcts search({ .iterations = 500, .exploration = 0.7f, .seed = 0, .graph = graph });
+                auto const result = search.search(game, pool);
+
+                then("Then the search still completes once the table stops growing") = [&] {
+                    expect(that % result.iterations == 500u);
+                    expect(that % result.graph.node_count == 48u);
+                    expect(that % result.graph.failed_insertion_count > 0u);
+                    expect((std::ranges::find(moves, result.best_move) != moves.end()) == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
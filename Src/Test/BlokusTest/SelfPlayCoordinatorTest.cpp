@@ -0,0 +1,163 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <chrono>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Blokus/GameClient.h"
+#include "Blokus/RecordValidation.h"
+#include "Blokus/SelfPlayCoordinator.h"
+#include "Blokus/SelfPlayWorker.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite self_play_coordinator_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "SelfPlayProtocol"_test = [] {
+
+        given("Given worker requests and coordinator replies") = [] {
+
+            when("When parsing a result and a batch") = [] {
+                GameRecord const record{ { PlayerId::Red, PlayerId::Green }, { Move::from_value(1234), Move::pass() }, { -12, 20 } };
+                auto const request = parse_worker_request(format_result(7, 3, record));
+                auto const batch = parse_batch("7 700 16 1000 4 2");
+
+                then("Then every argument is read") = [&] {
+                    expect(that % request.has_value() == true);
+                    expect(that % request->batch_id == 7u);
+                    expect(that % request->game_index == 3u);
+                    expect(that % (request->record == record) == true);
+                    expect(that % batch.has_value() == true);
+                    expect(that % batch->seed == 700u);
+                    expect(that % batch->model_generation == 2u);
+                };
+            };
+
+            when("When parsing malformed requests") = [] {
+                auto const unknown = parse_worker_request("work").has_value();
+                auto const nameless = parse_worker_request("hello 1").has_value();
+                auto const bad_move = parse_worker_request("result 1 0 rg -3,0 12x").has_value();
+                auto const missing_score = parse_worker_request("result 1 0 rg -3").has_value();
+                auto const odd_hex = parse_hex("abc").has_value();
+
+                then("Then they are rejected") = [&] {
+                    expect(that % unknown == false);
+                    expect(that % nameless == false);
+                    expect(that % bad_move == false);
+                    expect(that % missing_score == false);
+                    expect(that % odd_hex == false);
+                };
+            };
+        };
+    };
+
+    "SelfPlayCoordinator"_test = [] {
+
+        given("Given a coordinator of 6 games in batches of 2 on the loopback") = [] {
+            std::vector<CompletedBatch> batches;
+            SelfPlayCoordinator coordinator({
+                .games = 6,
+                .batch_games = 2,
+                .iterations = 10,
+                .lease = std::chrono::milliseconds(1000),
+                .retry_delay = std::chrono::milliseconds(50),
+            }, [&batches](CompletedBatch&& batch) {
+                batches.push_back(std::move(batch));
+            });
+            std::thread loop([&coordinator] { coordinator.run(); });
+
+            when("When a worker leaves with a batch, another goes silent with one, and two workers play the rest") = [&] {
+                {
+                    GameClient leaving("127.0.0.1", coordinator.get_port());
+                    leaving.request("hello 1 leaving");
+                    leaving.request("batch");
+                }
+                std::optional<GameClient> silent(std::in_place, "127.0.0.1", coordinator.get_port());
+                auto const refused = silent->request("batch");
+                silent->request("hello 1 silent");
+                silent->request("batch");
+
+                std::vector<SelfPlayWorkerStatistics> statistics(2);
+                std::vector<std::thread> workers;
+                for (std::size_t i = 0; i < statistics.size(); ++i) {
+                    workers.emplace_back([&, i] {
+                        ThreadPool pool(1);
+                        SelfPlayWorker worker({ .port = coordinator.get_port(), .name = "worker" + std::to_string(i) }, pool);
+                        statistics[i] = worker.run();
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+                // The coordinator is done once the last worker leaves
+                silent.reset();
+                loop.join();
+
+                auto all_valid = true;
+                std::size_t game_count = 0;
+                std::set<std::uint64_t> ids;
+                for (auto const& batch : batches) {
+                    ids.insert(batch.id);
+                    for (auto const& record : batch.records) {
+                        all_valid = all_valid && validate_record(record).status == RecordStatus::Valid;
+                        ++game_count;
+                    }
+                }
+                auto const coordinator_statistics = coordinator.get_statistics();
+
+                // A slow machine can also run out the lease of the playing workers, that only adds duplicates
+                then("Then every game is kept once and the abandoned batches are handed out again") = [&] {
+                    expect(that % refused == std::string("error hello first"));
+                    expect(that % batches.size() == 3u);
+                    expect(that % ids.size() == 3u);
+                    expect(that % game_count == 6u);
+                    expect(that % all_valid == true);
+                    expect(that % coordinator_statistics.reassigned >= 2u);
+                    expect(that % statistics[0].games + statistics[1].games == 6u + coordinator_statistics.duplicates);
+                };
+            };
+        };
+
+        given("Given a coordinator with a model and a small output limit") = [] {
+            SelfPlayCoordinator coordinator({ .max_pending_output = 256 * 1024 }, [](CompletedBatch&&) {});
+            coordinator.set_model(std::string(32 * 1024, 'm'));
+            std::thread loop([&coordinator] { coordinator.run(); });
+
+            when("When a worker asks for the model again and again without reading the replies") = [&coordinator] {
+                GameClient flooding("127.0.0.1", coordinator.get_port());
+                auto closed = false;
+                try {
+                    flooding.send("hello 1 flooding");
+                    for (int i = 0; i < 1000; ++i) {
+                        flooding.send("model");
+                    }
+                    // Only a closed session ends this
+                    while (true) {
+                        flooding.receive();
+                    }
+                }
+                catch (std::runtime_error const&) {
+                    closed = true;
+                }
+
+                then("Then its session is closed") = [&closed] {
+                    expect(that % closed == true);
+                };
+            };
+
+            coordinator.stop();
+            loop.join();
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -0,0 +1,150 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "Blokus/BoundedQueue.h"
+#include "Blokus/Compression.h"
+#include "Blokus/GameRecord.h"
+#include "Blokus/Shard.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite self_play_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "BoundedQueue"_test = [] {
+
+        given("Given a queue of capacity 4") = [] {
+            BoundedQueue<int> queue(4);
+
+            when("When pushing more values than it holds") = [&queue] {
+                auto pushed = 0;
+                for (auto value = 0; value < 6; ++value) {
+                    pushed += queue.try_push(value) ? 1 : 0;
+                }
+                auto const first = queue.try_pop();
+
+                then("Then the extra values are refused and the others come out in order") = [&] {
+                    expect(that % pushed == 4);
+                    expect(that % first.value_or(-1) == 0);
+                };
+            };
+        };
+    };
+
+    "Compression"_test = [] {
+
+        given("Given repetitive bytes") = [] {
+            std::vector<std::uint8_t> input;
+            for (auto i = 0; i < 4096; ++i) {
+                input.push_back(static_cast<std::uint8_t>(i % 7));
+            }
+
+            when("When compressing and decompressing them") = [&input] {
+                auto const compressed = lz_compress(input);
+                auto const decompressed = lz_decompress(compressed, input.size());
+                auto const wrong_size = lz_decompress(compressed, input.size() + 1);
+
+                then("Then they shrink and come back unchanged") = [&] {
+                    expect(that % compressed.size() < input.size() / 10);
+                    expect(that % (decompressed == input) == true);
+                    expect(that % wrong_size.has_value() == false);
+                };
+            };
+        };
+    };
+
+    "Shard"_test = [] {
+
+        given("Given a shard writer in a temporary directory") = [] {
+            auto const directory = std::filesystem::temp_directory_path() / "BlokusShardTest";
+            std::filesystem::remove_all(directory);
+            ShardConfig const config{ .directory = directory, .prefix = "test" };
+
+            std::vector<std::uint8_t> block;
+            auto const record = make_test_record(30, 1);
+            append_record(block, record);
+            append_record(block, make_test_record(10, 1));
+
+            when("When resuming after a block written past the checkpoint") = [&] {
+                ShardPosition checkpoint;
+                {
+                    ShardWriter writer(config);
+                    writer.write_block(block, 2);
+                    checkpoint = writer.get_position();
+                    writer.write_block(block, 2);
+                }
+                {
+                    ShardWriter writer(config, checkpoint);
+                    writer.write_block(block, 2);
+                }
+
+                std::size_t block_count = 0;
+                std::vector<std::uint8_t> read;
+                std::uint32_t record_count = 0;
+                ShardReader reader(get_shard_path(config, 0));
+                while (reader.read_block(read, record_count)) {
+                    ++block_count;
+                }
+                std::size_t offset = 0;
+                auto const first = read_record(read, offset);
+
+                then("Then the dropped block is replaced and the records read back") = [&] {
+                    expect(that % block_count == 2u);
+                    expect(that % record_count == 2u);
+                    expect(that % (first == record) == true);
+                };
+            };
+
+            when("When reading blocks whose header claims more bytes than a block or the file holds") = [&] {
+                auto const is_rejected = [&](std::uint32_t raw_size, std::uint32_t compressed_size) {
+                    {
+                        ShardWriter writer(config);
+                        writer.write_block(block, 2);
+                    }
+                    {
+                        // The sizes follow the shard header and the record count
+                        std::fstream file(get_shard_path(config, 0), std::ios::binary | std::ios::in | std::ios::out);
+                        file.seekp(12);
+                        for (auto const size : { raw_size, compressed_size }) {
+                            for (int i = 0; i < 4; ++i) {
+                                file.put(static_cast<char>(size >> (8 * i)));
+                            }
+                        }
+                    }
+                    try {
+                        std::vector<std::uint8_t> read;
+                        std::uint32_t record_count = 0;
+                        ShardReader reader(get_shard_path(config, 0));
+                        reader.read_block(read, record_count);
+                    }
+                    catch (std::runtime_error const&) {
+                        return true;
+                    }
+                    return false;
+                };
+                auto const huge_raw_size = is_rejected(0xffffffff, 16);
+                auto const huge_compressed_size = is_rejected(1000, 0xfffffff0);
+
+                then("Then both are rejected before allocating") = [&] {
+                    expect(that % huge_raw_size == true);
+                    expect(that % huge_compressed_size == true);
+                };
+            };
+
+            std::filesystem::remove_all(directory);
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
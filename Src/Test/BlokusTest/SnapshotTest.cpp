@@ -0,0 +1,46 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Blokus/Snapshot.h"
+
+#include "TestGames.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite snapshot_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    "Snapshot"_test = [] {
+
+        given("Given every state of a game") = [] {
+            auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            std::vector<Snapshot> snapshots{ Snapshot::from_game(game) };
+            while (!game.is_over()) {
+                game.apply(get_test_move(game, 1));
+                snapshots.push_back(Snapshot::from_game(game));
+            }
+
+            when("When encoding them as a batch") = [&snapshots] {
+                std::vector<std::uint8_t> encoded;
+                encode_snapshots(snapshots, encoded);
+                auto const decoded = decode_snapshots(encoded);
+                auto const truncated = decode_snapshots(std::span(encoded).first(encoded.size() - 1));
+
+                then("Then each state takes a few bytes and decodes unchanged") = [&] {
+                    expect(that % encoded.size() < snapshots.size() * 16);
+                    expect(that % (decoded == snapshots) == true);
+                    expect(that % truncated.has_value() == false);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
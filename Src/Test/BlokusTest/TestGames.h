@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Blokus/Game.h"
+#include "Blokus/GameRecord.h"
+#include "Blokus/MoveGeneration.h"
+
+// ----------------------------------------------------------------------------
+
+namespace blokus {
+
+// ----------------------------------------------------------------------------
+
+// Deterministic games shared by the tests. The move played at each ply is moves[(seed + ply * stride) % count],
+// a stride of 0 plays the first move generated.
+
+inline Move get_test_move(Game const& game, std::size_t stride = 7, std::size_t seed = 0) {
+    MoveList moves;
+    generate_moves(game, moves);
+    return moves[(seed + game.get_ply() * stride) % moves.size()];
+}
+
+// Plays until the ply, or to the end of the game
+inline void play_test_moves(Game& game, std::size_t ply = Game::max_ply_count, std::size_t stride = 7, std::size_t seed = 0) {
+    while (game.get_ply() < ply && !game.is_over()) {
+        game.apply(get_test_move(game, stride, seed));
+    }
+}
+
+inline Game make_test_game(std::size_t ply = Game::max_ply_count, std::size_t stride = 7, std::size_t seed = 0) {
+    auto game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+    play_test_moves(game, ply, stride, seed);
+    return game;
+}
+
+inline GameRecord make_test_record(std::size_t ply = Game::max_ply_count, std::size_t stride = 7, std::size_t seed = 0) {
+    return GameRecord::from_game(make_test_game(ply, stride, seed));
+}
+
+}
@@ -0,0 +1,96 @@
+#include "UnitTesting/UnitTest.h"
+
+#include "Blokus/Tiling.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite tiling_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+
+    auto const get_rectangle = [](int width, int height) {
+        Bitboard result;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                result.set(to_square({ x, y }));
+            }
+        }
+        return result;
+    };
+
+    "Pentominoes"_test = [&get_rectangle] {
+
+        given("Given a 20x3 rectangle to fill with all twelve pentominoes") = [&get_rectangle] {
+            TilingProblem problem;
+            problem.region = get_rectangle(20, 3);
+            for (std::size_t piece = 0; piece < piece_count; ++piece) {
+                if (get_piece_size(static_cast<PieceId>(piece)) == 5) {
+                    problem.pieces.insert(static_cast<PieceId>(piece));
+                }
+            }
+            problem.all_pieces = true;
+
+            when("When solving it on several threads") = [&problem] {
+                ThreadPool pool(2);
+                std::vector<std::vector<Move>> tilings;
+                auto const result = solve_tiling(problem, pool, [&tilings](std::span<Move const> moves) {
+                    tilings.emplace_back(moves.begin(), moves.end());
+                    return true;
+                });
+
+                then("Then there are the two known tilings, in their four symmetries") = [&] {
+                    expect(that % result.solutions == 8u);
+                    expect(that % tilings.size() == 8u);
+                    auto all_cover = true;
+                    for (auto const& moves : tilings) {
+                        Bitboard covered;
+                        for (auto const move : moves) {
+                            all_cover = all_cover && (covered & get_footprint(move)).none();
+                            covered |= get_footprint(move);
+                        }
+                        all_cover = all_cover && moves.size() == 12 && covered == problem.region;
+                    }
+                    expect(that % all_cover == true);
+                };
+            };
+        };
+    };
+
+    "Subsets"_test = [&get_rectangle] {
+
+        given("Given a 2x2 square to fill with any of the pieces") = [&get_rectangle] {
+            TilingProblem problem;
+            problem.region = get_rectangle(2, 2);
+            problem.pieces = PieceSet::all();
+
+            when("When counting the tilings") = [&problem] {
+                ThreadPool pool(2);
+                auto const result = solve_tiling(problem, pool);
+
+                then("Then there is the square tetromino and the corner tromino with the monomino") = [&result] {
+                    // There is a single domino and a single monomino, the tromino has 4 orientations
+                    expect(that % result.solutions == 5u);
+                };
+            };
+
+            when("When stopping at the first tiling") = [&problem] {
+                ThreadPool pool(2);
+                auto calls = 0;
+                auto const result = solve_tiling(problem, pool, [&calls](std::span<Move const>) {
+                    ++calls;
+                    return false;
+                });
+
+                then("Then the search stops") = [&] {
+                    expect(that % calls == 1);
+                    expect(that % result.stopped == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
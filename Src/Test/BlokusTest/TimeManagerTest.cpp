@@ -0,0 +1,91 @@
+#include "UnitTesting/UnitTest.h"
+
+#include <chrono>
+
+#include "Blokus/Mcts.h"
+#include "Blokus/MoveGeneration.h"
+#include "Blokus/TimeManager.h"
+
+// ----------------------------------------------------------------------------
+
+const boost::ut::suite time_manager_suite = [] {
+
+    using namespace boost::ut;
+    using namespace boost::ut::bdd;
+    using namespace blokus;
+    using namespace std::chrono_literals;
+
+    "TimeManager"_test = [] {
+
+        given("Given a time manager and a new game") = [] {
+            TimeManager const time_manager;
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+            TimeControl const time_control{ .remaining = 60s };
+
+            when("When allotting time to a forced move") = [&] {
+                auto const result = time_manager.allot(game, time_control, 1).count();
+
+                then("Then no time is spent") = [&result] {
+                    expect(that % result == 0);
+                };
+            };
+
+            when("When allotting time to a simple and a complex position") = [&] {
+                auto const simple = time_manager.allot(game, time_control, 50).count();
+                auto const complex = time_manager.allot(game, time_control, 800).count();
+
+                then("Then the complex position gets more time, within the remaining clock") = [&] {
+                    expect(that % complex > simple);
+                    expect(that % complex < 60000);
+                };
+            };
+
+            when("When the clock is almost out") = [&] {
+                auto const result = time_manager.allot(game, { .remaining = 10ms }, 58).count();
+
+                then("Then the move overhead is kept aside") = [&result] {
+                    expect(that % result == 0);
+                };
+            };
+        };
+
+        given("Given a time manager") = [] {
+            TimeManager time_manager;
+
+            when("When recording a move within budget and an overrun") = [&time_manager] {
+                time_manager.record(100ms, 90ms);
+                time_manager.record(100ms, 103ms);
+                auto const result = time_manager.get_statistics();
+
+                then("Then only the overrun is counted") = [&result] {
+                    expect(that % result.move_count == 2u);
+                    expect(that % result.overrun_count == 1u);
+                    expect(that % result.max_overrun.count() == 3000);
+                    expect(that % result.p99_overrun.count() >= 3000);
+                };
+            };
+        };
+    };
+
+    "Deadline"_test = [] {
+
+        given("Given an expired deadline") = [] {
+            auto const deadline = Deadline::after(0ms);
+            auto const game = Game::CreateNew({ PlayerId::Red, PlayerId::Green, PlayerId::Blue, PlayerId::Yellow });
+
+            when("When searching") = [&] {
+                Mcts mcts({ .iterations = 1000000 });
+                auto const result = mcts.search(game, deadline);
+
+                then("Then the search stops right away with a legal move") = [&] {
+                    expect(that % result.deadline_reached == true);
+                    expect(that % result.iterations == 0u);
+                    expect(that % is_legal(game, result.best_move) == true);
+                };
+            };
+        };
+    };
+
+};
+
+// ----------------------------------------------------------------------------
@@ -14,8 +14,22 @@
 #include "magic_enum.hpp"
 #include "range/v3/all.hpp"
 
+#include "Blokus/Corner.h"
+#include "Blokus/Game.h"
+#include "Blokus/OrientedPiece.h"
+#include "Blokus/PlayerId.h"
+#include "Blokus/Position.h"
+
 #include <windows.h>
 
+using blokus::Corner;
+using blokus::CornerId;
+using blokus::Game;
+using blokus::OrientedPiece;
+using blokus::PlayerId;
+using blokus::Position;
+using blokus::PositionDelta;
+
 
 //Blokus Game Board(400 squares)
 //84 game pieces(four 21 - piece sets of red, green, blue, and yellow)
@@ -267,23 +281,6 @@
 //    return output;
 //}
 
-class Position {
-public:
-    constexpr Position(int x, int y)
-        : x(x)
-        , y(y)
-    {}
-
-    constexpr int get_x() const { return x; }
-    constexpr int get_y() const { return y; }
-
-private:
-    int x;
-    int y;
-
-    friend auto operator<=>(Position const&, Position const&) = default;
-};
-
 //namespace fmt {
 //
 //template <>
@@ -324,31 +321,6 @@ private:
 //    return output;
 //}
 
-class PositionDelta {
-public:
-    constexpr PositionDelta(int x, int y)
-        : x(x)
-        , y(y)
-    {}
-
-    constexpr int get_x() const { return x; }
-    constexpr int get_y() const { return y; }
-
-private:
-    int x;
-    int y;
-
-    friend auto operator<=>(PositionDelta const&, PositionDelta const&) = default;
-};
-
-constexpr Position operator+(Position const& position, PositionDelta const& delta) {
-    return { position.get_x() + delta.get_x(), position.get_y() + delta.get_y() };
-}
-
-constexpr Position operator-(Position const& position, PositionDelta const& delta) {
-    return { position.get_x() - delta.get_x(), position.get_y() - delta.get_y() };
-}
-
 //namespace fmt {
 //
 //template <>
@@ -389,8 +361,6 @@ constexpr Position operator-(Position const& position, PositionDelta const& delt
 //    return output;
 //}
 
-enum class CornerId { NW, NE, SE, SW };
-
 //namespace fmt {
 //
 //template <>
@@ -431,23 +401,6 @@ enum class CornerId { NW, NE, SE, SW };
 //    return output;
 //}
 
-class Corner {
-public:
-    constexpr Corner( Position position, CornerId cornerId)
-        : position(std::move(position))
-        , corner_id(cornerId)
-    {}
-
-    constexpr Position const& get_position() const { return position; }
-    constexpr CornerId get_corner_id() const { return corner_id; }
-
-private:
-    Position position;
-    CornerId corner_id;
-
-    friend auto operator<=>(Corner const&, Corner const&) = default;
-};
-
 //namespace fmt {
 //
 //template <>
@@ -488,20 +441,6 @@ private:
 //    return output;
 //}
 
-class OrientedPiece {
-public:
-    constexpr OrientedPiece(std::vector<Position> squares)
-        : squares(std::move(squares))
-    {}
-
-    constexpr std::vector<Position> const& get_squares() const { return squares; }
-
-private:
-    std::vector<Position> squares;
-
-    friend auto operator<=>(OrientedPiece const&, OrientedPiece const&) = default;
-};
-
 //namespace fmt {
 //
 //template <>
@@ -543,55 +482,6 @@ private:
 //}
 
 
-class Piece {
-public:
-
-private:
-    friend auto operator<=>(Piece const&, Piece const&) = default;
-};
-
-//namespace fmt {
-//
-//template <>
-//class formatter<Piece> {
-//    // format specification storage
-//    //char presentation_ = 'f';
-//public:
-//    // parse format specification and store it:
-//    constexpr auto parse(format_parse_context& ctx) {
-//        auto i = ctx.begin()/*, end = ctx.end()*/;
-//    //    if (i != end && (*i == 'f' || *i == 'e')) {
-//    //        presentation_ = *i++;
-//    //    }
-//    //    if (i != end && *i != '}') {
-//    //        throw format_error("invalid format");
-//    //    }
-//        return i;
-//    }
-//
-//    // format a value using stored specification:
-//    template <typename FmtContext>
-//    constexpr auto format(Piece const& /*p*/, FmtContext& ctx) const {
-//        //// note: we can't use ternary operator '?:' in a constexpr
-//        //switch (presentation_) {
-//        //default:
-//        //    // 'ctx.out()' is an output iterator
-//        //case 'f': return format_to(ctx.out(), "({:f}, {:f})", p.x, p.y);
-//        //case 'e': return format_to(ctx.out(), "({:e}, {:e})", p.x, p.y);
-//        //}
-//        return format_to(ctx.out(), "{{}}");
-//    }
-//};
-//
-//}
-
-//std::ostream& operator<<(std::ostream& output, Piece const& value) {
-//    output << fmt::format("{}", value);
-//    return output;
-//}
-
-enum class PlayerId { Red, Green, Blue, Yellow };
-
 //namespace fmt {
 //
 //template <>
@@ -632,31 +522,6 @@ enum class PlayerId { Red, Green, Blue, Yellow };
 //    return output;
 //}
 
-class Game {
-public:
-    constexpr static Game CreateNew( std::vector<PlayerId> players ) {
-        return { std::move(players) };
-    }
-
-    constexpr std::vector<Piece> get_pieces_on_board() const {
-        return {};
-    }
-
-    constexpr PlayerId get_current_player() const {
-        return players[current_player];
-    }
-
-private:
-    constexpr Game(std::vector<PlayerId> players) : players(std::move(players)) {
-        assert(!this->players.empty());
-    }
-
-    std::vector<PlayerId> players;
-    size_t current_player{ 0 };
-
-    friend auto operator<=>(Game const&, Game const&) = default;
-};
-
 //namespace fmt {
 //
 //template <>